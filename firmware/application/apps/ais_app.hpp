@@ -48,6 +48,7 @@ using namespace lpc43xx;
 
 #include <iterator>
 
+#include "database.hpp"
 #include "recent_entries.hpp"
 
 struct AISPosition {
@@ -176,6 +177,8 @@ class AISAppView : public View {
 
     NavigationView& nav_;
 
+    // Keeps the lookup indexes loaded while the app runs.
+    database db{};
     AISRecentEntries recent{};
     std::unique_ptr<AISLogger> logger{};
 
@@ -220,6 +220,8 @@ class BLERxView : public View {
     void on_save_file(const std::string value);
     bool saveFile(const std::filesystem::path& path);
     std::unique_ptr<UsbSerialThread> usb_serial_thread{};
+    // Keeps the lookup indexes loaded while the app runs.
+    database db{};
     void on_data(BlePacketData* packetData);
     void log_ble_packet(BlePacketData* packet);
     void on_filter_change(std::string value);
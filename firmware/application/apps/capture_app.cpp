@@ -46,6 +46,10 @@ CaptureAppView::CaptureAppView(NavigationView& nav)
         &option_format,
         &check_trim,
         &record_view,
+        &option_trigger,
+        &field_trigger_level,
+        &field_pre_trigger,
+        &field_post_trigger,
         &waterfall,
     });
 
@@ -55,12 +59,39 @@ CaptureAppView::CaptureAppView(NavigationView& nav)
         this->field_frequency.set_step(v);
     };
 
-    option_format.set_selected_index(file_format);
+    option_format.set_by_value(file_format);
     option_format.on_change = [this](size_t, uint32_t file_type) {
         file_format = file_type;
         record_view.set_file_type((RecordView::FileType)file_type);
+        update_pre_trigger_range();
     };
 
+    record_view.set_preallocate_seconds(preallocate_seconds);
+
+    field_trigger_level.set_value(trigger_level);
+    field_trigger_level.on_change = [this](int32_t v) {
+        trigger_level = v;
+        update_trigger();
+    };
+
+    field_pre_trigger.set_value(pre_trigger_ms);
+    field_pre_trigger.on_change = [this](int32_t v) {
+        pre_trigger_ms = v;
+        update_trigger();
+    };
+
+    field_post_trigger.set_value(post_trigger_ms);
+    field_post_trigger.on_change = [this](int32_t v) {
+        post_trigger_ms = v;
+        update_trigger();
+    };
+
+    option_trigger.on_change = [this](size_t, int32_t v) {
+        set_trigger_source(static_cast<TriggerSource>(v));
+    };
+    set_trigger_source(static_cast<TriggerSource>(trigger_source));
+    option_trigger.set_by_value(trigger_source);
+
     check_trim.set_value(trim);
     check_trim.on_select = [this](Checkbox&, bool v) {
         trim = v;
@@ -97,6 +128,7 @@ CaptureAppView::CaptureAppView(NavigationView& nav)
             option_format.set_selected_index(0);  // Default C16 format for REC , 12k5 ... 1250K
         }
         capture_rate = new_capture_rate;
+        update_pre_trigger_range();
 
         waterfall.start();
     };
@@ -137,4 +169,55 @@ void CaptureAppView::on_freqchg(int64_t freq) {
     field_frequency.set_value(freq);
 }
 
+void CaptureAppView::set_trigger_source(TriggerSource source) {
+    trigger_source = static_cast<int32_t>(source);
+
+    // dBFS for the stream power, percent of the meter for RSSI.
+    if (source == TriggerSource::RSSI) {
+        field_trigger_level.set_range(0, 100);
+        if (trigger_level <= 0)
+            field_trigger_level.set_value(50, false);
+    } else {
+        field_trigger_level.set_range(-90, 0);
+        if (trigger_level > 0)
+            field_trigger_level.set_value(-40, false);
+    }
+    trigger_level = field_trigger_level.value();
+
+    update_trigger();
+}
+
+void CaptureAppView::update_trigger() {
+    const auto source = static_cast<TriggerSource>(trigger_source);
+    // With the trigger off, signals above -40dBFS are still annotated.
+    record_view.set_trigger(
+        (source == TriggerSource::Off)     ? CaptureTrigger::Source::None
+        : (source == TriggerSource::Power) ? CaptureTrigger::Source::Squelch
+                                           : CaptureTrigger::Source::External,
+        (source == TriggerSource::Power) ? trigger_level : -40,
+        pre_trigger_ms, post_trigger_ms);
+}
+
+void CaptureAppView::update_pre_trigger_range() {
+    // Shows the clamp RecordView applies anyway, at high rates it is a few ms.
+    const auto max_ms = record_view.pre_trigger_max_ms();
+    if (max_ms == 0)
+        return;  // No rate set yet.
+
+    field_pre_trigger.set_range(0, std::min<uint32_t>(999, max_ms));
+    if (pre_trigger_ms != static_cast<uint32_t>(field_pre_trigger.value())) {
+        pre_trigger_ms = field_pre_trigger.value();
+        update_trigger();
+    }
+}
+
+void CaptureAppView::update_rssi_trigger() {
+    if (static_cast<TriggerSource>(trigger_source) != TriggerSource::RSSI)
+        return;
+
+    // Raw RSSI that fills the meter, as drawn by the RSSI widget.
+    constexpr int rssi_full_scale = 256 * 2.2 / 3.3;
+    record_view.set_external_trigger(rssi.get_max() * 100 / rssi_full_scale >= trigger_level);
+}
+
 } /* namespace ui */
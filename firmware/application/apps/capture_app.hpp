@@ -47,11 +47,22 @@ class CaptureAppView : public View {
     std::string title() const override { return "Capture"; };
 
    private:
-    static constexpr ui::Dim header_height = 3 * 16;
+    static constexpr ui::Dim header_height = 4 * 16;
+
+    enum class TriggerSource : int32_t {
+        Off,
+        Power,  // Squelch on the stream power in the baseband, level in dBFS.
+        RSSI,   // External trigger from the RSSI meter, level in percent of it.
+    };
 
     uint32_t capture_rate{500000};
     uint32_t file_format{0};
     bool trim{false};
+    uint32_t preallocate_seconds{60};
+    int32_t trigger_source{0};
+    int32_t trigger_level{-40};
+    uint32_t pre_trigger_ms{20};
+    uint32_t post_trigger_ms{500};
 
     NavigationView& nav_;
     RxRadioState radio_state_{ReceiverModel::Mode::Capture};
@@ -62,11 +73,19 @@ class CaptureAppView : public View {
             {"capture_rate"sv, &capture_rate},
             {"file_format"sv, &file_format},
             {"trim"sv, &trim},
+            {"prealloc_seconds"sv, &preallocate_seconds},
+            {"trigger_source"sv, &trigger_source},
+            {"trigger_level"sv, &trigger_level},
+            {"pre_trigger_ms"sv, &pre_trigger_ms},
+            {"post_trigger_ms"sv, &post_trigger_ms},
         }};
 
     Labels labels{
         {{UI_POS_X(0), 1 * 16}, "Rate:", Theme::getInstance()->fg_light->foreground},
         {{11 * 8, 1 * 16}, "Format:", Theme::getInstance()->fg_light->foreground},
+        {{UI_POS_X(0), 3 * 16}, "Trig:", Theme::getInstance()->fg_light->foreground},
+        {{14 * 8, 3 * 16}, "Pre", Theme::getInstance()->fg_light->foreground},
+        {{21 * 8, 3 * 16}, "Post", Theme::getInstance()->fg_light->foreground},
     };
 
     RSSI rssi{
@@ -100,7 +119,8 @@ class CaptureAppView : public View {
         {18 * 8, 1 * 16},
         3,
         {{"C16", RecordView::FileType::RawS16},
-         {"C8", RecordView::FileType::RawS8}}};
+         {"C8", RecordView::FileType::RawS8},
+         {"CIQ", RecordView::FileType::CompressedS16}}};
 
     Checkbox check_trim{
         {23 * 8, 1 * 16},
@@ -116,8 +136,43 @@ class CaptureAppView : public View {
         16384,
         3};
 
+    // Off records continuously.
+    OptionsField option_trigger{
+        {5 * 8, 3 * 16},
+        4,
+        {{"Off", static_cast<int32_t>(TriggerSource::Off)},
+         {"Pwr", static_cast<int32_t>(TriggerSource::Power)},
+         {"RSSI", static_cast<int32_t>(TriggerSource::RSSI)}}};
+
+    NumberField field_trigger_level{
+        {10 * 8, 3 * 16},
+        3,
+        {-90, 0},
+        5,
+        ' '};
+
+    // Clamped to what the baseband buffers hold at the current rate, in ms.
+    NumberField field_pre_trigger{
+        {17 * 8, 3 * 16},
+        3,
+        {0, 999},
+        5,
+        ' '};
+
+    NumberField field_post_trigger{
+        {25 * 8, 3 * 16},
+        4,
+        {0, 9900},
+        100,
+        ' '};
+
     spectrum::WaterfallView waterfall{};
 
+    // Polls the RSSI meter for the RSSI trigger, the stats come at 10Hz.
+    FrameSyncRegistration rssi_trigger{
+        20,
+        [this]() { update_rssi_trigger(); }};
+
     MessageHandlerRegistration message_handler_freqchg{
         Message::ID::FreqChangeCommand,
         [this](Message* const p) {
@@ -126,6 +181,10 @@ class CaptureAppView : public View {
         }};
 
     void on_freqchg(int64_t freq);
+    void set_trigger_source(TriggerSource source);
+    void update_trigger();
+    void update_pre_trigger_range();
+    void update_rssi_trigger();
 };
 
 } /* namespace ui */
@@ -687,11 +687,12 @@ AircraftRecentEntry& ADSBRxView::find_or_create_entry(uint32_t ICAO_address) {
     if (it != recent.end())
         return *it;
 
-    // ... or Create.
+    // ... or Create, replacing the oldest entry when full.
     return recent.emplace_front(ICAO_address);
 }
 
 void ADSBRxView::sort_entries_by_state() {
+    // Few entries change state per tick, so this is close to a single pass.
     recent.sort([](const auto& left, const auto& right) {
         return (left.state < right.state);
     });
@@ -699,19 +700,8 @@ void ADSBRxView::sort_entries_by_state() {
 
 void ADSBRxView::remove_expired_entries() {
     // NB: Assumes entried are sorted with oldest last.
-    auto it = recent.rbegin();
-    auto end = recent.rend();
-
-    // Find the first !expired entry from the back.
-    while (it != end) {
-        if (it->state != ADSBAgeState::Expired)
-            break;
-
-        std::advance(it, 1);
-    }
-
-    // Remove the range of expired items.
-    recent.erase(it.base(), recent.end());
+    while (!recent.empty() && recent.back().state == ADSBAgeState::Expired)
+        recent.pop_back();
 }
 
 } /* namespace ui */
@@ -168,8 +168,8 @@ struct AircraftRecentEntry {
     }
 };
 
-// NB: uses std::list underneath so assuming refs are NOT invalidated.
-using AircraftRecentEntries = RecentEntries<AircraftRecentEntry>;
+// NB: refs stay valid until the entry is evicted or expires.
+using AircraftRecentEntries = IndexedRecentEntries<AircraftRecentEntry>;
 
 /* Holds data for logging. */
 struct ADSBLogEntry {
@@ -387,6 +387,8 @@ class ADSBRxView : public View {
     app_settings::SettingsManager settings_{
         "rx_adsb", app_settings::Mode::RX};
 
+    // Keeps the lookup indexes loaded while the app runs.
+    database db{};
     std::unique_ptr<ADSBLogger> logger{};
 
     /* Event Handlers */
@@ -44,6 +44,7 @@ static const fs::path txt_ext{u".TXT"};
 static const fs::path ppl_ext{u".PPL"};
 static const fs::path c8_ext{u".C8"};
 static const fs::path c16_ext{u".C16"};
+static const fs::path ciq_ext{u".CIQ"};
 static const fs::path cxx_ext{u".C*"};
 static const fs::path png_ext{u".PNG"};
 static const fs::path bmp_ext{u".BMP"};
@@ -90,6 +91,8 @@ fs::path get_partner_file(fs::path path) {
         path.replace_extension(c8_ext);
         if (!fs::file_exists(path))
             path.replace_extension(c16_ext);
+        if (!fs::file_exists(path))
+            path.replace_extension(ciq_ext);
     } else
         return {};
 
@@ -847,7 +850,7 @@ FileManagerView::FileManagerView(
 
     button_open_iq_trim.on_select = [this]() {
         auto path = get_selected_full_path();
-        if (selected_is_valid() && !get_selected_entry().is_directory && is_cxx_capture_file(path)) {
+        if (selected_is_valid() && !get_selected_entry().is_directory && is_cxx_capture_file(path) && !is_compressed_capture_file(path)) {
             nav_.push<IQTrimView>(path);
         } else
             nav_.display_modal("IQ Trim", "Not a capture file.");
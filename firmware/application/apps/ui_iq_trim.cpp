@@ -97,8 +97,15 @@ IQTrimView::IQTrimView(NavigationView& nav, const fs::path& path)
 
 void IQTrimView::open_file(const std::filesystem::path& path) {
     path_ = std::move(path);
+    sigmf_ = sigmf::read_meta_file(sigmf::get_meta_path(path_));
     profile_capture();
-    compute_range();
+
+    // Start from the recorded signal regions when the capture has them.
+    auto range = annotation_range();
+    if (range)
+        update_range_controls(*range);
+    else
+        compute_range();
     refresh_ui();
 }
 
@@ -120,6 +127,17 @@ void IQTrimView::paint(Painter& painter) {
                 Color(amp, amp, amp));
         }
 
+        // Mark annotated signal regions along the top edge.
+        if (sigmf_ && info_->sample_count > 0) {
+            for (const auto& annotation : sigmf_->annotations) {
+                int x0 = screen_width * annotation.sample_start / info_->sample_count;
+                int x1 = screen_width * (annotation.sample_start + annotation.sample_count) / info_->sample_count;
+                painter.fill_rectangle(
+                    {pos_lines + Point{x0, 0}, {std::max(x1 - x0, 1), 2}},
+                    Color::yellow());
+            }
+        }
+
         // Draw trim range edges.
         int start_x = screen_width * field_start.value() / info_->sample_count;
         int end_x = screen_width * field_end.value() / info_->sample_count;
@@ -193,6 +211,24 @@ void IQTrimView::compute_range() {
     update_range_controls(trim_range);
 }
 
+Optional<iq::TrimRange> IQTrimView::annotation_range() const {
+    if (!info_ || !sigmf_ || sigmf_->annotations.empty())
+        return {};
+
+    uint64_t start = info_->sample_count;
+    uint64_t end = 0;
+    for (const auto& annotation : sigmf_->annotations) {
+        start = std::min(start, annotation.sample_start);
+        end = std::max(end, annotation.sample_start + annotation.sample_count);
+    }
+    end = std::min(end, info_->sample_count);
+
+    if (start >= end)
+        return {};
+
+    return iq::TrimRange{start, end, info_->sample_size};
+}
+
 bool IQTrimView::trim_capture() {
     if (!info_) {
         nav_.display_modal("Error", "Open a file first.");
@@ -216,6 +252,10 @@ bool IQTrimView::trim_capture() {
 
     if (!trimmed)
         nav_.display_modal("Error", "Trimming failed.");
+    else if (sigmf_) {
+        sigmf::trim_annotations(*sigmf_, trim_range.start_sample, trim_range.end_sample);
+        sigmf::write_meta_file(sigmf::get_meta_path(path_), *sigmf_);
+    }
 
     return trimmed;
 }
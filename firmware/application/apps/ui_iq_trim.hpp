@@ -26,6 +26,7 @@
 #include "file.hpp"
 #include "iq_trim.hpp"
 #include "optional.hpp"
+#include "sigmf_file.hpp"
 #include "ui.hpp"
 #include "ui_navigation.hpp"
 #include "ui_widget.hpp"
@@ -89,6 +90,9 @@ class IQTrimView : public View {
     /* Determine the start and end buckets based on the cutoff. */
     void compute_range();
 
+    /* Range spanning the recorded annotations, if there are any. */
+    Optional<iq::TrimRange> annotation_range() const;
+
     /* Trims the capture file based on the settings. */
     bool trim_capture();
 
@@ -96,6 +100,7 @@ class IQTrimView : public View {
 
     std::filesystem::path path_{};
     Optional<iq::CaptureInfo> info_{};
+    Optional<sigmf::Metadata> sigmf_{};
     std::vector<iq::PowerBuckets::Bucket> power_buckets_{};
     TrimProgressUI progress_ui{};
 
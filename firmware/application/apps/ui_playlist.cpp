@@ -30,6 +30,7 @@
 #include "file_reader.hpp"
 #include "io_file.hpp"
 #include "io_convert.hpp"
+#include "iq_codec.hpp"
 #include "oversample.hpp"
 #include "portapack.hpp"
 #include "portapack_persistent_memory.hpp"
@@ -95,10 +96,18 @@ Optional<PlaylistView::playlist_entry> PlaylistView::load_entry(fs::path&& path)
     if (!metadata)
         metadata = {transmitter_model.target_frequency(), 500'000};
 
+    // Compressed captures are sized in decoded C16 bytes.
+    auto file_size = capture_file.size();
+    if (is_compressed_capture_file(path)) {
+        iq_codec::FileHeader header{};
+        auto read_result = capture_file.read(&header, sizeof(header));
+        file_size = (read_result.is_ok() && iq_codec::is_valid(header)) ? header.sample_count * sizeof(complex16_t) : 0;
+    }
+
     return playlist_entry{
         std::move(path),
         *metadata,
-        capture_file.size(),
+        file_size,
         0u};
 }
 
@@ -280,6 +289,8 @@ void PlaylistView::send_current_track() {
 
     // Reset the transmit progress bar.
     progressbar_transmit.set_value(0);
+    underrun_percent_ = 0;
+    text_underrun.set("");
 
     // Use the ReplayThread class to send the data.
     replay_thread_ = std::make_unique<ReplayThread>(
@@ -327,7 +338,7 @@ void PlaylistView::update_ui() {
         text_filename.set(current()->path.filename().string());
         text_sample_rate.set(unit_auto_scale(current()->metadata.sample_rate, 3, (current()->metadata.sample_rate > 1000000) ? 2 : 0) + "Hz");
 
-        uint8_t sample_size = capture_file_sample_size(current()->path);
+        uint8_t sample_size = is_compressed_capture_file(current()->path) ? sizeof(complex16_t) : capture_file_sample_size(current()->path);
         auto duration = ms_duration(current()->file_size, current()->metadata.sample_rate, sample_size);
         text_duration.set(to_string_time_ms(duration));
         field_frequency.set_value(current()->metadata.center_frequency);
@@ -347,6 +358,14 @@ void PlaylistView::update_ui() {
 
 void PlaylistView::on_tx_progress(uint32_t progress) {
     progressbar_transmit.set_value(progress);
+
+    if (replay_thread_) {
+        const auto underrun_percent = std::min<size_t>(99U, replay_thread_->state().underrun_percent());
+        if (underrun_percent != underrun_percent_) {
+            underrun_percent_ = underrun_percent;
+            text_underrun.set(to_string_dec_uint(underrun_percent, 2, ' ') + "%");
+        }
+    }
 }
 
 void PlaylistView::handle_replay_thread_done(uint32_t return_code) {
@@ -372,6 +391,7 @@ PlaylistView::PlaylistView(
         &text_filename,
         &text_sample_rate,
         &text_duration,
+        &text_underrun,
         &progressbar_track,
         &progressbar_transmit,
         &field_frequency,
@@ -73,6 +73,7 @@ class PlaylistView : public View {
     bool ready_signal_{};  // Used to signal the ReplayThread.
 
     size_t current_index_{0};
+    size_t underrun_percent_{0};
     bool playlist_dirty_{};
     std::vector<playlist_entry> playlist_db_{};
     std::filesystem::path playlist_path_{};
@@ -126,6 +127,10 @@ class PlaylistView : public View {
     Text text_duration{
         {UI_POS_X(0), 2 * 16, 5 * 8, 16}};
 
+    // Share of samples the baseband had to skip, blank while there are none.
+    Text text_underrun{
+        {6 * 8, 2 * 16, 4 * 8, 16}};
+
     // TODO: delay duration field.
 
     TransmitterView2 tx_view{
@@ -107,7 +107,25 @@ void ReconView::set_loop_config(bool v) {
     persistent_memory::set_recon_continuous(continuous);
 }
 
+// Arms a capture on the first match, so the recording includes the
+// pre-trigger samples from before the lock instead of starting after it.
+void ReconView::recon_arm_recording() {
+    if (auto_record_locked && !is_recording && !is_armed) {
+        record_view->start();
+        is_armed = record_view->is_active();
+    }
+}
+
+// The match did not lock, drop the armed capture (RecordView deletes the empty file).
+void ReconView::recon_disarm_recording() {
+    if (is_armed) {
+        record_view->stop();
+        is_armed = false;
+    }
+}
+
 void ReconView::recon_stop_recording(bool exiting) {
+    recon_disarm_recording();
     if (is_recording) {
         record_view->stop();
         is_recording = false;
@@ -246,16 +264,22 @@ void ReconView::recon_redraw() {
         last_rssi_min = rssi.get_min();
         last_rssi_med = rssi.get_avg();
         last_rssi_max = rssi.get_max();
-        freq_stats.set("RSSI: " + to_string_dec_int(rssi.get_min()) + "/" + to_string_dec_int(rssi.get_avg()) + "/" + to_string_dec_int(rssi.get_max()) + " db");
+        StaticString<28> stats{"RSSI: "};
+        stats.append_dec_int(rssi.get_min()).append("/").append_dec_int(rssi.get_avg()).append("/").append_dec_int(rssi.get_max()).append(" db");
+        freq_stats.set(stats);
     }
     if (last_entry.frequency_a != freq) {
         last_entry.frequency_a = freq;
-        big_display.set("FREQ:" + to_string_short_freq(freq) + " MHz");
+        StaticString<20> freq_text{"FREQ:"};
+        freq_text.append_short_freq(freq).append(" MHz");
+        big_display.set(freq_text);
     }
     if (last_nb_match != recon_lock_nb_match || last_freq_lock != freq_lock) {
         last_freq_lock = freq_lock;
         last_nb_match = recon_lock_nb_match;
-        text_nb_locks.set(to_string_dec_uint(freq_lock) + "/" + to_string_dec_uint(recon_lock_nb_match));
+        StaticString<12> locks{};
+        locks.append_dec_uint(freq_lock).append("/").append_dec_uint(recon_lock_nb_match);
+        text_nb_locks.set(locks);
         if (freq_lock == 0) {
             // NO FREQ LOCK, ONGOING STANDARD SCANNING
             big_display.set_style(Theme::getInstance()->bg_darkest);
@@ -275,7 +299,9 @@ void ReconView::recon_redraw() {
     if (last_db != db || last_list_size != frequency_list.size()) {
         last_list_size = frequency_list.size();
         last_db = db;
-        text_max.set("/" + to_string_dec_uint(frequency_list.size()) + " " + to_string_dec_int(db) + " db");
+        StaticString<20> max_text{"/"};
+        max_text.append_dec_uint(frequency_list.size()).append(" ").append_dec_int(db).append(" db");
+        text_max.set(max_text);
     }
 }
 
@@ -340,6 +366,7 @@ ReconView::ReconView(NavigationView& nav)
                                                RecordView::FileType::WAV, 4096, 4);
     record_view->set_filename_date_frequency(true);
     record_view->set_auto_trim(false);
+    record_view->set_trigger(CaptureTrigger::Source::External, -40, recon_pre_trigger_ms, 0);
     record_view->hidden(true);
     record_view->on_error = [&nav](std::string message) {
         nav.display_modal("Error", message);
@@ -842,6 +869,8 @@ void ReconView::on_statistics_update(const ChannelStatistics& statistics) {
         freqlist_cleared_for_ui_action = false;
     }
     db = statistics.max_db;
+    if (is_armed && freq_lock == 0)
+        recon_disarm_recording();
     if (recon) {
         if (!timer) {
             status = 0;
@@ -861,6 +890,8 @@ void ReconView::on_statistics_update(const ChannelStatistics& statistics) {
             if (db > squelch)  // MATCHING LEVEL
             {
                 freq_lock++;
+                if (freq_lock == 1 && wait != 0)
+                    recon_arm_recording();
                 timer += time_interval;  // give some more time for next lock
             } else {
                 // continuous, direct cut it if not consecutive match after 1 first match
@@ -888,7 +919,11 @@ void ReconView::on_statistics_update(const ChannelStatistics& statistics) {
                             button_audio_app.set_text("RAW REC");
                         } else
                             button_audio_app.set_text("WAV REC");
-                        record_view->start();
+                        if (!is_armed)
+                            record_view->start();
+                        // Keeps what was held since the first match and records on.
+                        record_view->set_external_trigger(true);
+                        is_armed = false;
                         button_config.set_style(Theme::getInstance()->fg_light);  // disable config while recording as it's causing an IO error pop up at exit
                         is_recording = true;
                     }
@@ -911,7 +946,9 @@ void ReconView::on_statistics_update(const ChannelStatistics& statistics) {
     }
     if (last_timer != timer) {
         last_timer = timer;
-        text_timer.set("TIMER: " + to_string_dec_int(timer));
+        StaticString<20> timer_text{"TIMER: "};
+        timer_text.append_dec_int(timer);
+        text_timer.set(timer_text);
     }
 
     if (timer != 0) {
@@ -1181,6 +1218,7 @@ size_t ReconView::change_mode(freqman_index_t new_mod) {
         record_view->set_filename_date_frequency(true);
     }
     record_view->set_auto_trim(false);
+    record_view->set_trigger(CaptureTrigger::Source::External, -40, recon_pre_trigger_ms, 0);
     add_child(record_view.get());
     record_view->hidden(true);
     record_view->on_error = [this](std::string message) {
@@ -1334,6 +1372,7 @@ void ReconView::start_repeat() {
 
         if (record_view != nullptr) {
             record_view->stop();
+            is_armed = false;
             remove_child(record_view.get());
             record_view.reset();
         }
@@ -107,6 +107,8 @@ class ReconView : public View {
     void load_persisted_settings();
     bool recon_save_freq(const std::filesystem::path& path, size_t index, bool warn_if_exists);
     // placeholder for possible void recon_start_recording();
+    void recon_arm_recording();
+    void recon_disarm_recording();
     void recon_stop_recording(bool exiting);
 
     // Returns true if 'current_index' is in bounds of frequency_list.
@@ -146,6 +148,9 @@ class ReconView : public View {
     bool user_pause{false};
     bool auto_record_locked{false};
     bool is_recording{false};
+    bool is_armed{false};
+    // As much as the baseband buffers hold, RecordView clamps it.
+    static constexpr uint32_t recon_pre_trigger_ms = 1000;
     uint32_t recon_lock_nb_match{RECON_DEF_NB_MATCH};
     uint32_t recon_lock_duration{RECON_MIN_LOCK_DURATION};
     uint32_t recon_match_mode{RECON_MATCH_CONTINUOUS};
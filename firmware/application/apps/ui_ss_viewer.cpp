@@ -22,6 +22,13 @@
 
 #include "ui_ss_viewer.hpp"
 
+#include "deflate.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
 using namespace portapack;
 namespace fs = std::filesystem;
 
@@ -42,8 +49,72 @@ bool ScreenshotViewer::on_key(KeyEvent) {
     return true;
 }
 
+static uint32_t read_uint32_be(const uint8_t* p) {
+    return (p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+}
+
+/* PNG signature and IHDR of an 8 bit RGB, non interlaced, screen sized image. */
+static bool is_screenshot_header(const std::array<uint8_t, 33>& h) {
+    constexpr std::array<uint8_t, 16> signature_and_ihdr{{
+        0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a,
+        0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44, 0x52}};
+
+    return std::equal(signature_and_ihdr.begin(), signature_and_ihdr.end(), h.begin()) &&
+           read_uint32_be(&h[16]) == (uint32_t)screen_width &&
+           read_uint32_be(&h[20]) == (uint32_t)screen_height &&
+           h[24] == 8 &&   // Bit depth.
+           h[25] == 2 &&   // RGB.
+           h[26] == 0 &&   // Deflate.
+           h[27] == 0 &&   // Adaptive filtering.
+           h[28] == 0;     // Not interlaced.
+}
+
+static uint8_t paeth(int a, int b, int c) {
+    const int p = a + b - c;
+    const int pa = std::abs(p - a);
+    const int pb = std::abs(p - b);
+    const int pc = std::abs(p - c);
+    if (pa <= pb && pa <= pc)
+        return a;
+    return (pb <= pc) ? b : c;
+}
+
+/* Reverses the PNG filter of a scanline in place, previous is the
+ * unfiltered scanline above it. */
+static bool unfilter(uint8_t filter, uint8_t* x, const uint8_t* previous, size_t length) {
+    constexpr size_t bpp = sizeof(ColorRGB888);
+
+    for (size_t i = 0; i < length; i++) {
+        const uint8_t a = (i >= bpp) ? x[i - bpp] : 0;
+        const uint8_t b = previous[i];
+        const uint8_t c = (i >= bpp) ? previous[i - bpp] : 0;
+
+        switch (filter) {
+            case 0:
+                break;
+            case 1:
+                x[i] += a;
+                break;
+            case 2:
+                x[i] += b;
+                break;
+            case 3:
+                x[i] += (a + b) / 2;
+                break;
+            case 4:
+                x[i] += paeth(a, b, c);
+                break;
+            default:
+                return false;
+        }
+    }
+
+    return true;
+}
+
 void ScreenshotViewer::paint(Painter& painter) {
-    File file{};
+    // 'File' is 556 bytes, keep it and the decoder off the stack.
+    auto file = std::make_unique<File>();
 
     painter.fill_rectangle({0, 0, screen_width, screen_height}, Color::black());
 
@@ -51,47 +122,71 @@ void ScreenshotViewer::paint(Painter& painter) {
         painter.draw_string({10, 160}, *Theme::getInstance()->bg_darkest, "Not a valid screenshot.");
     };
 
-    auto error = file.open(path_);
+    auto error = file->open(path_);
     if (error) {
         painter.draw_string({10, 160}, *Theme::getInstance()->bg_darkest, error->what());
         return;
     }
 
-    // Screenshots from PNGWriter are all this size.
-    if ((file.size() != 232383 && screen_width == 240) || (screen_width == 320 && file.size() != 463743)) {
+    std::array<uint8_t, 33> header{};
+    auto read = file->read(header.data(), header.size());
+    if (!read || *read != header.size() || !is_screenshot_header(header)) {
         show_invalid();
         return;
     }
 
-    constexpr size_t read_chunk = 80;  // NB: must be a factor of pixel_width.
-    constexpr size_t buffer_size = sizeof(ColorRGB888) * read_chunk;
-    uint8_t buffer[buffer_size];
-    std::vector<Color> pixel_data(screen_width);
+    // Feeds the decoder the IDAT chunk payloads back to back.
+    uint32_t idat_remaining = 0;
+    bool crc_pending = false;
+    auto source = [&file, &idat_remaining, &crc_pending](uint8_t* data, size_t length) -> size_t {
+        while (idat_remaining == 0) {
+            if (crc_pending) {
+                file->seek(file->tell() + 4);
+                crc_pending = false;
+            }
+
+            std::array<uint8_t, 8> chunk{};
+            auto result = file->read(chunk.data(), chunk.size());
+            if (!result || *result != chunk.size())
+                return 0;
+
+            const auto chunk_length = read_uint32_be(&chunk[0]);
+            if (std::memcmp(&chunk[4], "IDAT", 4) == 0) {
+                idat_remaining = chunk_length;
+                crc_pending = true;
+            } else if (std::memcmp(&chunk[4], "IEND", 4) == 0) {
+                return 0;
+            } else {
+                file->seek(file->tell() + chunk_length + 4);
+            }
+        }
 
-    // Seek past all the headers.
-    file.seek(43);
+        auto result = file->read(data, std::min<size_t>(length, idat_remaining));
+        if (!result)
+            return 0;
+        idat_remaining -= *result;
+        return *result;
+    };
+    auto decoder = std::make_unique<deflate::Decoder>(source);
+
+    const size_t stride = screen_width * sizeof(ColorRGB888);
+    std::vector<uint8_t> row(1 + stride);
+    std::vector<uint8_t> previous(stride, 0);
+    std::vector<Color> pixel_data(screen_width);
 
     for (auto line = 0u; line < screen_height; ++line) {
-        // Seek past the per-line header.
-        file.seek(file.tell() + 6);
-
-        // Per comment in PNGWriter, read in chunks of 80.
-        // NB: Reading in one large chunk caused corruption so there's
-        // likely a bug lurking in the SD Card/FatFs layer.
-        for (auto offset = 0u; offset < screen_width; offset += read_chunk) {
-            auto read = file.read(buffer, buffer_size);
-
-            if (!read || *read != buffer_size) {
-                show_invalid();
-                return;
-            }
+        if (decoder->read(row.data(), row.size()) != row.size() ||
+            !unfilter(row[0], &row[1], previous.data(), stride)) {
+            show_invalid();
+            return;
+        }
 
-            auto c8 = (ColorRGB888*)buffer;
-            for (auto i = 0u; i < read_chunk; ++i) {
-                pixel_data[i + offset] = Color(c8->r, c8->g, c8->b);
-                ++c8;
-            }
+        auto c8 = reinterpret_cast<const ColorRGB888*>(&row[1]);
+        for (auto i = 0u; i < screen_width; ++i) {
+            pixel_data[i] = Color(c8->r, c8->g, c8->b);
+            ++c8;
         }
+        std::copy(row.begin() + 1, row.end(), previous.begin());
 
         display.draw_pixels({0, (int)line, screen_width, 1}, pixel_data);
     }
@@ -150,15 +150,15 @@ class TextEditorMenu : public View {
     void on_show() override;
     void on_hide() override;
 
-    std::function<void()>& on_home() { return button_home.on_select; }
-    std::function<void()>& on_end() { return button_end.on_select; }
-    std::function<void()>& on_zoom() { return button_zoom.on_select; }
-    std::function<void()>& on_delete_line() { return button_delline.on_select; }
-    std::function<void()>& on_edit_line() { return button_edit.on_select; }
-    std::function<void()>& on_add_line() { return button_addline.on_select; }
-    std::function<void()>& on_open() { return button_open.on_select; }
-    std::function<void()>& on_save() { return button_save.on_select; }
-    std::function<void()>& on_exit() { return button_exit.on_select; }
+    Delegate<void()>& on_home() { return button_home.on_select; }
+    Delegate<void()>& on_end() { return button_end.on_select; }
+    Delegate<void()>& on_zoom() { return button_zoom.on_select; }
+    Delegate<void()>& on_delete_line() { return button_delline.on_select; }
+    Delegate<void()>& on_edit_line() { return button_edit.on_select; }
+    Delegate<void()>& on_add_line() { return button_addline.on_select; }
+    Delegate<void()>& on_open() { return button_open.on_select; }
+    Delegate<void()>& on_save() { return button_save.on_select; }
+    Delegate<void()>& on_exit() { return button_exit.on_select; }
 
    private:
     void hide_children(bool hidden);
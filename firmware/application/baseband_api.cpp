@@ -346,6 +346,11 @@ void set_flex_config() {
     send_message(&message);
 }
 
+void set_channelizer_config(const int8_t squelch_db, const uint32_t deviation) {
+    const ChannelizerConfigureMessage message{squelch_db, deviation};
+    send_message(&message);
+}
+
 void set_siggen_tone(const uint32_t tone) {
     const SigGenToneMessage message{
         TONES_F2D(tone, TONES_SAMPLERATE)};
@@ -105,6 +105,7 @@ void set_subghzd_config(uint8_t modulation, uint32_t sampling_rate);
 void set_wefax_config(uint8_t lpm, uint8_t ioc);
 void set_noaaapt_config();
 void set_flex_config();
+void set_channelizer_config(const int8_t squelch_db, const uint32_t deviation);
 
 void request_roger_beep();
 void request_rssi_beep();
@@ -102,11 +102,11 @@ void bind(TextField& field, T& value, NavigationView& nav, Fn fn = Fn{}) {
         value = tf.get_text();
         fn(value);
     };
-    // text_prompt needs a mutable working buffer.
-    // Capture a new string and make the lambda mutable so it can be modified.
-    field.on_select = [&nav, buf = std::string{}](TextField& tf) mutable {
-        buf = tf.get_text();
-        text_prompt(nav, buf, /*max_length*/ 255, ENTER_KEYBOARD_MODE_ALPHA,
+    // text_prompt needs a working buffer that outlives the prompt.
+    // It's shared rather than captured by value to keep the handler small.
+    field.on_select = [&nav, buf = std::make_shared<std::string>()](TextField& tf) {
+        *buf = tf.get_text();
+        text_prompt(nav, *buf, /*max_length*/ 255, ENTER_KEYBOARD_MODE_ALPHA,
                     [&tf](std::string& str) {
                         tf.set_text(str);
                     });
@@ -41,11 +41,14 @@ CaptureThread::CaptureThread(
     size_t write_size,
     size_t buffer_count,
     std::function<void()> success_callback,
-    std::function<void(File::Error)> error_callback)
-    : config{write_size, buffer_count},
+    std::function<void(File::Error)> error_callback,
+    const CaptureTrigger& trigger,
+    std::unique_ptr<iq::PowerIndexBuilder> power_index)
+    : config{write_size, buffer_count, trigger},
       writer{std::move(writer)},
       success_callback{std::move(success_callback)},
-      error_callback{std::move(error_callback)} {
+      error_callback{std::move(error_callback)},
+      power_index{std::move(power_index)} {
     // Need significant stack for FATFS
     thread = chThdCreateFromHeap(NULL, 1024, NORMALPRIO + 10, CaptureThread::static_fn, this);
 }
@@ -77,13 +80,24 @@ Optional<File::Error> CaptureThread::run() {
 
     while (!chThdShouldTerminate()) {
         auto buffer = buffers.get();
-        auto write_result = writer->write(buffer->data(), buffer->size());
-        if (write_result.is_error()) {
-            return write_result.error();
+        if (buffer->size() > 0) {
+            auto write_result = iq::write_indexed(*writer, power_index.get(), buffer->data(), buffer->size());
+            if (write_result.is_error()) {
+                return write_result.error();
+            }
         }
         buffer->empty();
         buffers.put(buffer);
+
+        // A triggered capture ends once its post-trigger tail is written.
+        if (config.trigger.done && buffers.empty()) {
+            break;
+        }
     }
 
+    // Best effort, IQ trim falls back to reading the capture without it.
+    if (power_index)
+        power_index->write();
+
     return {};
 }
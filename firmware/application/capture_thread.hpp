@@ -27,6 +27,7 @@
 #include "event_m0.hpp"
 
 #include "io.hpp"
+#include "iq_power_index.hpp"
 #include "optional.hpp"
 
 #include <cstdint>
@@ -40,7 +41,9 @@ class CaptureThread {
         size_t write_size,
         size_t buffer_count,
         std::function<void()> success_callback,
-        std::function<void(File::Error)> error_callback);
+        std::function<void(File::Error)> error_callback,
+        const CaptureTrigger& trigger = {},
+        std::unique_ptr<iq::PowerIndexBuilder> power_index = {});
     ~CaptureThread();
 
     CaptureThread(const CaptureThread&) = delete;
@@ -52,11 +55,17 @@ class CaptureThread {
         return config;
     }
 
+    /* Drives CaptureTrigger::Source::External, polled by the baseband. */
+    void set_external_trigger(bool active) {
+        config.trigger.external = active;
+    }
+
    private:
     CaptureConfig config;
     std::unique_ptr<stream::Writer> writer;
     std::function<void()> success_callback;
     std::function<void(File::Error)> error_callback;
+    std::unique_ptr<iq::PowerIndexBuilder> power_index;
     Thread* thread{nullptr};
 
     static msg_t static_fn(void* arg);
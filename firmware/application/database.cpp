@@ -23,84 +23,167 @@
  */
 
 #include "database.hpp"
+#include "database_index.hpp"
 #include "file.hpp"
 #include "file_path.hpp"
+
+#include <algorithm>
+#include <array>
 #include <cstring>
+#include <numeric>
+
+using namespace database_index;
+
+struct database::Engine {
+    static constexpr size_t max_tables = 4;
+
+    struct OpenTable {
+        OpenTable(uint8_t id, const Table& table)
+            : id{id},
+              file_path{table.file_path},
+              record_length{table.record_length},
+              index{id, table.index_item_length, table.record_length} {}
+
+        uint8_t id;
+        std::filesystem::path file_path;
+        size_t record_length;
+        File file{};
+        TableIndex index;
+    };
+
+    BlockCache cache{};
+    std::array<std::unique_ptr<OpenTable>, max_tables> tables{};
+    size_t next_slot{0};
+
+    /* Returns the open table, opening the file and loading its index on first use. */
+    OpenTable* open(const Table& table) {
+        for (auto& t : tables) {
+            if (t && t->file_path == table.file_path)
+                return t.get();
+        }
 
-int database::retrieve_mid_record(MidDBRecord* record, std::string search_term) {
-    file_path = ais_dir / u"mids.db";
-    index_item_length = 4;
-    record_length = 32;
+        // Take a free slot, or else the slots in turn.
+        auto free_slot = std::find(tables.begin(), tables.end(), nullptr);
+        const size_t slot = (free_slot != tables.end()) ? std::distance(tables.begin(), free_slot) : next_slot++ % max_tables;
+        close(slot);
 
-    result = retrieve_record(file_path, index_item_length, record_length, record, search_term);
+        auto t = std::make_unique<OpenTable>(slot, table);
+        if (t->file.open(table.file_path).is_valid() || !t->index.load(t->file))
+            return nullptr;
 
-    return (result);
-}
+        tables[slot] = std::move(t);
+        return tables[slot].get();
+    }
 
-int database::retrieve_airline_record(AirlinesDBRecord* record, std::string search_term) {
-    file_path = adsb_dir / u"airlines.db";
-    index_item_length = 4;
-    record_length = 64;
+    void close(size_t slot) {
+        if (tables[slot]) {
+            cache.drop(slot);
+            tables[slot].reset();
+        }
+    }
+
+    /* Returns false on a read error. */
+    bool lookup(OpenTable& t, void* records, size_t record_size, const std::vector<std::string>& search_terms, std::vector<int>& results) {
+        std::vector<size_t> order(search_terms.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&search_terms](size_t a, size_t b) {
+            return search_terms[a] < search_terms[b];
+        });
+
+        const size_t* previous = nullptr;
+        for (const auto& i : order) {
+            auto record = static_cast<uint8_t*>(records) + i * record_size;
+
+            if (previous && search_terms[*previous] == search_terms[i]) {
+                results[i] = results[*previous];
+                std::memcpy(record, static_cast<uint8_t*>(records) + *previous * record_size, record_size);
+                continue;
+            }
+            previous = &i;
+
+            const auto found = t.index.find(t.file, cache, search_terms[i]);
+            if (found == TableIndex::read_error)
+                return false;
+            if (found == TableIndex::not_found) {
+                results[i] = DATABASE_RECORD_NOT_FOUND;
+                continue;
+            }
+
+            auto seek = t.file.seek(t.index.record_offset(found));
+            auto read = t.file.read(record, t.record_length);
+            if (!seek || !read || *read != t.record_length)
+                return false;
+            results[i] = DATABASE_RECORD_FOUND;
+        }
 
-    result = retrieve_record(file_path, index_item_length, record_length, record, search_term);
+        return true;
+    }
+};
 
-    return (result);
+std::weak_ptr<database::Engine> database::shared_engine{};
+
+database::database()
+    : engine{shared_engine.lock()} {
+    if (!engine) {
+        engine = std::make_shared<Engine>();
+        shared_engine = engine;
+    }
 }
 
-int database::retrieve_aircraft_record(AircraftDBRecord* record, std::string search_term) {
-    file_path = adsb_dir / u"icao24.db";
-    index_item_length = 7;
-    record_length = 146;
+database::Table database::table_for(const MidDBRecord*) {
+    return {ais_dir / u"mids.db", 4, 32};
+}
 
-    result = retrieve_record(file_path, index_item_length, record_length, record, search_term);
+database::Table database::table_for(const AirlinesDBRecord*) {
+    return {adsb_dir / u"airlines.db", 4, 64};
+}
 
-    return (result);
+database::Table database::table_for(const AircraftDBRecord*) {
+    return {adsb_dir / u"icao24.db", 7, 146};
 }
 
-int database::retrieve_macaddress_record(MacAddressDBRecord* record, std::string search_term) {
-    file_path = macaddress_dir / u"macaddress.db";
-    index_item_length = 7;
-    record_length = 64;
+database::Table database::table_for(const MacAddressDBRecord*) {
+    return {macaddress_dir / u"macaddress.db", 7, 64};
+}
+
+int database::retrieve_mid_record(MidDBRecord* record, std::string search_term) {
+    return retrieve_record(table_for(record), record, search_term);
+}
 
-    result = retrieve_record(file_path, index_item_length, record_length, record, search_term);
+int database::retrieve_airline_record(AirlinesDBRecord* record, std::string search_term) {
+    return retrieve_record(table_for(record), record, search_term);
+}
+
+int database::retrieve_aircraft_record(AircraftDBRecord* record, std::string search_term) {
+    return retrieve_record(table_for(record), record, search_term);
+}
 
-    return (result);
+int database::retrieve_macaddress_record(MacAddressDBRecord* record, std::string search_term) {
+    return retrieve_record(table_for(record), record, search_term);
 }
 
-int database::retrieve_record(std::filesystem::path file_path, int index_item_length, int record_length, void* record, std::string search_term) {
+int database::retrieve_record(const Table& table, void* record, const std::string& search_term) {
     if (search_term.empty())
         return DATABASE_RECORD_NOT_FOUND;
 
-    auto result = db_file.open(file_path);
-    if (!result.is_valid()) {
-        number_of_records = (db_file.size() / (index_item_length + record_length));  // determine number of records in file
-                                                                                     // binary search tree
-        int first = 0,                                                               // First search element
-            last = number_of_records - 1,                                            // Last search element
-            middle,                                                                  // Mid point of search
-            position = -1;                                                           // Position of search value
-
-        while (!found && first <= last) {
-            middle = (first + last) / 2;  // Calculate mid point
-            db_file.seek(middle * index_item_length);
-            db_file.read(file_buffer, search_term.length());
-            if (file_buffer == search_term) {  // If value is found at mid
-                found = true;
-                position = middle;
-            } else if (file_buffer > search_term)  // If value is in lower half
-                last = middle - 1;
-            else
-                first = middle + 1;  // If value is in upper half
-        }
+    return retrieve_records(table, record, table.record_length, {search_term})[0];
+}
 
-        if (found == true) {
-            db_file.seek((number_of_records * index_item_length) + (position * record_length));  // seek starting after index
-            db_file.read(record, record_length);
-            return (DATABASE_RECORD_FOUND);
-        } else {
-            return (DATABASE_RECORD_NOT_FOUND);
-        }
+std::vector<int> database::retrieve_records(const Table& table, void* records, size_t record_size, const std::vector<std::string>& search_terms) {
+    std::vector<int> results(search_terms.size(), DATABASE_NOT_FOUND);
+
+    // A read error may be a handle left stale by the card being remounted, reopen once.
+    for (int attempt = 0; attempt < 2; attempt++) {
+        auto t = engine->open(table);
+        if (!t)
+            break;
+
+        if (engine->lookup(*t, records, record_size, search_terms, results))
+            return results;
+
+        engine->close(t->id);
+        std::fill(results.begin(), results.end(), DATABASE_NOT_FOUND);
+    }
 
-    } else
-        return (DATABASE_NOT_FOUND);
+    return results;
 }
@@ -27,16 +27,24 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "file.hpp"
 
+/* Lookups in the sorted .db files. The open files, their sparse key indexes
+ * and a block cache are shared by all database objects alive at a time, so an
+ * app that keeps one around for its lifetime pays for loading an index once.
+ */
 class database {
    public:
 #define DATABASE_RECORD_FOUND 0       // record found in database
 #define DATABASE_NOT_FOUND -1         // database not found / could not be opened
 #define DATABASE_RECORD_NOT_FOUND -2  // record could not be found in database
 
+    database();
+
     struct MidDBRecord {
         char country[32];  // country name
     };
@@ -67,21 +75,33 @@ class database {
 
     int retrieve_macaddress_record(MacAddressDBRecord* record, std::string search_term);
 
-   private:
-    std::filesystem::path file_path = "";  // path including filename
-    int index_item_length = 0;             // length of index item
-    int record_length = 0;                 // length of record
+    /* Looks up several search terms in one pass, in key order so each index
+     * block and record is read at most once. records is resized to match
+     * search_terms; the result holds the return code for each term. */
+    template <typename Record>
+    std::vector<int> retrieve_records(std::vector<Record>& records, const std::vector<std::string>& search_terms) {
+        records.resize(search_terms.size());
+        return retrieve_records(table_for(records.data()), records.data(), sizeof(Record), search_terms);
+    }
 
-    File db_file{};
-    int number_of_records = 0;
-    int position = 0;
+   private:
+    struct Table {
+        std::filesystem::path file_path;  // path including filename
+        size_t index_item_length;         // length of index item
+        size_t record_length;             // length of record
+    };
 
-    char file_buffer[32]{0};
-    bool found = false;
+    static Table table_for(const MidDBRecord*);
+    static Table table_for(const AirlinesDBRecord*);
+    static Table table_for(const AircraftDBRecord*);
+    static Table table_for(const MacAddressDBRecord*);
 
-    int result = 0;
+    struct Engine;
+    static std::weak_ptr<Engine> shared_engine;
+    std::shared_ptr<Engine> engine;
 
-    int retrieve_record(std::filesystem::path file_path, int index_item_length, int record_length, void* record, std::string search_term);
+    std::vector<int> retrieve_records(const Table& table, void* records, size_t record_size, const std::vector<std::string>& search_terms);
+    int retrieve_record(const Table& table, void* record, const std::string& search_term);
 };
 
-#endif /*__DATABASE_H__*/
\ No newline at end of file
+#endif /*__DATABASE_H__*/
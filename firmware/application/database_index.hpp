@@ -0,0 +1,255 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __DATABASE_INDEX_H__
+#define __DATABASE_INDEX_H__
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "indexed_lru_list.hpp"
+
+/* Key lookups in the .db files (mids, airlines, icao24, macaddress).
+ *
+ * A .db file holds record_count keys of index_item_length bytes in ascending
+ * order, followed by the record_count records of record_length bytes in the
+ * same order. A TableIndex keeps the first key of every span of the on-disk
+ * index in RAM, and a lookup binary searches one span through a BlockCache
+ * of recently read 512 byte blocks.
+ *
+ * A span is a single block while the keys of all blocks fit in
+ * max_sparse_bytes, which holds macaddress.db's 513 blocks. A lookup then
+ * reads one block, or two when the span's last key straddles into the next.
+ * Larger tables get spans of several blocks, each costing a read or two.
+ */
+namespace database_index {
+
+constexpr size_t block_size = 512;
+constexpr size_t max_key_length = 8;
+constexpr size_t max_sparse_bytes = 4096;
+constexpr size_t cache_blocks = 8;
+
+/* Orders an index key against a search term. Like the original lookup, only
+ * the first term.length() bytes of the key are compared and a NUL ends it. */
+inline int compare_key(const char* key, size_t key_length, const std::string& term) {
+    const size_t n = std::min(key_length, term.length());
+    size_t length = 0;
+    while (length < n && key[length] != '\0')
+        length++;
+
+    const int c = std::memcmp(key, term.data(), length);
+    if (c != 0)
+        return c;
+    return (length < term.length()) ? -1 : 0;
+}
+
+/* LRU cache of file blocks, shared by the open tables. */
+class BlockCache {
+   public:
+    /* Table id and block number. */
+    using BlockId = std::pair<uint8_t, uint32_t>;
+
+    struct Block {
+        using Key = BlockId;
+
+        BlockId id;
+        size_t length{0};
+        std::array<uint8_t, block_size> data{};
+
+        Block(BlockId id)
+            : id{id} {}
+
+        Key key() const { return id; }
+    };
+
+    /* Returns the block, reading it on a miss, or nullptr when it can't be read. */
+    template <typename File>
+    const Block* get(File& file, uint8_t table, uint32_t number) {
+        const BlockId id{table, number};
+        auto it = blocks.find(id);
+        if (it != blocks.end()) {
+            blocks.move_to_front(it);
+            hits++;
+            return &*it;
+        }
+
+        misses++;
+        auto& block = blocks.emplace_front(id);
+        auto seek = file.seek(number * block_size);
+        auto read = file.read(block.data.data(), block_size);
+        if (!seek || !read || *read == 0) {
+            blocks.erase(blocks.begin());
+            return nullptr;
+        }
+
+        block.length = *read;
+        return &block;
+    }
+
+    /* Forgets the blocks of a table that was closed. */
+    void drop(uint8_t table) {
+        for (auto it = blocks.begin(); it != blocks.end();)
+            it = (it->id.first == table) ? blocks.erase(it) : std::next(it);
+    }
+
+    size_t hits{0};
+    size_t misses{0};
+
+   private:
+    IndexedLRUList<Block, cache_blocks> blocks{};
+};
+
+class TableIndex {
+   public:
+    static constexpr int32_t not_found = -1;
+    static constexpr int32_t read_error = -2;
+
+    TableIndex(uint8_t table, size_t index_item_length, size_t record_length)
+        : table{table},
+          index_item_length{index_item_length},
+          record_length{record_length} {}
+
+    /* Reads the first key of every span. */
+    template <typename File>
+    bool load(File& file) {
+        if (index_item_length == 0 || index_item_length > max_key_length)
+            return false;
+
+        record_count_ = file.size() / (index_item_length + record_length);
+        const size_t index_blocks = (record_count_ * index_item_length + block_size - 1) / block_size;
+        const size_t max_spans = max_sparse_bytes / index_item_length;
+        span_blocks = std::max<size_t>((index_blocks + max_spans - 1) / max_spans, 1);
+
+        sparse_keys.clear();
+        sparse_keys.reserve((index_blocks + span_blocks - 1) / span_blocks * index_item_length);
+        span_count = 0;
+        // The last block may only hold the tail of a key, starting no span.
+        for (size_t first = 0; first < record_count_; first = span_first(++span_count)) {
+            sparse_keys.resize(sparse_keys.size() + index_item_length);
+            auto seek = file.seek(first * index_item_length);
+            auto read = file.read(&sparse_keys[span_count * index_item_length], index_item_length);
+            if (!seek || !read || *read != index_item_length)
+                return false;
+        }
+
+        return true;
+    }
+
+    size_t record_count() const { return record_count_; }
+
+    uint32_t record_offset(size_t record) const {
+        return record_count_ * index_item_length + record * record_length;
+    }
+
+    /* Returns the record number of term, not_found or read_error. */
+    template <typename File>
+    int32_t find(File& file, BlockCache& cache, const std::string& term) {
+        if (term.empty() || sparse_keys.empty())
+            return not_found;
+
+        // First span starting above term, the span before it may hold it.
+        size_t above = 0;
+        for (size_t count = span_count; count > 0;) {
+            const size_t half = count / 2;
+            if (compare_key(sparse_key(above + half), index_item_length, term) > 0) {
+                count = half;
+            } else {
+                above += half + 1;
+                count -= half + 1;
+            }
+        }
+        if (above == 0)
+            return not_found;
+
+        const size_t span = above - 1;
+        if (compare_key(sparse_key(span), index_item_length, term) == 0)
+            return span_first(span);
+
+        int32_t first = span_first(span) + 1;
+        int32_t last = std::min(span_first(span + 1), record_count_) - 1;
+        while (first <= last) {
+            const int32_t middle = (first + last) / 2;
+            Key key{};
+            if (!read_key(file, cache, middle, key))
+                return read_error;
+
+            const int c = compare_key(key.data(), index_item_length, term);
+            if (c == 0)
+                return middle;
+            if (c > 0)
+                last = middle - 1;
+            else
+                first = middle + 1;
+        }
+
+        return not_found;
+    }
+
+   private:
+    using Key = std::array<char, max_key_length>;
+
+    uint8_t table;
+    size_t index_item_length;
+    size_t record_length;
+    size_t record_count_{0};
+    size_t span_blocks{1};
+    size_t span_count{0};
+    /* span_count keys of index_item_length bytes. */
+    std::vector<char> sparse_keys{};
+
+    /* The first key starting in the span's first block. */
+    size_t span_first(size_t span) const {
+        return (span * span_blocks * block_size + index_item_length - 1) / index_item_length;
+    }
+
+    const char* sparse_key(size_t span) const {
+        return &sparse_keys[span * index_item_length];
+    }
+
+    /* Copies an index key out of the cached blocks, it may straddle two. */
+    template <typename File>
+    bool read_key(File& file, BlockCache& cache, size_t item, Key& key) {
+        size_t offset = item * index_item_length;
+        size_t copied = 0;
+        while (copied < index_item_length) {
+            auto block = cache.get(file, table, offset / block_size);
+            const size_t within = offset % block_size;
+            if (!block || within >= block->length)
+                return false;
+
+            const size_t n = std::min(index_item_length - copied, block->length - within);
+            std::memcpy(&key[copied], &block->data[within], n);
+            copied += n;
+            offset += n;
+        }
+        return true;
+    }
+};
+
+} /* namespace database_index */
+
+#endif /*__DATABASE_INDEX_H__*/
@@ -92,6 +92,54 @@ class MessageHandlerMap {
 };
 
 static MessageHandlerMap message_map;
+
+class FrameSyncScheduler {
+   public:
+    void add(FrameSyncRegistration* const registration) {
+        registration->next = first;
+        first = registration;
+        generation++;
+    }
+
+    void remove(FrameSyncRegistration* const registration) {
+        for (auto link = &first; *link; link = &(*link)->next) {
+            if (*link == registration) {
+                *link = registration->next;
+                generation++;
+                return;
+            }
+        }
+    }
+
+    void frame_sync(const bool screen_on) {
+        frame_count++;
+        if (!screen_on)
+            return;
+
+        const auto start_generation = generation;
+        for (auto r = first; r; r = r->next) {
+            if (frame_count % r->period)
+                continue;
+            if ((r->mode == FrameSyncRegistration::Mode::Changed) && !r->pending)
+                continue;
+
+            r->pending = false;
+            r->callback();
+
+            // A callback that pushes or pops a view adds or removes
+            // registrations, the rest wait for their next slot.
+            if (generation != start_generation)
+                break;
+        }
+    }
+
+   private:
+    FrameSyncRegistration* first{nullptr};
+    uint32_t frame_count{0};
+    uint32_t generation{0};
+};
+
+static FrameSyncScheduler frame_sync_scheduler;
 Thread* EventDispatcher::thread_event_loop = nullptr;
 bool EventDispatcher::is_running = false;
 bool EventDispatcher::display_sleep = false;
@@ -331,6 +379,7 @@ void EventDispatcher::handle_lcd_frame_sync(bool screen_on) {
 
     DisplayFrameSyncMessage message;  // send framesync msg all the time, bc some apps relay on it
     message_map.send(&message);
+    frame_sync_scheduler.frame_sync(screen_on);
     if (screen_on) {  // only draw when screen is on
         static_cast<ui::SystemView*>(top_widget)->paint_overlay();
         painter.paint_widget_tree(top_widget);
@@ -463,3 +512,17 @@ MessageHandlerRegistration::MessageHandlerRegistration(
 MessageHandlerRegistration::~MessageHandlerRegistration() {
     message_map.unregister_handler(message_id);
 }
+
+FrameSyncRegistration::FrameSyncRegistration(
+    const uint32_t rate_hz,
+    Delegate<void()> callback,
+    const Mode mode)
+    : callback{std::move(callback)},
+      period{(rate_hz && (rate_hz < frame_rate)) ? (frame_rate / rate_hz) : 1},
+      mode{mode} {
+    frame_sync_scheduler.add(this);
+}
+
+FrameSyncRegistration::~FrameSyncRegistration() {
+    frame_sync_scheduler.remove(this);
+}
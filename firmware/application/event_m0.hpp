@@ -156,4 +156,45 @@ class MessageHandlerRegistration {
     const Message::ID message_id;
 };
 
+/* Calls callback at roughly rate_hz from LCD frame sync, for views that don't
+ * need to redraw at the full frame rate (clocks, counters, progress text).
+ * Periods are counted in whole frames from a shared frame counter, so
+ * registrations with related rates run in the same frames and most frames run
+ * none of them. In Mode::Changed the callback is also skipped unless
+ * request_update() was called since it last ran. Nothing runs while the
+ * display is asleep; pending updates run once it wakes.
+ */
+class FrameSyncRegistration {
+   public:
+    enum class Mode {
+        Always,
+        Changed,
+    };
+
+    static constexpr uint32_t frame_rate = 60;
+
+    FrameSyncRegistration(
+        const uint32_t rate_hz,
+        Delegate<void()> callback,
+        const Mode mode = Mode::Always);
+
+    ~FrameSyncRegistration();
+
+    FrameSyncRegistration(const FrameSyncRegistration&) = delete;
+    FrameSyncRegistration& operator=(const FrameSyncRegistration&) = delete;
+
+    void request_update() {
+        pending = true;
+    }
+
+   private:
+    friend class FrameSyncScheduler;
+
+    FrameSyncRegistration* next{nullptr};
+    Delegate<void()> callback;
+    const uint32_t period;
+    const Mode mode;
+    bool pending{false};
+};
+
 #endif /*__EVENT_M0_H__*/
@@ -90,11 +90,13 @@ void ScanningView::on_frame_sync() {
 
     // Get current scanner status
     auto status = container_control::Scanner::get_status();
-    progress_ = container_control::Scanner::get_progress();
-    current_frequency_ = container_control::Scanner::get_current_frequency();
-
-    // Update display every frame
-    update_display();
+    const auto progress = container_control::Scanner::get_progress();
+    const auto frequency = container_control::Scanner::get_current_frequency();
+    if ((progress != progress_) || (frequency != current_frequency_)) {
+        progress_ = progress;
+        current_frequency_ = frequency;
+        display_update.request_update();
+    }
 
     // Get scan results and add to device profiler
     uint16_t result_count = container_control::Scanner::get_result_count();
@@ -105,6 +107,7 @@ void ScanningView::on_frame_sync() {
             container_control::DeviceProfiler::add_signal(results[i].frequency, results[i].rssi);
         }
         devices_found_ = result_count;
+        display_update.request_update();
     }
 
     // Check if scan is complete
@@ -116,6 +119,7 @@ void ScanningView::on_frame_sync() {
         // Analyze devices
         container_control::DeviceProfiler::analyze();
         devices_found_ = container_control::DeviceProfiler::get_device_count();
+        display_update.request_update();
     }
 }
 
@@ -78,6 +78,14 @@ class ScanningView : public View {
             this->on_frame_sync();
         }};
 
+    // Text only needs redrawing a few times a second, and only on change
+    FrameSyncRegistration display_update{
+        10,
+        [this]() {
+            this->update_display();
+        },
+        FrameSyncRegistration::Mode::Changed};
+
     void on_frame_sync();
     void update_display();
     void pause_scan();
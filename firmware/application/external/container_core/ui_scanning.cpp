@@ -82,7 +82,6 @@ void ScanningView::focus() {
 void ScanningView::on_frame_sync() {
     if (!scanning_active_) return;
 
-    // Update display every frame
     update_display();
 
     // Simulate scanning progress (in real implementation, get from Scanner)
@@ -73,10 +73,10 @@ class ScanningView : public View {
         {40, 265, 180, 32},
         "View Results"};
 
-    // Update timer
-    MessageHandlerRegistration message_handler_frame_sync{
-        Message::ID::DisplayFrameSync,
-        [this](const Message* const) {
+    // Update timer, scan progress is shown a few times a second
+    FrameSyncRegistration display_update{
+        10,
+        [this]() {
             this->on_frame_sync();
         }};
 
@@ -222,6 +222,10 @@ set(EXTCPPSRC
 	#subcarrx
 	external/subcarrx/main.cpp
 	external/subcarrx/ui_subcar.cpp
+
+	#multichannel_rx
+	external/multichannel_rx/main.cpp
+	external/multichannel_rx/ui_multichannel_rx.cpp
 )
 
 set(EXTAPPLIST
@@ -271,4 +275,5 @@ set(EXTAPPLIST
 	#bht_tx
 	flex_rx
 	subcarrx
+	multichannel_rx
 )
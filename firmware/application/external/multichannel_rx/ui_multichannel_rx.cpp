@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "ui_multichannel_rx.hpp"
+#include "audio.hpp"
+#include "baseband_api.hpp"
+#include "string_format.hpp"
+#include "portapack.hpp"
+
+#include <algorithm>
+
+using namespace portapack;
+using namespace ui;
+
+namespace ui::external_app::multichannel_rx {
+
+/* ChannelLevels *********************************************************/
+
+ChannelLevels::ChannelLevels(Rect parent_rect)
+    : Widget{parent_rect} {
+    statistics_.db.fill(db_floor);
+}
+
+void ChannelLevels::set_statistics(const ChannelizerStatistics& statistics) {
+    statistics_ = statistics;
+    set_dirty();
+}
+
+void ChannelLevels::set_center_frequency(rf::Frequency frequency) {
+    center_frequency_ = frequency;
+    set_dirty();
+}
+
+void ChannelLevels::set_squelch(int32_t squelch_db) {
+    squelch_db_ = squelch_db;
+    set_dirty();
+}
+
+int ChannelLevels::db_to_width(int db) const {
+    return (std::clamp(db, db_floor, 0) - db_floor) * bar_width / -db_floor;
+}
+
+void ChannelLevels::paint(Painter& painter) {
+    const auto r = screen_rect();
+    const auto theme = Theme::getInstance();
+    const int squelch_x = r.left() + bar_x + db_to_width(squelch_db_);
+
+    for (size_t i = 0; i < ChannelizerStatistics::channel_count; i++) {
+        const int y = r.top() + i * row_height;
+        const int db = statistics_.db[i];
+        const bool active = (static_cast<int>(i) == statistics_.active_channel);
+        const auto& style = active ? *theme->fg_green : *theme->fg_light;
+
+        const int32_t offset = (static_cast<int32_t>(i) - ChannelizerStatistics::channel_count / 2) * ChannelizerStatistics::channel_spacing;
+        painter.draw_string({r.left(), y}, style, to_string_short_freq(center_frequency_ + offset));
+
+        const int width = db_to_width(db);
+        Color bar_color = theme->fg_blue->foreground;
+        if (active)
+            bar_color = theme->fg_green->foreground;
+        else if (db >= squelch_db_)
+            bar_color = theme->fg_yellow->foreground;
+        painter.fill_rectangle({r.left() + bar_x, y + 3, width, row_height - 6}, bar_color);
+        painter.fill_rectangle({r.left() + bar_x + width, y + 3, bar_width - width, row_height - 6}, theme->bg_darkest->background);
+        painter.draw_vline({squelch_x, y + 1}, row_height - 2, theme->fg_red->foreground);
+
+        painter.draw_string({r.left() + bar_x + bar_width + 8, y}, style, to_string_dec_int(db, 4));
+    }
+}
+
+/* MultiChannelRxView ****************************************************/
+
+MultiChannelRxView::MultiChannelRxView(NavigationView& nav)
+    : nav_{nav} {
+    baseband::run_prepared_image(portapack::memory::map::m4_code.base());
+
+    add_children({&field_frequency,
+                  &field_rf_amp,
+                  &field_lna,
+                  &field_vga,
+                  &rssi,
+                  &field_volume,
+                  &labels,
+                  &field_squelch,
+                  &text_active,
+                  &levels});
+
+    field_frequency.set_step(ChannelizerStatistics::channel_spacing);
+    field_frequency.updated = [this](rf::Frequency f) {
+        levels.set_center_frequency(f);
+    };
+    levels.set_center_frequency(receiver_model.target_frequency());
+
+    field_squelch.set_value(squelch_db);
+    field_squelch.on_change = [this](int32_t v) {
+        squelch_db = v;
+        levels.set_squelch(v);
+        configure_baseband();
+    };
+    levels.set_squelch(squelch_db);
+
+    configure_baseband();
+
+    audio::set_rate(audio::Rate::Hz_24000);
+    audio::output::start();
+    receiver_model.enable();
+}
+
+MultiChannelRxView::~MultiChannelRxView() {
+    audio::output::stop();
+    receiver_model.disable();
+    baseband::shutdown();
+}
+
+void MultiChannelRxView::focus() {
+    field_frequency.focus();
+}
+
+void MultiChannelRxView::configure_baseband() {
+    /* 12.5kHz channel plan, narrow FM. */
+    baseband::set_channelizer_config(squelch_db, 2500);
+}
+
+void MultiChannelRxView::on_statistics(const ChannelizerStatistics& statistics) {
+    levels.set_statistics(statistics);
+
+    if (statistics.active_channel < 0) {
+        text_active.set("-");
+    } else {
+        const int32_t offset = (statistics.active_channel - static_cast<int32_t>(ChannelizerStatistics::channel_count / 2)) * ChannelizerStatistics::channel_spacing;
+        text_active.set(to_string_short_freq(receiver_model.target_frequency() + offset));
+    }
+}
+
+}  // namespace ui::external_app::multichannel_rx
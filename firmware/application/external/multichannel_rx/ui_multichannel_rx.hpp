@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __UI_MULTICHANNEL_RX_H__
+#define __UI_MULTICHANNEL_RX_H__
+
+#include "ui.hpp"
+#include "ui_navigation.hpp"
+#include "ui_receiver.hpp"
+#include "ui_freq_field.hpp"
+#include "app_settings.hpp"
+#include "radio_state.hpp"
+#include "message.hpp"
+
+using namespace ui;
+
+namespace ui::external_app::multichannel_rx {
+
+/* One row per channelizer channel: frequency, power bar and level. */
+class ChannelLevels : public Widget {
+   public:
+    ChannelLevels(Rect parent_rect);
+
+    void set_statistics(const ChannelizerStatistics& statistics);
+    void set_center_frequency(rf::Frequency frequency);
+    void set_squelch(int32_t squelch_db);
+
+    void paint(Painter& painter) override;
+
+   private:
+    static constexpr int row_height = 16;
+    static constexpr int bar_x = 10 * 8;
+    static constexpr int bar_width = 18 * 8;
+    static constexpr int db_floor = -120;
+
+    ChannelizerStatistics statistics_{};
+    rf::Frequency center_frequency_{0};
+    int32_t squelch_db_{0};
+
+    int db_to_width(int db) const;
+};
+
+class MultiChannelRxView : public View {
+   public:
+    MultiChannelRxView(NavigationView& nav);
+    ~MultiChannelRxView();
+
+    void focus() override;
+
+    std::string title() const override { return "MultiCh RX"; };
+
+   private:
+    void configure_baseband();
+    void on_statistics(const ChannelizerStatistics& statistics);
+
+    NavigationView& nav_;
+    RxRadioState radio_state_{
+        446'100'000 /* frequency */,
+        1'750'000 /* bandwidth */,
+        ChannelizerStatistics::sampling_rate /* sampling rate */,
+        ReceiverModel::Mode::NarrowbandFMAudio};
+
+    int32_t squelch_db{-70};
+    app_settings::SettingsManager settings_{
+        "rx_multichannel",
+        app_settings::Mode::RX,
+        {
+            {"squelch_db"sv, &squelch_db},
+        }};
+
+    RxFrequencyField field_frequency{
+        {UI_POS_X(0), UI_POS_Y(0)},
+        nav_};
+    RFAmpField field_rf_amp{
+        {13 * 8, UI_POS_Y(0)}};
+    LNAGainField field_lna{
+        {15 * 8, UI_POS_Y(0)}};
+    VGAGainField field_vga{
+        {18 * 8, UI_POS_Y(0)}};
+    RSSI rssi{
+        {21 * 8, 0, UI_POS_WIDTH_REMAINING(24), 4}};
+    AudioVolumeField field_volume{
+        {screen_width - 2 * 8, UI_POS_Y(0)}};
+
+    Labels labels{
+        {{UI_POS_X(0), UI_POS_Y(1)}, "Squelch:    dB", Theme::getInstance()->fg_light->foreground},
+        {{17 * 8, UI_POS_Y(1)}, "Ch:", Theme::getInstance()->fg_light->foreground},
+    };
+
+    NumberField field_squelch{
+        {9 * 8, UI_POS_Y(1)},
+        4,
+        {-120, 0},
+        1,
+        ' '};
+
+    Text text_active{
+        {21 * 8, UI_POS_Y(1), 9 * 8, 16},
+        "-"};
+
+    ChannelLevels levels{
+        {0, 2 * 16 + 8, screen_width, ChannelizerStatistics::channel_count * 16}};
+
+    MessageHandlerRegistration message_handler_statistics{
+        Message::ID::ChannelizerStatistics,
+        [this](Message* const p) {
+            const auto message = static_cast<const ChannelizerStatisticsMessage*>(p);
+            this->on_statistics(message->statistics);
+        }};
+};
+
+}  // namespace ui::external_app::multichannel_rx
+
+#endif /*__UI_MULTICHANNEL_RX_H__*/
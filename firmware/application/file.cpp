@@ -22,6 +22,7 @@
 
 #include "file.hpp"
 #include "complex.hpp"
+#include "diskio.h"
 
 #include <algorithm>
 #include <codecvt>
@@ -31,6 +32,7 @@
 namespace fs = std::filesystem;
 static const fs::path c8_ext{u".C8"};
 static const fs::path c16_ext{u".C16"};
+static const fs::path ciq_ext{u".CIQ"};
 
 Optional<File::Error> File::open_fatfs(const std::filesystem::path& filename, BYTE mode) {
     auto result = f_open(&f, reinterpret_cast<const TCHAR*>(filename.c_str()), mode);
@@ -132,6 +134,34 @@ File::Result<File::Offset> File::truncate() {
     return {static_cast<File::Offset>(position)};
 }
 
+Optional<File::Error> File::expand(Size size) {
+    const auto result = f_expand(&f, size, 1);
+    if (result != FR_OK) {
+        return {result};
+    }
+    return {};
+}
+
+Optional<File::Error> File::write_sectors(uint32_t first_sector, const void* data, uint32_t sector_count) {
+    FATFS* const fs = f.obj.fs;
+    if (!fs || f.obj.sclust < 2) {
+        return {FR_INVALID_OBJECT};
+    }
+    const DWORD sector = fs->database + (f.obj.sclust - 2) * fs->csize + first_sector;
+
+    // Hold the volume lock so the transfer can't interleave with FatFs calls from other threads.
+    if (!ff_req_grant(fs->sobj)) {
+        return {FR_TIMEOUT};
+    }
+    const auto result = disk_write(fs->drv, static_cast<const BYTE*>(data), sector, sector_count);
+    ff_rel_grant(fs->sobj);
+
+    if (result != RES_OK) {
+        return {FR_DISK_ERR};
+    }
+    return {};
+}
+
 File::Size File::size() const {
     return f_size(&f);
 }
@@ -542,7 +572,11 @@ bool path_iequal(
 
 bool is_cxx_capture_file(const path& filename) {
     auto ext = filename.extension();
-    return path_iequal(c8_ext, ext) || path_iequal(c16_ext, ext);
+    return path_iequal(c8_ext, ext) || path_iequal(c16_ext, ext) || path_iequal(ciq_ext, ext);
+}
+
+bool is_compressed_capture_file(const path& filename) {
+    return path_iequal(ciq_ext, filename.extension());
 }
 
 uint8_t capture_file_sample_size(const path& filename) {
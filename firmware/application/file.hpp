@@ -171,6 +171,8 @@ path operator/(const path& lhs, const path& rhs);
 /* Case insensitive path equality on underlying "native" string. */
 bool path_iequal(const path& lhs, const path& rhs);
 bool is_cxx_capture_file(const path& filename);
+/* .CIQ captures, lossless compressed C16. Their sample size on disk is 0. */
+bool is_compressed_capture_file(const path& filename);
 uint8_t capture_file_sample_size(const path& filename);
 
 using file_status = BYTE;
@@ -355,6 +357,17 @@ class File {
     // TODO: Return Result<>.
     Optional<Error> sync();
 
+    static constexpr Size sector_size = _MAX_SS;
+
+    /* Allocates a contiguous extent of size bytes to a newly created, empty
+     * file. The file size becomes size, truncate() gives back the rest. */
+    Optional<Error> expand(Size size);
+
+    /* Writes whole sectors of an expanded file straight to the card in one
+     * multi-block transfer, bypassing the FatFs buffers and FAT updates.
+     * Does not move the file position. */
+    Optional<Error> write_sectors(uint32_t first_sector, const void* data, uint32_t sector_count);
+
     /* Reads the entire file contents to a string.
      * NB: This will likely fail for files larger than ~10kB. */
     static Result<std::string> read_file(const std::filesystem::path& filename);
@@ -21,9 +21,18 @@
 
 #include "io_convert.hpp"
 #include "complex.hpp"
+#include "iq_codec.hpp"
+
+#include <algorithm>
+#include <cstring>
 
 namespace fs = std::filesystem;
 static const fs::path c8_ext = u".C8";
+static const fs::path ciq_ext = u".CIQ";
+
+/* .CIQ encoded output is written in chunks of this size. */
+static constexpr size_t ciq_chunk_size = 4 * File::sector_size;
+static constexpr size_t ciq_block_bytes = iq_codec::block_samples * sizeof(complex16_t);
 
 namespace file_convert {
 
@@ -64,11 +73,34 @@ void c8_to_c16(const void* buffer, File::Size bytes) {
 // Automatically enables C8/C16 conversion based on file extension
 Optional<File::Error> FileConvertReader::open(const std::filesystem::path& filename) {
     convert_c8_to_c16 = path_iequal(filename.extension(), c8_ext);
-    return file_.open(filename);
+    decompress_ciq = path_iequal(filename.extension(), ciq_ext);
+
+    auto error = file_.open(filename);
+    if (error.is_valid() || !decompress_ciq) {
+        return error;
+    }
+
+    iq_codec::FileHeader header{};
+    auto read_result = file_.read(&header, sizeof(header));
+    if (read_result.is_error()) {
+        return read_result.error();
+    }
+    if (read_result.value() != sizeof(header) || !iq_codec::is_valid(header)) {
+        return File::Error{FR_UNEXPECTED};
+    }
+
+    codec_buffer_ = std::make_unique<uint8_t[]>(ciq_block_bytes + iq_codec::max_payload_bytes);
+    decoded_bytes_ = 0;
+    decoded_offset_ = 0;
+    return {};
 }
 
 // If C8 conversion enabled, half the number of bytes are read from the file & expanded to fill the whole buffer.
 File::Result<File::Size> FileConvertReader::read(void* const buffer, const File::Size bytes) {
+    if (decompress_ciq) {
+        return read_ciq(buffer, bytes);
+    }
+
     auto read_result = file_.read(buffer, convert_c8_to_c16 ? bytes / 2 : bytes);
     if (read_result.is_ok()) {
         if (convert_c8_to_c16) {
@@ -80,18 +112,128 @@ File::Result<File::Size> FileConvertReader::read(void* const buffer, const File:
     return read_result;
 }
 
+// Returns decoded C16 bytes, 0 at the end of the file.
+File::Result<File::Size> FileConvertReader::read_ciq(void* const buffer, const File::Size bytes) {
+    auto dst = static_cast<uint8_t*>(buffer);
+    File::Size copied = 0;
+
+    while (copied < bytes) {
+        if (decoded_offset_ == decoded_bytes_) {
+            auto error = read_ciq_block();
+            if (error.is_valid()) {
+                return error.value();
+            }
+            if (decoded_bytes_ == 0) {
+                break;
+            }
+        }
+
+        const size_t n = std::min<File::Size>(bytes - copied, decoded_bytes_ - decoded_offset_);
+        std::memcpy(&dst[copied], &codec_buffer_[decoded_offset_], n);
+        decoded_offset_ += n;
+        copied += n;
+    }
+
+    bytes_read_ += copied;
+    return {static_cast<File::Size>(copied)};
+}
+
+Optional<File::Error> FileConvertReader::read_ciq_block() {
+    decoded_bytes_ = 0;
+    decoded_offset_ = 0;
+
+    iq_codec::BlockHeader header{};
+    auto read_result = file_.read(&header, sizeof(header));
+    if (read_result.is_error()) {
+        return read_result.error();
+    }
+    if (read_result.value() < sizeof(header)) {
+        return {};  // End of file, a truncated header included.
+    }
+
+    auto payload = &codec_buffer_[ciq_block_bytes];
+    if (header.payload_bytes > iq_codec::max_payload_bytes) {
+        return File::Error{FR_UNEXPECTED};
+    }
+    read_result = file_.read(payload, header.payload_bytes);
+    if (read_result.is_error()) {
+        return read_result.error();
+    }
+    if (read_result.value() != header.payload_bytes) {
+        return {};  // Capture cut short, drop the partial block.
+    }
+
+    if (!iq_codec::decode_block(header, payload, reinterpret_cast<complex16_t*>(codec_buffer_.get()))) {
+        return File::Error{FR_UNEXPECTED};
+    }
+    decoded_bytes_ = header.sample_count * sizeof(complex16_t);
+    return {};
+}
+
 // Automatically enables C8/C16 conversion based on file extension
 Optional<File::Error> FileConvertWriter::create(const std::filesystem::path& filename) {
     convert_c16_to_c8 = path_iequal(filename.extension(), c8_ext);
-    return file_.create(filename);
+    compress_ciq = path_iequal(filename.extension(), ciq_ext);
+
+    auto error = file_.create(filename);
+    if (error.is_valid() || !compress_ciq) {
+        return error;
+    }
+
+    // The header goes out with the first chunk and is rewritten on close.
+    codec_buffer_ = std::make_unique<uint8_t[]>(ciq_block_bytes + ciq_chunk_size + iq_codec::max_block_bytes);
+    const auto header = iq_codec::make_file_header();
+    std::memcpy(&codec_buffer_[ciq_block_bytes], &header, sizeof(header));
+    staged_bytes_ = sizeof(header);
+    pending_samples_ = 0;
+    return {};
+}
+
+Optional<File::Error> FileConvertWriter::create(const std::filesystem::path& filename, File::Size preallocate_size) {
+    auto error = create(filename);
+    if (error.is_valid() || preallocate_size == 0) {
+        return error;
+    }
+
+    // Round down to whole sectors, the tail goes through FatFs anyway.
+    preallocate_size -= preallocate_size % File::sector_size;
+    if (preallocate_size > 0 && !file_.expand(preallocate_size).is_valid()) {
+        extent_size_ = preallocate_size;
+    }
+    return {};
+}
+
+FileConvertWriter::~FileConvertWriter() {
+    if (compress_ciq && codec_buffer_) {
+        finish_ciq();
+    }
+    if (extent_size_ > 0) {
+        // Give back the unused part of the extent.
+        file_.seek(file_position_);
+        file_.truncate();
+    }
+    if (compress_ciq && codec_buffer_) {
+        const auto header = iq_codec::make_file_header(bytes_written_ / sizeof(complex16_t));
+        file_.seek(0);
+        file_.write(&header, sizeof(header));
+    }
 }
 
 // If C8 conversion is enabled, half the number of bytes are written to the file.
 File::Result<File::Size> FileConvertWriter::write(const void* const buffer, const File::Size bytes) {
+    if (compress_ciq) {
+        auto error = write_ciq(buffer, bytes);
+        if (error.is_valid()) {
+            return error.value();
+        }
+        bytes_written_ += bytes;
+        return {static_cast<File::Size>(bytes)};
+    }
+
     if (convert_c16_to_c8) {
         file_convert::c16_to_c8(buffer, bytes);
     }
-    auto write_result = file_.write(buffer, convert_c16_to_c8 ? bytes / 2 : bytes);
+    auto write_result = write_file(buffer, convert_c16_to_c8 ? bytes / 2 : bytes);
     if (write_result.is_ok()) {
         if (convert_c16_to_c8) {
             write_result = write_result.value() * 2;
@@ -100,3 +242,93 @@ File::Result<File::Size> FileConvertWriter::write(const void* const buffer, cons
     }
     return write_result;
 }
+
+File::Result<File::Size> FileConvertWriter::write_file(const void* const buffer, const File::Size bytes) {
+    const bool in_extent = (file_position_ + bytes) <= extent_size_;
+    const bool aligned = ((file_position_ | bytes) % File::sector_size) == 0;
+
+    if (in_extent && aligned) {
+        auto error = file_.write_sectors(file_position_ / File::sector_size, buffer, bytes / File::sector_size);
+        if (error.is_valid()) {
+            return error.value();
+        }
+    } else {
+        if (extent_size_ > 0 && file_.tell() != file_position_) {
+            // Raw writes don't move the file position.
+            auto seek_result = file_.seek(file_position_);
+            if (seek_result.is_error()) {
+                return seek_result.error();
+            }
+        }
+        auto write_result = file_.write(buffer, bytes);
+        if (write_result.is_error()) {
+            return write_result;
+        }
+    }
+
+    file_position_ += bytes;
+    return {static_cast<File::Size>(bytes)};
+}
+
+// Encodes whole blocks straight from the buffer, buffering only the remainder.
+Optional<File::Error> FileConvertWriter::write_ciq(const void* const buffer, const File::Size bytes) {
+    auto src = static_cast<const complex16_t*>(buffer);
+    size_t count = bytes / sizeof(complex16_t);
+    auto pending = reinterpret_cast<complex16_t*>(codec_buffer_.get());
+
+    while (count > 0) {
+        if (pending_samples_ == 0 && count >= iq_codec::block_samples) {
+            auto error = encode_ciq_block(src, iq_codec::block_samples);
+            if (error.is_valid()) {
+                return error;
+            }
+            src += iq_codec::block_samples;
+            count -= iq_codec::block_samples;
+            continue;
+        }
+
+        const size_t n = std::min(count, iq_codec::block_samples - pending_samples_);
+        std::memcpy(&pending[pending_samples_], src, n * sizeof(complex16_t));
+        pending_samples_ += n;
+        src += n;
+        count -= n;
+
+        if (pending_samples_ == iq_codec::block_samples) {
+            pending_samples_ = 0;
+            auto error = encode_ciq_block(pending, iq_codec::block_samples);
+            if (error.is_valid()) {
+                return error;
+            }
+        }
+    }
+
+    return {};
+}
+
+Optional<File::Error> FileConvertWriter::encode_ciq_block(const complex16_t* samples, size_t count) {
+    auto staging = &codec_buffer_[ciq_block_bytes];
+    staged_bytes_ += iq_codec::encode_block(samples, count, &staging[staged_bytes_]);
+
+    while (staged_bytes_ >= ciq_chunk_size) {
+        auto write_result = write_file(staging, ciq_chunk_size);
+        if (write_result.is_error()) {
+            return write_result.error();
+        }
+        staged_bytes_ -= ciq_chunk_size;
+        std::memmove(staging, &staging[ciq_chunk_size], staged_bytes_);
+    }
+
+    return {};
+}
+
+// Flushes the partial block and the staged tail of the stream.
+void FileConvertWriter::finish_ciq() {
+    if (pending_samples_ > 0) {
+        encode_ciq_block(reinterpret_cast<complex16_t*>(codec_buffer_.get()), pending_samples_);
+        pending_samples_ = 0;
+    }
+    if (staged_bytes_ > 0) {
+        write_file(&codec_buffer_[ciq_block_bytes], staged_bytes_);
+        staged_bytes_ = 0;
+    }
+}
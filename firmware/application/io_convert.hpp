@@ -25,10 +25,12 @@
 #include "io_file.hpp"
 
 #include "io.hpp"
+#include "complex.hpp"
 #include "file.hpp"
 #include "optional.hpp"
 
 #include <cstdint>
+#include <memory>
 
 namespace file_convert {
 
@@ -52,15 +54,25 @@ class FileConvertReader : public stream::Reader {
     const File& file() const& { return file_; }
 
     bool convert_c8_to_c16{};
+    bool decompress_ciq{};
 
    protected:
     File file_{};
     uint64_t bytes_read_{0};
+
+    /* Decoded block and its compressed payload, .CIQ only. */
+    std::unique_ptr<uint8_t[]> codec_buffer_{};
+    size_t decoded_bytes_{0};
+    size_t decoded_offset_{0};
+
+    File::Result<File::Size> read_ciq(void* const buffer, const File::Size bytes);
+    Optional<File::Error> read_ciq_block();
 };
 
 class FileConvertWriter : public stream::Writer {
    public:
     FileConvertWriter() = default;
+    ~FileConvertWriter();
 
     FileConvertWriter(const FileConvertWriter&) = delete;
     FileConvertWriter& operator=(const FileConvertWriter&) = delete;
@@ -69,14 +81,35 @@ class FileConvertWriter : public stream::Writer {
 
     Optional<File::Error> create(const std::filesystem::path& filename);
 
+    /* Also tries to reserve a contiguous extent of preallocate_size bytes.
+     * Sector aligned writes inside it go straight to the card; the file is
+     * truncated to what was written when the writer is destroyed. If no
+     * contiguous space is found the file is written normally. */
+    Optional<File::Error> create(const std::filesystem::path& filename, File::Size preallocate_size);
+
     File::Result<File::Size> write(const void* const buffer, const File::Size bytes) override;
     const File& file() const& { return file_; }
 
     bool convert_c16_to_c8{};
+    bool compress_ciq{};
 
    protected:
     File file_{};
     uint64_t bytes_written_{0};
+
+    File::Size extent_size_{0};
+    File::Size file_position_{0};
+
+    /* Samples waiting for a full block, then the encoded output staged so
+     * the file sees whole chunks (sector aligned for the extent), .CIQ only. */
+    std::unique_ptr<uint8_t[]> codec_buffer_{};
+    size_t pending_samples_{0};
+    size_t staged_bytes_{0};
+
+    File::Result<File::Size> write_file(const void* const buffer, const File::Size bytes);
+    Optional<File::Error> write_ciq(const void* const buffer, const File::Size bytes);
+    Optional<File::Error> encode_ciq_block(const complex16_t* samples, size_t count);
+    void finish_ciq();
 };
 
 #endif
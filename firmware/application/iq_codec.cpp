@@ -0,0 +1,271 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "iq_codec.hpp"
+
+#include <cstring>
+
+namespace iq_codec {
+
+namespace {
+
+class BitWriter {
+   public:
+    BitWriter(uint8_t* p)
+        : p{p} {
+    }
+
+    void write(uint32_t value, size_t bits) {
+        while (bits > 0) {
+            const size_t n = (bits > 24) ? 24 : bits;
+            bits -= n;
+            acc = (acc << n) | ((value >> bits) & ((1U << n) - 1));
+            acc_bits += n;
+            while (acc_bits >= 8) {
+                acc_bits -= 8;
+                *(p++) = acc >> acc_bits;
+            }
+        }
+    }
+
+    void write_ones(size_t count) {
+        while (count > 0) {
+            const size_t n = (count > 24) ? 24 : count;
+            write((1U << n) - 1, n);
+            count -= n;
+        }
+    }
+
+    /* Pads to a byte boundary and returns the end of the stream. */
+    uint8_t* flush() {
+        if (acc_bits > 0) {
+            write(0, 8 - acc_bits);
+        }
+        return p;
+    }
+
+   private:
+    uint8_t* p;
+    uint32_t acc{0};
+    size_t acc_bits{0};
+};
+
+class BitReader {
+   public:
+    BitReader(const uint8_t* p, const uint8_t* end)
+        : p{p}, end{end} {
+    }
+
+    uint32_t read(size_t bits) {
+        uint32_t value = 0;
+        while (bits > 0) {
+            if (acc_bits == 0 && !fill())
+                return 0;
+            const size_t n = (bits > acc_bits) ? acc_bits : bits;
+            acc_bits -= n;
+            bits -= n;
+            value = (value << n) | ((acc >> acc_bits) & ((1U << n) - 1));
+        }
+        return value;
+    }
+
+    /* Counts ones up to the terminating zero, stopping at limit. */
+    uint32_t read_unary(uint32_t limit) {
+        uint32_t count = 0;
+        while (count < limit && read(1))
+            count++;
+        return count;
+    }
+
+    bool overrun() const { return overrun_; }
+
+   private:
+    const uint8_t* p;
+    const uint8_t* const end;
+    uint32_t acc{0};
+    size_t acc_bits{0};
+    bool overrun_{false};
+
+    bool fill() {
+        if (p == end) {
+            overrun_ = true;
+            return false;
+        }
+        acc = *(p++);
+        acc_bits = 8;
+        return true;
+    }
+};
+
+constexpr uint32_t zigzag(int32_t v) {
+    return (static_cast<uint32_t>(v) << 1) ^ static_cast<uint32_t>(v >> 31);
+}
+
+constexpr int32_t unzigzag(uint32_t u) {
+    return static_cast<int32_t>(u >> 1) ^ -static_cast<int32_t>(u & 1);
+}
+
+/* Channel accessors so I and Q are coded straight from the interleaved samples. */
+int32_t sample(const complex16_t* src, size_t channel, size_t i) {
+    return channel ? src[i].imag() : src[i].real();
+}
+
+int32_t residual(const complex16_t* src, size_t channel, size_t order, size_t i) {
+    const int32_t x0 = sample(src, channel, i);
+    switch (order) {
+        case 0:
+            return x0;
+        case 1:
+            return x0 - sample(src, channel, i - 1);
+        default:
+            return x0 - 2 * sample(src, channel, i - 1) + sample(src, channel, i - 2);
+    }
+}
+
+void encode_channel(const complex16_t* src, size_t count, size_t channel, BitWriter& bits) {
+    constexpr size_t max_order = 2;
+
+    /* Sum of the zigzag residuals for each order, over the samples all
+     * orders predict so the sums compare fairly. */
+    uint64_t sums[max_order + 1]{};
+    for (size_t i = max_order; i < count; i++) {
+        for (size_t order = 0; order <= max_order; order++) {
+            sums[order] += zigzag(residual(src, channel, order, i));
+        }
+    }
+
+    size_t order = 0;
+    for (size_t o = 1; o <= max_order; o++) {
+        if (sums[o] < sums[order])
+            order = o;
+    }
+    if (order > count)
+        order = count;
+
+    /* 2^k is the largest power of two not above the mean residual. */
+    const size_t n = (count > max_order) ? (count - max_order) : 1;
+    uint32_t k = 0;
+    while (k < escape_bits && (uint64_t{n} << (k + 1)) <= sums[order])
+        k++;
+
+    /* Exact size, so a block never outgrows the verbatim worst case. */
+    uint64_t coded_bits = order * 16;
+    for (size_t i = order; i < count; i++) {
+        const uint32_t q = zigzag(residual(src, channel, order, i)) >> k;
+        coded_bits += (q < escape_quotient) ? (q + 1 + k) : (escape_quotient + escape_bits);
+    }
+
+    if (coded_bits >= uint64_t{count} * 16) {
+        bits.write(0, 2);
+        bits.write(verbatim_rice_parameter, 5);
+        for (size_t i = 0; i < count; i++) {
+            bits.write(static_cast<uint16_t>(sample(src, channel, i)), 16);
+        }
+        return;
+    }
+
+    bits.write(order, 2);
+    bits.write(k, 5);
+    for (size_t i = 0; i < order; i++) {
+        bits.write(static_cast<uint16_t>(sample(src, channel, i)), 16);
+    }
+    for (size_t i = order; i < count; i++) {
+        const uint32_t u = zigzag(residual(src, channel, order, i));
+        const uint32_t q = u >> k;
+        if (q < escape_quotient) {
+            bits.write_ones(q);
+            bits.write(0, 1);
+            bits.write(u, k);
+        } else {
+            bits.write_ones(escape_quotient);
+            bits.write(u, escape_bits);
+        }
+    }
+}
+
+bool decode_channel(BitReader& bits, size_t count, size_t channel, complex16_t* dst) {
+    const size_t order = bits.read(2);
+    const uint32_t k = bits.read(5);
+    int32_t x1 = 0;
+    int32_t x2 = 0;
+
+    if (k == verbatim_rice_parameter) {
+        if (order != 0)
+            return false;
+    } else if (order > 2 || k > escape_bits) {
+        return false;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        int32_t x;
+        if (k == verbatim_rice_parameter || i < order) {
+            x = static_cast<int16_t>(bits.read(16));
+        } else {
+            const uint32_t q = bits.read_unary(escape_quotient);
+            const uint32_t u = (q < escape_quotient) ? ((q << k) | bits.read(k)) : bits.read(escape_bits);
+            const int32_t r = unzigzag(u);
+            x = (order == 0) ? r : (order == 1) ? (r + x1)
+                                                : (r + 2 * x1 - x2);
+        }
+
+        x2 = x1;
+        x1 = x;
+        if (channel)
+            dst[i].imag(static_cast<int16_t>(x));
+        else
+            dst[i].real(static_cast<int16_t>(x));
+    }
+
+    return !bits.overrun();
+}
+
+} /* namespace */
+
+bool is_valid(const FileHeader& header) {
+    const auto expected = make_file_header();
+    return std::memcmp(header.magic, expected.magic, sizeof(header.magic)) == 0 &&
+           header.version == expected.version &&
+           header.block_samples == expected.block_samples;
+}
+
+size_t encode_block(const complex16_t* src, size_t count, uint8_t* dst) {
+    BitWriter bits{dst + sizeof(BlockHeader)};
+    encode_channel(src, count, 0, bits);
+    encode_channel(src, count, 1, bits);
+    const uint8_t* end = bits.flush();
+
+    BlockHeader header{
+        static_cast<uint16_t>(end - dst - sizeof(BlockHeader)),
+        static_cast<uint16_t>(count)};
+    std::memcpy(dst, &header, sizeof(header));
+    return end - dst;
+}
+
+bool decode_block(const BlockHeader& header, const uint8_t* payload, complex16_t* dst) {
+    if (header.sample_count > block_samples || header.payload_bytes > max_payload_bytes)
+        return false;
+
+    BitReader bits{payload, payload + header.payload_bytes};
+    return decode_channel(bits, header.sample_count, 0, dst) &&
+           decode_channel(bits, header.sample_count, 1, dst);
+}
+
+} /* namespace iq_codec */
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __IQ_CODEC_H__
+#define __IQ_CODEC_H__
+
+#include "complex.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+/* Lossless compression for C16 captures (.CIQ files).
+ *
+ * The stream is a FileHeader followed by independent blocks of up to
+ * block_samples complex samples. Each block has a 4 byte BlockHeader and a
+ * bit stream (MSB first, padded to a whole byte) holding the I channel then
+ * the Q channel. A channel starts with a 2 bit predictor order and a 5 bit
+ * Rice parameter. Then come the warm-up samples (order x 16 bits) and the
+ * Rice coded, zigzag mapped prediction residuals. Rice parameter 31 marks
+ * a channel stored verbatim, 16 bits per sample.
+ *
+ * The predictors are the fixed polynomial ones FLAC uses: order 0 stores
+ * the sample, order 1 the first difference and order 2 the second
+ * difference. The encoder picks the order with the smallest residual sum.
+ */
+namespace iq_codec {
+
+constexpr size_t block_samples = 512;
+constexpr uint32_t verbatim_rice_parameter = 31;
+
+/* Quotients this large are written as escape_quotient ones followed by the
+ * zigzag residual in escape_bits bits. */
+constexpr uint32_t escape_quotient = 24;
+constexpr uint32_t escape_bits = 20;
+
+struct FileHeader {
+    char magic[4];
+    uint16_t version;
+    uint16_t block_samples;
+    /* Patched in when the capture is closed, 0 if it never was. */
+    uint64_t sample_count;
+};
+static_assert(sizeof(FileHeader) == 16, "FileHeader must be 16 bytes");
+
+constexpr FileHeader make_file_header(uint64_t sample_count = 0) {
+    return {{'C', 'I', 'Q', '1'}, 1, block_samples, sample_count};
+}
+
+bool is_valid(const FileHeader& header);
+
+struct BlockHeader {
+    uint16_t payload_bytes;
+    uint16_t sample_count;
+};
+static_assert(sizeof(BlockHeader) == 4, "BlockHeader must be 4 bytes");
+
+/* Worst case is both channels verbatim. */
+constexpr size_t max_payload_bytes = 2 * (1 + block_samples * sizeof(int16_t));
+constexpr size_t max_block_bytes = sizeof(BlockHeader) + max_payload_bytes;
+
+/* Encodes count (<= block_samples) samples into dst, which must hold
+ * max_block_bytes. Returns the number of bytes written, header included. */
+size_t encode_block(const complex16_t* src, size_t count, uint8_t* dst);
+
+/* Decodes the payload of a block described by header into dst, which must
+ * hold header.sample_count samples. Returns false on a corrupt block. */
+bool decode_block(const BlockHeader& header, const uint8_t* payload, complex16_t* dst);
+
+} /* namespace iq_codec */
+
+#endif /*__IQ_CODEC_H__*/
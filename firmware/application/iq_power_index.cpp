@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "iq_power_index.hpp"
+
+#include <cstring>
+#include <memory>
+
+namespace fs = std::filesystem;
+
+namespace iq {
+
+fs::path get_power_index_path(const fs::path& capture_path) {
+    auto temp = capture_path;
+    return temp.replace_extension(u".PWR");
+}
+
+bool is_valid(const PowerIndexHeader& header) {
+    return std::memcmp(header.magic, "PWRI", sizeof(header.magic)) == 0 &&
+           header.version == 1 &&
+           header.bin_samples > 0;
+}
+
+size_t power_index_bin_count(const PowerIndexHeader& header, size_t level) {
+    if (level >= 64)
+        return 0;
+
+    const uint64_t width = uint64_t{header.bin_samples} << level;
+    const uint64_t count = (header.sample_count + width - 1) / width;
+
+    // Levels end at the first single bin one.
+    if (level > 0 && power_index_bin_count(header, level - 1) <= 1)
+        return 0;
+
+    return count;
+}
+
+size_t power_index_level_for(const PowerIndexHeader& header, size_t min_bins) {
+    size_t level = 0;
+    while (level + 1 < header.level_count &&
+           power_index_bin_count(header, level + 1) >= min_bins)
+        level++;
+
+    return level;
+}
+
+PowerIndexBuilder::PowerIndexBuilder(
+    fs::path path,
+    uint8_t sample_size,
+    uint8_t scale_shift)
+    : path{std::move(path)},
+      sample_size{sample_size},
+      scale_shift{scale_shift} {
+    bins.reserve(capacity);
+}
+
+void PowerIndexBuilder::push_bin() {
+    bins.push_back({bin_min, bin_max, static_cast<uint32_t>(bin_taken ? bin_sum / bin_taken : 0)});
+    bin_fill = 0;
+    bin_min = std::numeric_limits<uint32_t>::max();
+    bin_max = 0;
+    bin_sum = 0;
+    bin_taken = 0;
+}
+
+void PowerIndexBuilder::close_bin() {
+    push_bin();
+
+    // Full, merge neighbours. All of these cover bin_samples.
+    if (bins.size() == capacity) {
+        for (size_t k = 0; k < capacity / 2; k++)
+            bins[k] = merge(bins[2 * k], bins[2 * k + 1], 1, 1);
+
+        bins.resize(capacity / 2);
+        bin_samples *= 2;
+    }
+}
+
+Optional<File::Error> PowerIndexBuilder::write() {
+    // Runs on the capture thread, keep the 556 byte File off its stack.
+    auto f = std::make_unique<File>();
+    auto error = f->create(path);
+    if (error)
+        return error;
+
+    return write_to(*f);
+}
+
+File::Result<File::Size> write_indexed(
+    stream::Writer& writer,
+    PowerIndexBuilder* index,
+    const void* buffer,
+    File::Size bytes) {
+    if (index)
+        index->add(static_cast<const complex16_t*>(buffer), bytes / sizeof(complex16_t));
+    return writer.write(buffer, bytes);
+}
+
+}  // namespace iq
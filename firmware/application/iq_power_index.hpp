@@ -0,0 +1,274 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __IQ_POWER_INDEX_H__
+#define __IQ_POWER_INDEX_H__
+
+#include "complex.hpp"
+#include "file.hpp"
+#include "io.hpp"
+#include "optional.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+/* Power overview of a capture (.PWR files), written alongside C8/C16 captures
+ * so IQ trim doesn't have to read the whole capture again.
+ *
+ * The file is a PowerIndexHeader followed by level_count levels of
+ * PowerIndexBins, finest first. A level 0 bin covers bin_samples samples and
+ * each following level halves the bin count, down to a single bin. The last
+ * bin of a level covers whatever is left of the capture. Powers are |IQ|^2 in
+ * the units of the capture's samples, taken from every sample_stride-th sample.
+ */
+namespace iq {
+
+template <typename T>
+uint32_t power(T value) {
+    auto real = value.real();
+    auto imag = value.imag();
+    return (real * real) + (imag * imag);
+}
+
+template <typename T>
+uint32_t iq_max(T value) {
+    auto real = abs(value.real());
+    auto imag = abs(value.imag());
+    return (real > imag) ? real : imag;
+}
+
+struct PowerIndexHeader {
+    char magic[4];
+    uint8_t version;
+    uint8_t sample_size;
+    uint8_t level_count;
+    uint8_t reserved;
+    uint64_t sample_count;
+    uint32_t bin_samples;
+    uint32_t max_power;
+    uint32_t max_iq;
+    uint32_t reserved2;
+};
+static_assert(sizeof(PowerIndexHeader) == 32, "PowerIndexHeader must be 32 bytes");
+
+struct PowerIndexBin {
+    uint32_t min;
+    uint32_t max;
+    uint32_t mean;
+};
+static_assert(sizeof(PowerIndexBin) == 12, "PowerIndexBin must be 12 bytes");
+
+std::filesystem::path get_power_index_path(const std::filesystem::path& capture_path);
+
+bool is_valid(const PowerIndexHeader& header);
+
+/* Number of bins in a level, 0 past the last one. */
+size_t power_index_bin_count(const PowerIndexHeader& header, size_t level);
+
+/* The coarsest level with at least min_bins bins, level 0 if none has. */
+size_t power_index_level_for(const PowerIndexHeader& header, size_t min_bins);
+
+/* Accumulates the index as samples stream through, in a fixed amount of
+ * memory: once capacity bins are filled, neighbours are merged and the bin
+ * width doubles. The capture thread feeds it baseband C16 samples, so a C8
+ * capture passes scale_shift 8 to get powers in C8 units. Feed it through
+ * write_indexed(), which indexes before a C8 writer converts in place. */
+class PowerIndexBuilder {
+   public:
+    static constexpr size_t capacity = 512;
+    static constexpr uint32_t initial_bin_samples = 256;
+    static constexpr uint32_t sample_stride = 4;
+
+    PowerIndexBuilder(
+        std::filesystem::path path,
+        uint8_t sample_size,
+        uint8_t scale_shift = 0);
+
+    template <typename T>
+    void add(const T* samples, size_t count) {
+        size_t i = 0;
+        while (i < count) {
+            const size_t n = std::min<size_t>(count - i, bin_samples - bin_fill);
+
+            // Bins start on a stride boundary, so the phase is just bin_fill.
+            for (size_t j = (sample_stride - bin_fill % sample_stride) % sample_stride; j < n; j += sample_stride)
+                accumulate(power(samples[i + j]), iq_max(samples[i + j]));
+
+            i += n;
+            bin_fill += n;
+            if (bin_fill == bin_samples)
+                close_bin();
+        }
+        sample_count_ += count;
+    }
+
+    uint64_t sample_count() const { return sample_count_; }
+
+    /* Writes the index to its path. Consumes the bins, call once at the end. */
+    Optional<File::Error> write();
+
+    template <typename F>
+    Optional<File::Error> write_to(F& f) {
+        // Never full here, close_bin() merges as soon as it is.
+        if (bin_fill > 0)
+            push_bin();
+
+        if (scale_shift > 0) {
+            for (auto& bin : bins) {
+                bin.min >>= 2 * scale_shift;
+                bin.max >>= 2 * scale_shift;
+                bin.mean >>= 2 * scale_shift;
+            }
+        }
+
+        PowerIndexHeader header{
+            {'P', 'W', 'R', 'I'},
+            1,
+            sample_size,
+            0,
+            0,
+            sample_count_,
+            bin_samples,
+            max_power >> (2 * scale_shift),
+            max_iq >> scale_shift,
+            0};
+        while (power_index_bin_count(header, header.level_count) > 0)
+            header.level_count++;
+
+        auto result = f.write(&header, sizeof(header));
+        if (result.is_error())
+            return result.error();
+
+        for (size_t level = 0; level < header.level_count; level++) {
+            result = f.write(bins.data(), bins.size() * sizeof(PowerIndexBin));
+            if (result.is_error())
+                return result.error();
+
+            // Next level, merged in place.
+            const uint64_t width = uint64_t{bin_samples} << level;
+            const size_t count = bins.size();
+            for (size_t k = 0; k < count; k += 2) {
+                if (k + 1 == count) {
+                    bins[k / 2] = bins[k];
+                } else {
+                    const uint64_t last_width = std::min(width, sample_count_ - (k + 1) * width);
+                    bins[k / 2] = merge(bins[k], bins[k + 1], width, last_width);
+                }
+            }
+            bins.resize((count + 1) / 2);
+        }
+
+        return {};
+    }
+
+   private:
+    std::filesystem::path path;
+    uint8_t sample_size;
+    uint8_t scale_shift;
+    std::vector<PowerIndexBin> bins{};
+    uint32_t bin_samples{initial_bin_samples};
+    uint32_t bin_fill{0};
+    uint32_t bin_min{std::numeric_limits<uint32_t>::max()};
+    uint32_t bin_max{0};
+    uint64_t bin_sum{0};
+    uint32_t bin_taken{0};
+    uint64_t sample_count_{0};
+    uint32_t max_power{0};
+    uint32_t max_iq{0};
+
+    void accumulate(uint32_t p, uint32_t iq) {
+        bin_min = std::min(bin_min, p);
+        bin_max = std::max(bin_max, p);
+        bin_sum += p;
+        bin_taken++;
+        max_power = std::max(max_power, p);
+        max_iq = std::max(max_iq, iq);
+    }
+
+    void push_bin();
+    void close_bin();
+
+    static PowerIndexBin merge(const PowerIndexBin& a, const PowerIndexBin& b, uint64_t a_width, uint64_t b_width) {
+        return {
+            std::min(a.min, b.min),
+            std::max(a.max, b.max),
+            static_cast<uint32_t>((a.mean * a_width + b.mean * b_width) / (a_width + b_width))};
+    }
+};
+
+/* Indexes a baseband C16 buffer, then hands it to writer. The order
+ * matters: a C8 writer converts the buffer in place. index may be null. */
+File::Result<File::Size> write_indexed(
+    stream::Writer& writer,
+    PowerIndexBuilder* index,
+    const void* buffer,
+    File::Size bytes);
+
+/* Returns the header if f holds a power index. */
+template <typename F>
+Optional<PowerIndexHeader> read_power_index_header(F& f) {
+    PowerIndexHeader header{};
+    auto result = f.read(&header, sizeof(header));
+    if (result.is_error() || *result != sizeof(header) || !is_valid(header))
+        return {};
+
+    return header;
+}
+
+/* Calls on_bin(bin, first_sample) for each bin of a level.
+ * Returns false if the level couldn't be read in full. */
+template <typename F, typename Fn>
+bool read_power_index_level(F& f, const PowerIndexHeader& header, size_t level, Fn&& on_bin) {
+    if (level >= header.level_count)
+        return false;
+
+    File::Size offset = sizeof(PowerIndexHeader);
+    for (size_t l = 0; l < level; l++)
+        offset += power_index_bin_count(header, l) * sizeof(PowerIndexBin);
+
+    if (f.seek(offset).is_error())
+        return false;
+
+    const uint64_t width = uint64_t{header.bin_samples} << level;
+    const size_t count = power_index_bin_count(header, level);
+    PowerIndexBin chunk[16];
+    size_t index = 0;
+
+    while (index < count) {
+        const size_t n = std::min(count - index, std::size(chunk));
+        auto result = f.read(chunk, n * sizeof(PowerIndexBin));
+        if (result.is_error() || *result != n * sizeof(PowerIndexBin))
+            return false;
+
+        for (size_t k = 0; k < n; k++, index++)
+            on_bin(chunk[k], index * width);
+    }
+
+    return true;
+}
+
+}  // namespace iq
+
+#endif /*__IQ_POWER_INDEX_H__*/
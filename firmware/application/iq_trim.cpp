@@ -20,6 +20,7 @@
  */
 
 #include "iq_trim.hpp"
+#include "iq_power_index.hpp"
 
 #include <memory>
 #include "string_format.hpp"
@@ -28,19 +29,54 @@ namespace fs = std::filesystem;
 
 namespace iq {
 
-/* Trimming helpers based on the sample type (complex8 or complex16). */
-template <typename T>
-uint32_t power(T value) {
-    auto real = value.real();
-    auto imag = value.imag();
-    return (real * real) + (imag * imag);
-}
+/* Fills the buckets from the capture's power index, if it has an up to
+ * date one with enough resolution. */
+static Optional<CaptureInfo> profile_capture_index(
+    const std::filesystem::path& path,
+    PowerBuckets& buckets,
+    uint8_t sample_size) {
+    File::Size file_size = 0;
+    {
+        // One File at a time, they're large.
+        File capture;
+        if (capture.open(path))
+            return {};
+        file_size = capture.size();
+    }
 
-template <typename T>
-uint32_t iq_max(T value) {
-    auto real = abs(value.real());
-    auto imag = abs(value.imag());
-    return (real > imag) ? real : imag;
+    File f;
+    if (f.open(get_power_index_path(path)))
+        return {};
+
+    auto header = read_power_index_header(f);
+    if (!header)
+        return {};
+
+    CaptureInfo info{
+        .file_size = file_size,
+        .sample_count = file_size / sample_size,
+        .sample_size = sample_size,
+        .max_power = header->max_power,
+        .max_iq = header->max_iq};
+
+    // Stale (the capture was edited) or too coarse to fill every bucket.
+    if (header->sample_size != sample_size ||
+        header->sample_count != info.sample_count ||
+        power_index_bin_count(*header, 0) < buckets.size)
+        return {};
+
+    auto level = power_index_level_for(*header, buckets.size);
+    uint32_t bucket_width = std::max(1ULL, info.sample_count / buckets.size);
+    auto ok = read_power_index_level(f, *header, level, [&buckets, bucket_width](const PowerIndexBin& bin, uint64_t first_sample) {
+        buckets.add(first_sample / bucket_width, bin.mean);
+    });
+    if (!ok) {
+        for (size_t i = 0; i < buckets.size; i++)
+            buckets.p[i] = {};
+        return {};
+    }
+
+    return info;
 }
 
 /* Collects capture file metadata and sample power buckets. */
@@ -97,6 +133,12 @@ Optional<CaptureInfo> profile_capture(
     uint8_t samples_per_bucket) {
     auto sample_size = fs::capture_file_sample_size(path);
 
+    if (sample_size > 0) {
+        auto info = profile_capture_index(path, buckets, sample_size);
+        if (info)
+            return info;
+    }
+
     switch (sample_size) {
         case sizeof(complex16_t):
             return profile_capture<complex16_t>(path, buckets, samples_per_bucket);
@@ -198,6 +240,9 @@ bool trim_capture_with_range(
     auto src = std::make_unique<File>();
     auto dst = std::make_unique<File>();
 
+    // The copy passes every sample, so rebuild the power index on the way.
+    auto index = std::make_unique<PowerIndexBuilder>(get_power_index_path(path), sample_size);
+
     auto error = src->open(path);
     if (error) return false;
 
@@ -219,6 +264,11 @@ bool trim_capture_with_range(
         if (amplification > 1)
             amplify_iq_buffer(buffer, to_write, amplification, sample_size);
 
+        if (sample_size == sizeof(complex16_t))
+            index->add(reinterpret_cast<const complex16_t*>(buffer), to_write / sample_size);
+        else if (sample_size == sizeof(complex8_t))
+            index->add(reinterpret_cast<const complex8_t*>(buffer), to_write / sample_size);
+
         result = dst->write(buffer, to_write);
         if (result.is_error()) return false;
 
@@ -240,6 +290,7 @@ bool trim_capture_with_range(
     // Delete original and overwrite with temp file.
     delete_file(path);
     rename_file(temp_path, path);
+    index->write();
     return true;
 }
 
@@ -23,6 +23,7 @@
 #define __RECENT_ENTRIES_H__
 
 #include "ui_widget.hpp"
+#include "indexed_lru_list.hpp"
 
 #include <algorithm>
 #include <cstddef>
@@ -35,6 +36,10 @@
 template <class Entry>
 using RecentEntries = std::list<Entry>;
 
+/* Fixed capacity, O(1) lookup by key. For apps that see many distinct keys. */
+template <class Entry, size_t Capacity = 64>
+using IndexedRecentEntries = IndexedLRUList<Entry, Capacity>;
+
 template <typename ContainerType, typename Key>
 typename ContainerType::const_iterator find(const ContainerType& entries, const Key key) {
     return std::find_if(
@@ -49,6 +54,16 @@ typename ContainerType::iterator find(ContainerType& entries, const Key key) {
         [key](typename ContainerType::const_reference e) { return e.key() == key; });
 }
 
+template <typename Entry, size_t Capacity, typename Hash, typename Key>
+typename IndexedLRUList<Entry, Capacity, Hash>::const_iterator find(const IndexedLRUList<Entry, Capacity, Hash>& entries, const Key key) {
+    return entries.find(key);
+}
+
+template <typename Entry, size_t Capacity, typename Hash, typename Key>
+typename IndexedLRUList<Entry, Capacity, Hash>::iterator find(IndexedLRUList<Entry, Capacity, Hash>& entries, const Key key) {
+    return entries.find(key);
+}
+
 template <typename ContainerType>
 static void truncate_entries(ContainerType& entries, const size_t entries_max = 64) {
     while (entries.size() > entries_max) {
@@ -71,6 +86,19 @@ typename ContainerType::reference on_packet(ContainerType& entries, const Key ke
     return entries.front();
 }
 
+template <typename Entry, size_t Capacity, typename Hash, typename Key>
+Entry& on_packet(IndexedLRUList<Entry, Capacity, Hash>& entries, const Key key) {
+    auto matching_recent = entries.find(key);
+    if (matching_recent != std::end(entries)) {
+        entries.move_to_front(matching_recent);
+    } else {
+        // Evicts the least recently seen entry when full.
+        entries.emplace_front(key);
+    }
+
+    return entries.front();
+}
+
 template <typename ContainerType>
 static std::pair<typename ContainerType::const_iterator, typename ContainerType::const_iterator> range_around(
     const ContainerType& entries,
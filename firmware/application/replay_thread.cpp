@@ -80,48 +80,57 @@ uint32_t ReplayThread::run() {
         chThdSleep(100);
     };
 
-    constexpr size_t block_size = 512;
-
     // While empty buffers fifo is not empty...
+    // The baseband may have allocated more than buffer_count, fill them all.
     while (!buffers.empty()) {
         prefill_buffer = buffers.get_prefill();
 
         if (prefill_buffer == nullptr) {
             buffers.put_app(prefill_buffer);
         } else {
-            size_t blocks = config.read_size / block_size;
-
-            for (size_t c = 0; c < blocks; c++) {
-                auto read_result = reader->read(&((uint8_t*)prefill_buffer->data())[c * block_size], block_size);
-                if (read_result.is_error()) {
-                    return READ_ERROR;
-                }
+            auto read_result = read_buffer(prefill_buffer);
+            if (read_result.is_error()) {
+                return READ_ERROR;
             }
 
-            prefill_buffer->set_size(config.read_size);
-
             buffers.put(prefill_buffer);
         }
     };
 
     baseband::set_fifo_data(nullptr);
 
+    // Refill buffers as soon as the baseband hands them back. The whole pool
+    // is queued ahead of the baseband, so an SD card stall only shows up as
+    // an underrun once it outlasts every full buffer.
     while (!chThdShouldTerminate()) {
         auto buffer = buffers.get();
 
-        auto read_result = reader->read(buffer->data(), buffer->capacity());
+        auto read_result = read_buffer(buffer);
         if (read_result.is_error()) {
             return READ_ERROR;
         } else {
             if (read_result.value() == 0) {
+                // The last data buffer went in on the previous pass, it has
+                // to be visible to the baseband before the flag is.
+                __DMB();
+                config.end_of_stream = true;
                 return END_OF_FILE;
             }
         }
 
-        buffer->set_size(buffer->capacity());
-
         buffers.put(buffer);
     }
 
     return TERMINATED;
 }
+
+/* One read for the whole buffer. read_size is a multiple of the sector size,
+ * so FatFs transfers whole sectors straight into the buffer with multi-block
+ * reads instead of going through its sector cache. */
+File::Result<File::Size> ReplayThread::read_buffer(StreamBuffer* const buffer) {
+    auto read_result = reader->read(buffer->data(), buffer->capacity());
+    if (read_result.is_ok()) {
+        buffer->set_size(read_result.value());
+    }
+    return read_result;
+}
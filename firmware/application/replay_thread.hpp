@@ -69,6 +69,7 @@ class ReplayThread {
     static msg_t static_fn(void* arg);
 
     uint32_t run();
+    File::Result<File::Size> read_buffer(StreamBuffer* const buffer);
 };
 
 #endif /*__REPLAY_THREAD_H__*/
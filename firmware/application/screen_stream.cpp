@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "screen_stream.hpp"
+
+#include <algorithm>
+
+namespace screen_stream {
+
+namespace {
+
+void put_u16(uint8_t* p, const uint16_t value) {
+    p[0] = value & 0xff;
+    p[1] = value >> 8;
+}
+
+/* FNV-1a. */
+uint32_t hash_bytes(const uint8_t* p, const size_t length) {
+    uint32_t hash = 0x811c9dc5;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= p[i];
+        hash *= 0x01000193;
+    }
+    return hash;
+}
+
+}  // namespace
+
+Encoder::Encoder(const ui::Size screen_size)
+    : screen_size{screen_size},
+      columns{(screen_size.width() + tile_size - 1) / tile_size},
+      rows{(screen_size.height() + tile_size - 1) / tile_size},
+      hashes(columns * rows),
+      deflate{[this](const uint8_t* data, size_t length) { put_chunk(data, length); }} {
+}
+
+void Encoder::reset() {
+    hashes_valid = false;
+}
+
+void Encoder::put_chunk(const uint8_t* data, size_t length) {
+    uint8_t prefix[2];
+    put_u16(prefix, length);
+    (*frame_sink)(prefix, sizeof(prefix));
+    (*frame_sink)(data, length);
+}
+
+ui::Rect Encoder::tile_rect(const size_t index) const {
+    const ui::Coord x = (index % columns) * tile_size;
+    const ui::Coord y = (index / columns) * tile_size;
+    return {
+        x, y,
+        std::min<ui::Dim>(tile_size, screen_size.width() - x),
+        std::min<ui::Dim>(tile_size, screen_size.height() - y)};
+}
+
+size_t Encoder::encode_frame(const TileReader& read_tile, const Sink& sink) {
+    std::array<uint8_t, header_size> header{{frame_magic[0], frame_magic[1]}};
+    put_u16(&header[2], screen_size.width());
+    put_u16(&header[4], screen_size.height());
+    header[6] = tile_size;
+    sink(header.data(), header.size());
+
+    frame_sink = &sink;
+    size_t changed = 0;
+
+    for (size_t index = 0; index < hashes.size(); index++) {
+        const auto r = tile_rect(index);
+        const size_t count = r.width() * r.height();
+        read_tile(r, tile_rgb.data());
+
+        put_u16(&tile_data[0], index);
+        uint8_t* p = &tile_data[2];
+        for (size_t i = 0; i < count; i++) {
+            const auto& c = tile_rgb[i];
+            put_u16(p, ui::Color(c.r, c.g, c.b).v);
+            p += 2;
+        }
+
+        const size_t length = p - tile_data.data();
+        const auto hash = hash_bytes(&tile_data[2], length - 2);
+        if (hashes_valid && hash == hashes[index])
+            continue;
+        hashes[index] = hash;
+
+        // Started on the first changed tile, an idle frame is just the header.
+        if (changed == 0)
+            deflate.reset();
+        deflate.write(tile_data.data(), length);
+        changed++;
+    }
+    hashes_valid = true;
+
+    if (changed > 0)
+        deflate.finish();
+    frame_sink = nullptr;
+
+    const uint8_t end[2]{0, 0};
+    sink(end, sizeof(end));
+    return changed;
+}
+
+} /* namespace screen_stream */
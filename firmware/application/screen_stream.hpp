@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __SCREEN_STREAM_H__
+#define __SCREEN_STREAM_H__
+
+#include "deflate.hpp"
+#include "ui.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/* Binary screen stream for remote control over the serial shell.
+ *
+ * The screen is split into tiles and a hash is kept per tile, so a frame
+ * only carries the tiles that changed since the previous one. A frame is
+ *
+ *   'S' 'F', u16 width, u16 height, u8 tile_size     (header)
+ *   { u16 length, length bytes }...  u16 0           (chunks)
+ *
+ * with everything little endian. The chunks concatenate to a zlib stream,
+ * absent when nothing changed, which inflates to, per changed tile:
+ *
+ *   u16 tile index (row major), then the tile's RGB565 pixels
+ *
+ * Tiles on the right and bottom edges are clipped to the screen.
+ */
+namespace screen_stream {
+
+constexpr size_t tile_size = 16;
+constexpr std::array<uint8_t, 2> frame_magic{{'S', 'F'}};
+constexpr size_t header_size = 7;
+
+class Encoder {
+   public:
+    /* Fills pixels with the rectangle's pixels, row by row. */
+    using TileReader = std::function<void(ui::Rect r, ui::ColorRGB888* pixels)>;
+    /* Receives the encoded frame in pieces. */
+    using Sink = std::function<void(const uint8_t* data, size_t length)>;
+
+    Encoder(ui::Size screen_size);
+
+    Encoder(const Encoder&) = delete;
+    Encoder& operator=(const Encoder&) = delete;
+
+    /* The next frame carries every tile. */
+    void reset();
+
+    /* Encodes a frame holding the tiles changed since the previous one,
+     * returns how many there were. */
+    size_t encode_frame(const TileReader& read_tile, const Sink& sink);
+
+   private:
+    ui::Size screen_size;
+    size_t columns;
+    size_t rows;
+    std::vector<uint32_t> hashes{};
+    bool hashes_valid{false};
+
+    std::array<ui::ColorRGB888, tile_size * tile_size> tile_rgb{};
+    std::array<uint8_t, 2 + tile_size * tile_size * 2> tile_data{};
+
+    /* Reset per frame. Its output goes to the current frame's sink. */
+    const Sink* frame_sink{nullptr};
+    deflate::Encoder deflate;
+
+    void put_chunk(const uint8_t* data, size_t length);
+
+    ui::Rect tile_rect(size_t index) const;
+};
+
+} /* namespace screen_stream */
+
+#endif /*__SCREEN_STREAM_H__*/
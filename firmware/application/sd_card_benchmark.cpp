@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "sd_card_benchmark.hpp"
+
+#include "string_format.hpp"
+
+#include <algorithm>
+
+namespace sd_benchmark {
+
+/* LatencyHistogram ******************************************************/
+
+size_t LatencyHistogram::bucket_for(uint32_t us) {
+    if (us < sub_buckets)
+        return us;
+
+    const size_t msb = 31 - __builtin_clz(us);
+    const size_t octave = msb - sub_buckets_log2 + 1;
+    if (octave >= octaves)
+        return bucket_count - 1;
+
+    const size_t sub = (us >> (msb - sub_buckets_log2)) & (sub_buckets - 1);
+    return octave * sub_buckets + sub;
+}
+
+uint32_t LatencyHistogram::bucket_upper(size_t bucket) {
+    const size_t octave = bucket / sub_buckets;
+    const size_t sub = bucket % sub_buckets;
+    if (octave == 0)
+        return sub;
+
+    return ((sub_buckets + sub + 1) << (octave - 1)) - 1;
+}
+
+void LatencyHistogram::add(uint32_t us) {
+    buckets[bucket_for(us)]++;
+    count_++;
+    max_ = std::max(max_, us);
+    total_ += us;
+}
+
+uint32_t LatencyHistogram::percentile(uint32_t percent) const {
+    if (count_ == 0)
+        return 0;
+
+    const uint32_t rank = std::max<uint32_t>(1, (uint64_t{count_} * percent + 99) / 100);
+    uint32_t seen = 0;
+    for (size_t i = 0; i < bucket_count; i++) {
+        seen += buckets[i];
+        if (seen >= rank)
+            return (i == bucket_count - 1) ? max_ : std::min(bucket_upper(i), max_);
+    }
+
+    return max_;
+}
+
+/* Report ****************************************************************/
+
+static const char* operation_name(Operation operation) {
+    switch (operation) {
+        case Operation::Write:
+            return "write";
+        case Operation::Read:
+            return "read";
+        case Operation::Fill:
+            return "fill";
+    }
+    return "";
+}
+
+std::string csv_header() {
+    return "test,pattern,prealloc,io_size,offset_kb,ops,kbytes_per_s,p50_us,p99_us,max_us";
+}
+
+std::string csv_row(const Case& c, const LatencyHistogram& latency, uint64_t bytes, uint64_t duration_us) {
+    const uint64_t kbytes_per_s = duration_us ? bytes * 1000 / duration_us : 0;
+
+    return std::string{operation_name(c.operation)} + "," +
+           (c.pattern == Pattern::Random ? "random" : "sequential") + "," +
+           (c.preallocated ? "1" : "0") + "," +
+           to_string_dec_uint(c.io_size) + "," +
+           to_string_dec_uint(c.offset / 1024) + "," +
+           to_string_dec_uint(latency.count()) + "," +
+           to_string_dec_uint(kbytes_per_s) + "," +
+           to_string_dec_uint(latency.percentile(50)) + "," +
+           to_string_dec_uint(latency.percentile(99)) + "," +
+           to_string_dec_uint(latency.max());
+}
+
+/* Recommendation ********************************************************/
+
+CaptureRecommendation recommend_capture_buffers(
+    const WriteProfile* profiles,
+    size_t count,
+    uint32_t buffer_memory,
+    uint32_t buffer_count_max) {
+    CaptureRecommendation best{0, 0, 0};
+
+    for (size_t i = 0; i < count; i++) {
+        const auto& p = profiles[i];
+        if (p.write_size == 0 || p.bytes_per_second == 0)
+            continue;
+
+        // Keep a quarter of the card's rate spare for FAT updates and
+        // whatever else the card gets up to during a long capture.
+        const uint32_t sustained = p.bytes_per_second / 4 * 3;
+        const uint32_t max_latency_us = std::max<uint32_t>(p.max_latency_us, 1);
+        const uint32_t buffer_count_fit = std::min(buffer_memory / p.write_size, buffer_count_max);
+
+        for (uint32_t n = 2; n <= buffer_count_fit; n++) {
+            // Data arriving during the slowest write has to fit the other buffers.
+            const uint64_t absorbed = uint64_t{n - 1} * p.write_size * 1000000 / max_latency_us;
+            const uint32_t rate = std::min<uint64_t>(sustained, absorbed);
+
+            if (rate > best.bytes_per_second)
+                best = {p.write_size, n, rate};
+        }
+    }
+
+    return best;
+}
+
+} /* namespace sd_benchmark */
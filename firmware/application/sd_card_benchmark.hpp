@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __SD_CARD_BENCHMARK_H__
+#define __SD_CARD_BENCHMARK_H__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/* Bookkeeping for the SD card benchmark in the SD card debug view: latency
+ * histograms, the CSV report and the capture buffer recommendation. The I/O
+ * itself lives with the view. */
+namespace sd_benchmark {
+
+constexpr uint32_t min_io_size = 512;
+constexpr uint32_t max_io_size = 64 * 1024;
+
+/* Log-linear histogram of operation latencies in microseconds: each power of
+ * two is split in sub_buckets, so percentiles are within 1/sub_buckets. */
+class LatencyHistogram {
+   public:
+    static constexpr size_t sub_buckets_log2 = 2;
+    static constexpr size_t sub_buckets = 1U << sub_buckets_log2;
+    static constexpr size_t octaves = 25;  // Up to ~33s.
+    static constexpr size_t bucket_count = octaves * sub_buckets;
+
+    void add(uint32_t us);
+
+    uint32_t count() const { return count_; }
+    uint32_t max() const { return max_; }
+    uint64_t total() const { return total_; }
+
+    /* Upper bound of the bucket holding the percent-th percentile, clamped
+     * to the exact maximum. 0 when empty. */
+    uint32_t percentile(uint32_t percent) const;
+
+   private:
+    std::array<uint32_t, bucket_count> buckets{};
+    uint32_t count_{0};
+    uint32_t max_{0};
+    uint64_t total_{0};
+
+    static size_t bucket_for(uint32_t us);
+    static uint32_t bucket_upper(size_t bucket);
+};
+
+enum class Operation : uint8_t {
+    Write,
+    Read,
+    Fill,
+};
+
+enum class Pattern : uint8_t {
+    Sequential,
+    Random,
+};
+
+struct Case {
+    Operation operation;
+    Pattern pattern;
+    bool preallocated;
+    uint32_t io_size;
+    /* Where in the file the case started, for the fill runs. */
+    uint64_t offset;
+};
+
+std::string csv_header();
+
+/* bytes over duration_us is the rate while operations were running: the
+ * time between operations isn't counted. */
+std::string csv_row(const Case& c, const LatencyHistogram& latency, uint64_t bytes, uint64_t duration_us);
+
+/* Sequential write results for one write size. */
+struct WriteProfile {
+    uint32_t write_size;
+    uint32_t bytes_per_second;
+    uint32_t max_latency_us;
+};
+
+struct CaptureRecommendation {
+    uint32_t write_size;
+    uint32_t buffer_count;
+    /* The fastest capture (bytes/s into the file) these settings keep up with. */
+    uint32_t bytes_per_second;
+};
+
+/* Baseband RAM the capture buffers share (16 KiB x 3 in the Capture app) and
+ * the most buffers StreamInput takes. */
+constexpr uint32_t capture_buffer_memory = 16384 * 3;
+constexpr uint32_t capture_buffer_count_max = 8;
+
+/* Picks the CaptureThread write_size and buffer_count with the highest
+ * supported capture rate. While one buffer is being written the others have
+ * to absorb the slowest write seen, and the card has to keep up with some
+ * headroom on average. Returns all zeros without usable profiles. */
+CaptureRecommendation recommend_capture_buffers(
+    const WriteProfile* profiles,
+    size_t count,
+    uint32_t buffer_memory = capture_buffer_memory,
+    uint32_t buffer_count_max = capture_buffer_count_max);
+
+} /* namespace sd_benchmark */
+
+#endif /*__SD_CARD_BENCHMARK_H__*/
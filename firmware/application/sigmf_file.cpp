@@ -0,0 +1,403 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "sigmf_file.hpp"
+
+#include "convert.hpp"
+#include "metadata_file.hpp"
+#include "string_format.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstring>
+#include <type_traits>
+
+namespace fs = std::filesystem;
+using namespace std::literals;
+
+namespace sigmf {
+
+namespace {
+
+const fs::path c8_ext{u".C8"};
+const fs::path ciq_ext{u".CIQ"};
+
+std::string quoted(std::string_view s) {
+    std::string out{"\""};
+    for (auto c : s) {
+        if (c == '"' || c == '\\')
+            out += '\\';
+        out += c;
+    }
+    out += '"';
+    return out;
+}
+
+/* Just enough JSON to walk SigMF files: objects, arrays, strings without
+ * unicode escapes, numbers and literals. Reads the document through a small
+ * buffer, so its size doesn't matter. */
+class JsonReader {
+   public:
+    JsonReader(const Source& source)
+        : source{source} {
+    }
+
+    bool ok() const { return ok_; }
+
+    /* Calls fn(key) for each member, fn must consume the value. */
+    template <typename Fn>
+    void object(Fn&& fn) {
+        if (!expect('{'))
+            return;
+        if (peek() == '}') {
+            next();
+            return;
+        }
+        while (ok_) {
+            std::string key;
+            string(key);
+            if (!expect(':'))
+                return;
+            fn(std::string_view{key});
+            if (peek() == ',') {
+                next();
+                continue;
+            }
+            expect('}');
+            return;
+        }
+    }
+
+    /* Calls fn() for each element, fn must consume it. */
+    template <typename Fn>
+    void array(Fn&& fn) {
+        if (!expect('['))
+            return;
+        if (peek() == ']') {
+            next();
+            return;
+        }
+        while (ok_) {
+            fn();
+            if (peek() == ',') {
+                next();
+                continue;
+            }
+            expect(']');
+            return;
+        }
+    }
+
+    void string(std::string& out) {
+        out.clear();
+        if (!expect('"'))
+            return;
+        for (char c = current(); c != '"' && c != '\0'; c = current()) {
+            next();
+            if (c == '\\' && current() != '\0') {
+                c = current();
+                next();
+            }
+            out += c;
+        }
+        expect('"');
+    }
+
+    template <typename T>
+    void number(T& out) {
+        skip_ws();
+        std::array<char, 32> text;
+        size_t length = 0;
+        for (char c = current(); length < text.size() && (std::isdigit(static_cast<unsigned char>(c)) || c == '-' ||
+                                                           c == '+' || c == '.' || c == 'e' || c == 'E');
+             c = current()) {
+            text[length++] = c;
+            next();
+        }
+        if (length == 0 || length == text.size()) {
+            ok_ = false;
+            return;
+        }
+
+        if constexpr (std::is_integral_v<T>)
+            ok_ = parse_int(std::string_view{text.data(), length}, out);
+        else
+            ok_ = parse_float_meta(std::string_view{text.data(), length}, out);
+    }
+
+    void skip() {
+        switch (peek()) {
+            case '{':
+                object([this](std::string_view) { skip(); });
+                break;
+            case '[':
+                array([this]() { skip(); });
+                break;
+            case '"': {
+                std::string ignored;
+                string(ignored);
+            } break;
+            default:
+                // Numbers and true/false/null.
+                while (current() != '\0' && !std::strchr(",}] \t\r\n", current()))
+                    next();
+                break;
+        }
+    }
+
+   private:
+    const Source& source;
+    std::array<char, 128> buffer{};
+    size_t pos{0};
+    size_t end{0};
+    bool ok_{true};
+
+    /* The next character, '\0' at the end of the document. */
+    char current() {
+        if (pos == end) {
+            pos = 0;
+            end = source(buffer.data(), buffer.size());
+            if (end == 0)
+                return '\0';
+        }
+        return buffer[pos];
+    }
+
+    void next() {
+        pos++;
+    }
+
+    void skip_ws() {
+        while (std::isspace(static_cast<unsigned char>(current())))
+            next();
+    }
+
+    char peek() {
+        skip_ws();
+        return ok_ ? current() : '\0';
+    }
+
+    bool expect(char c) {
+        if (peek() != c)
+            ok_ = false;
+        else
+            next();
+        return ok_;
+    }
+};
+
+}  // namespace
+
+fs::path get_meta_path(const fs::path& capture_path) {
+    auto temp = capture_path;
+    return temp.replace_extension(u".sigmf-meta");
+}
+
+std::string_view datatype_for(const fs::path& capture_path) {
+    return path_iequal(capture_path.extension(), c8_ext) ? "ci8"sv : "ci16_le"sv;
+}
+
+std::string to_iso8601(const rtc::RTC& value) {
+    auto s = to_string_datetime(value, YMDHMS);
+    std::replace(s.begin(), s.end(), ' ', 'T');
+    return s + "Z";
+}
+
+void write_json(const Metadata& metadata, const Sink& sink) {
+    std::string json{"{\n  \"global\": {\n"};
+    json += "    \"core:version\": \"1.0.0\",\n";
+    json += "    \"core:recorder\": \"PortaPack Mayhem\",\n";
+    json += "    \"core:datatype\": " + quoted(metadata.datatype) + ",\n";
+    if (!metadata.dataset.empty())
+        json += "    \"core:dataset\": " + quoted(metadata.dataset) + ",\n";
+    if (!metadata.codec.empty()) {
+        // The samples can't be read without the codec, so it isn't optional.
+        json += "    \"core:extensions\": [{\"name\": \"portapack\", \"version\": \"1.0.0\", \"optional\": false}],\n";
+        json += "    \"portapack:codec\": " + quoted(metadata.codec) + ",\n";
+    }
+    if (metadata.latitude != 0 && metadata.longitude != 0 && metadata.latitude < 200 && metadata.longitude < 200) {
+        // GeoJSON orders coordinates longitude first.
+        json += "    \"core:geolocation\": {\"type\": \"Point\", \"coordinates\": [" +
+                to_string_decimal(metadata.longitude, 7) + ", " +
+                to_string_decimal(metadata.latitude, 7) + "]},\n";
+    }
+    json += "    \"core:sample_rate\": " + to_string_dec_uint(metadata.sample_rate) + "\n";
+    json += "  },\n  \"captures\": [\n    {\n";
+    json += "      \"core:sample_start\": 0,\n";
+    if (!metadata.datetime.empty())
+        json += "      \"core:datetime\": " + quoted(metadata.datetime) + ",\n";
+    json += "      \"core:frequency\": " + to_string_dec_uint(metadata.center_frequency) + "\n";
+    json += "    }\n  ],\n  \"annotations\": [";
+    sink(json);
+
+    bool first = true;
+    for (const auto& annotation : metadata.annotations) {
+        json = first ? "\n" : ",\n";
+        json += "    {\"core:sample_start\": " + to_string_dec_uint(annotation.sample_start) +
+                ", \"core:sample_count\": " + to_string_dec_uint(annotation.sample_count) +
+                ", \"core:label\": " + quoted(annotation.label) + "}";
+        sink(json);
+        first = false;
+    }
+    sink(first ? "]\n}\n" : "\n  ]\n}\n");
+}
+
+std::string to_json(const Metadata& metadata) {
+    std::string json;
+    write_json(metadata, [&json](std::string_view text) { json += text; });
+    return json;
+}
+
+Optional<Metadata> parse_json(const Source& source) {
+    Metadata metadata{};
+    JsonReader reader{source};
+    bool have_capture = false;
+
+    reader.object([&](std::string_view key) {
+        if (key == "global"sv) {
+            reader.object([&](std::string_view key) {
+                if (key == "core:datatype"sv)
+                    reader.string(metadata.datatype);
+                else if (key == "core:sample_rate"sv)
+                    reader.number(metadata.sample_rate);
+                else if (key == "core:dataset"sv)
+                    reader.string(metadata.dataset);
+                else if (key == "portapack:codec"sv)
+                    reader.string(metadata.codec);
+                else if (key == "core:geolocation"sv) {
+                    reader.object([&](std::string_view key) {
+                        if (key != "coordinates"sv) {
+                            reader.skip();
+                            return;
+                        }
+                        size_t index = 0;
+                        reader.array([&]() {
+                            if (index == 0)
+                                reader.number(metadata.longitude);
+                            else if (index == 1)
+                                reader.number(metadata.latitude);
+                            else
+                                reader.skip();
+                            index++;
+                        });
+                    });
+                } else
+                    reader.skip();
+            });
+        } else if (key == "captures"sv) {
+            // Only the first capture segment is used.
+            reader.array([&]() {
+                if (have_capture) {
+                    reader.skip();
+                    return;
+                }
+                have_capture = true;
+                reader.object([&](std::string_view key) {
+                    if (key == "core:frequency"sv)
+                        reader.number(metadata.center_frequency);
+                    else if (key == "core:datetime"sv)
+                        reader.string(metadata.datetime);
+                    else
+                        reader.skip();
+                });
+            });
+        } else if (key == "annotations"sv) {
+            reader.array([&]() {
+                Annotation annotation{};
+                reader.object([&](std::string_view key) {
+                    if (key == "core:sample_start"sv)
+                        reader.number(annotation.sample_start);
+                    else if (key == "core:sample_count"sv)
+                        reader.number(annotation.sample_count);
+                    else if (key == "core:label"sv)
+                        reader.string(annotation.label);
+                    else
+                        reader.skip();
+                });
+                if (metadata.annotations.size() < max_annotations)
+                    metadata.annotations.push_back(std::move(annotation));
+            });
+        } else {
+            reader.skip();
+        }
+    });
+
+    if (!reader.ok() || metadata.sample_rate == 0 || metadata.datatype.empty())
+        return {};  // Parse failed.
+
+    return metadata;
+}
+
+Optional<Metadata> parse_json(std::string_view json) {
+    size_t offset = 0;
+    return parse_json([&json, &offset](char* data, size_t length) {
+        const size_t n = std::min(length, json.size() - offset);
+        std::memcpy(data, &json[offset], n);
+        offset += n;
+        return n;
+    });
+}
+
+Optional<File::Error> write_meta_file(const fs::path& path, const Metadata& metadata) {
+    File f;
+    auto error = f.create(path);
+    if (error)
+        return error;
+
+    write_json(metadata, [&f, &error](std::string_view text) {
+        if (error)
+            return;
+        auto result = f.write(text.data(), text.size());
+        if (result.is_error())
+            error = result.error();
+    });
+    return error;
+}
+
+Optional<Metadata> read_meta_file(const fs::path& path) {
+    File f;
+    if (f.open(path))
+        return {};
+
+    // A read error cuts the document short, which fails the parse.
+    return parse_json([&f](char* data, size_t length) -> size_t {
+        auto result = f.read(data, length);
+        return result.is_ok() ? *result : 0;
+    });
+}
+
+void trim_annotations(Metadata& metadata, uint64_t start_sample, uint64_t end_sample) {
+    auto& annotations = metadata.annotations;
+    for (auto& annotation : annotations) {
+        const auto start = std::max(annotation.sample_start, start_sample);
+        const auto end = std::min(annotation.sample_start + annotation.sample_count, end_sample);
+        annotation.sample_start = start - start_sample;
+        annotation.sample_count = (end > start) ? (end - start) : 0;
+    }
+
+    annotations.erase(
+        std::remove_if(annotations.begin(), annotations.end(),
+                       [](const Annotation& annotation) { return annotation.sample_count == 0; }),
+        annotations.end());
+}
+
+}  // namespace sigmf
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __SIGMF_FILE_HPP__
+#define __SIGMF_FILE_HPP__
+
+#include "file.hpp"
+#include "optional.hpp"
+#include "rf_path.hpp"
+#include "lpc43xx_cpp.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/* SigMF (https://sigmf.org) metadata sidecars for IQ captures.
+ * The capture keeps its .C8/.C16/.CIQ name and is referenced as a
+ * non-conforming dataset through core:dataset. Only the fields written here
+ * are read back; anything else in the file is skipped. */
+namespace sigmf {
+
+/* Keeps a runaway squelch from eating the heap, about 10KB of them. The
+ * file is written and read in pieces, so any count round-trips. */
+constexpr size_t max_annotations = 256;
+
+struct Annotation {
+    uint64_t sample_start;
+    uint64_t sample_count;
+    std::string label;
+};
+
+struct Metadata {
+    std::string datatype{};  // "ci16_le" or "ci8".
+    uint32_t sample_rate{0};
+    rf::Frequency center_frequency{0};
+    std::string datetime{};  // ISO 8601, empty when unknown.
+    std::string dataset{};   // File name of the samples.
+    std::string codec{};     // "ciq" for compressed samples, empty for raw.
+    float latitude{0};
+    float longitude{0};
+    std::vector<Annotation> annotations{};
+};
+
+std::filesystem::path get_meta_path(const std::filesystem::path& capture_path);
+
+/* Datatype of the decoded samples of a capture file. */
+std::string_view datatype_for(const std::filesystem::path& capture_path);
+
+/* The RTC is taken to be running on UTC. */
+std::string to_iso8601(const lpc43xx::rtc::RTC& value);
+
+/* Receives the document in pieces, one per annotation. */
+using Sink = std::function<void(std::string_view text)>;
+/* Fills data with up to length bytes of the document, returns how many. */
+using Source = std::function<size_t(char* data, size_t length)>;
+
+void write_json(const Metadata& metadata, const Sink& sink);
+std::string to_json(const Metadata& metadata);
+
+Optional<Metadata> parse_json(const Source& source);
+Optional<Metadata> parse_json(std::string_view json);
+
+Optional<File::Error> write_meta_file(const std::filesystem::path& path, const Metadata& metadata);
+Optional<Metadata> read_meta_file(const std::filesystem::path& path);
+
+/* Rebases annotations onto a capture cut down to [start_sample, end_sample),
+ * clipping or dropping those outside. */
+void trim_annotations(Metadata& metadata, uint64_t start_sample, uint64_t end_sample);
+
+}  // namespace sigmf
+
+#endif  // __SIGMF_FILE_HPP__
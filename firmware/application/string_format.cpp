@@ -21,6 +21,9 @@
 
 #include "string_format.hpp"
 
+#include <algorithm>
+#include <cstring>
+
 using namespace std::literals;
 
 /* This takes a pointer to the end of a buffer
@@ -98,6 +101,80 @@ std::string to_string_dec_uint(uint64_t n) {
     return std::string(str, len);
 }
 
+size_t fmt_into(char* buffer, size_t size, std::string_view text) {
+    if (size == 0)
+        return 0;
+
+    const size_t length = std::min(text.length(), size - 1);
+    std::memcpy(buffer, text.data(), length);
+    buffer[length] = '\0';
+    return length;
+}
+
+static size_t fmt_into_number(char* buffer, size_t size, uint64_t magnitude, bool negative, int32_t width, char fill) {
+    StringFormatBuffer digits_buffer{};
+    size_t digits_length{};
+    const auto digits = to_string_dec_uint(magnitude, digits_buffer, digits_length);
+
+    // Sign, padding and digits, in the order they're written.
+    const int32_t padding = std::max<int32_t>(width - digits_length - (negative ? 1 : 0), 0);
+    const bool zero_fill = (fill == '0');
+    const std::string_view sign = negative ? "-"sv : ""sv;
+
+    size_t length = 0;
+    auto put = [&](std::string_view text) {
+        length += fmt_into(buffer + length, size - length, text);
+    };
+    auto pad = [&]() {
+        for (int32_t i = 0; i < padding && length + 1 < size; i++)
+            buffer[length++] = fill ? fill : ' ';
+        if (size)
+            buffer[length] = '\0';
+    };
+
+    if (zero_fill) {
+        put(sign);
+        pad();
+    } else {
+        pad();
+        put(sign);
+    }
+    put({digits, digits_length});
+    return length;
+}
+
+size_t fmt_into_dec_int(char* buffer, size_t size, int64_t n, int32_t width, char fill) {
+    const bool negative = n < 0;
+    return fmt_into_number(buffer, size, negative ? -static_cast<uint64_t>(n) : n, negative, width, fill);
+}
+
+size_t fmt_into_dec_uint(char* buffer, size_t size, uint64_t n, int32_t width, char fill) {
+    return fmt_into_number(buffer, size, n, false, width, fill);
+}
+
+size_t fmt_into_hex(char* buffer, size_t size, uint64_t n, int32_t length) {
+    if (size == 0)
+        return 0;
+
+    const size_t written = std::min<size_t>(std::max<int32_t>(length, 0), size - 1);
+    for (int32_t i = 0; i < length; i++) {
+        const size_t at = length - 1 - i;
+        if (at < written)
+            buffer[at] = uint_to_char(n & 0xF, 16);
+        n >>= 4;
+    }
+    buffer[written] = '\0';
+    return written;
+}
+
+// Same as to_string_short_freq.
+size_t fmt_into_short_freq(char* buffer, size_t size, uint64_t f) {
+    size_t length = fmt_into_dec_uint(buffer, size, (f + 50) / 1000000, 4);
+    length += fmt_into(buffer + length, size - length, ".");
+    length += fmt_into_dec_uint(buffer + length, size - length, ((f + 50) / 100) % 10000, 4, '0');
+    return length;
+}
+
 std::string to_string_bin(
     const uint32_t n,
     const uint8_t l) {
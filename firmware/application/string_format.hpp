@@ -50,6 +50,17 @@ char* to_string_dec_uint(uint64_t n, StringFormatBuffer& buffer, size_t& length)
 std::string to_string_dec_int(int64_t n);
 std::string to_string_dec_uint(uint64_t n);
 
+/* Formatting into a caller's buffer, for text rebuilt on every update.
+ * Each writes at most size - 1 characters plus a terminating NUL, cuts off
+ * what doesn't fit and returns the number of characters written.
+ * Numbers are right justified in width; with a '0' fill the sign goes
+ * before the zeros, with any other fill before the digits. */
+size_t fmt_into_dec_int(char* buffer, size_t size, int64_t n, int32_t width = 0, char fill = ' ');
+size_t fmt_into_dec_uint(char* buffer, size_t size, uint64_t n, int32_t width = 0, char fill = ' ');
+size_t fmt_into_hex(char* buffer, size_t size, uint64_t n, int32_t length);
+size_t fmt_into_short_freq(char* buffer, size_t size, uint64_t f);
+size_t fmt_into(char* buffer, size_t size, std::string_view text);
+
 std::string to_string_bin(const uint32_t n, const uint8_t l = 0);
 std::string to_string_dec_uint(const uint32_t n, const int32_t l, const char fill = ' ');
 std::string to_string_dec_int(const int32_t n, const int32_t l, const char fill = 0);
@@ -93,6 +104,63 @@ std::string trim(std::string_view str);   // Remove whitespace at ends.
 std::string trimr(std::string_view str);  // Remove trailing spaces
 std::string truncate(std::string_view, size_t length);
 
+/* A string of up to N characters held inline, built with the fmt_into
+ * functions without touching the heap. Appends past N are cut off.
+ * Converts to std::string_view, so it can be passed to Text::set(). */
+template <size_t N>
+class StaticString {
+   public:
+    StaticString() = default;
+    StaticString(std::string_view text) { append(text); }
+
+    size_t size() const { return length_; }
+    bool empty() const { return length_ == 0; }
+    static constexpr size_t capacity() { return N; }
+
+    const char* c_str() const { return data_.data(); }
+    operator std::string_view() const { return {data_.data(), length_}; }
+
+    StaticString& clear() {
+        length_ = 0;
+        data_[0] = '\0';
+        return *this;
+    }
+
+    StaticString& append(std::string_view text) {
+        length_ += fmt_into(tail(), room(), text);
+        return *this;
+    }
+
+    StaticString& operator+=(std::string_view text) { return append(text); }
+
+    StaticString& append_dec_int(int64_t n, int32_t width = 0, char fill = ' ') {
+        length_ += fmt_into_dec_int(tail(), room(), n, width, fill);
+        return *this;
+    }
+
+    StaticString& append_dec_uint(uint64_t n, int32_t width = 0, char fill = ' ') {
+        length_ += fmt_into_dec_uint(tail(), room(), n, width, fill);
+        return *this;
+    }
+
+    StaticString& append_hex(uint64_t n, int32_t length) {
+        length_ += fmt_into_hex(tail(), room(), n, length);
+        return *this;
+    }
+
+    StaticString& append_short_freq(uint64_t f) {
+        length_ += fmt_into_short_freq(tail(), room(), f);
+        return *this;
+    }
+
+   private:
+    std::array<char, N + 1> data_{};
+    size_t length_{0};
+
+    char* tail() { return &data_[length_]; }
+    size_t room() const { return N + 1 - length_; }
+};
+
 /* Gets the int value for a character given the radix.
  * e.g. '5' => 5, 'D' => 13. Out of bounds => 0. */
 uint8_t char_to_uint(char c, uint8_t radix = 10);
@@ -968,6 +968,7 @@ GeoMapView::GeoMapView(
     float lon,
     const std::function<void(int32_t, float, float, int32_t)> on_done)
     : nav_(nav),
+      on_done(on_done),
       altitude_(altitude),
       altitude_unit_(altitude_unit),
       speed_unit_(speed_unit),
@@ -986,10 +987,10 @@ GeoMapView::GeoMapView(
     geomap.move(lon_, lat_);
     geomap.set_focusable(true);
 
-    button_ok.on_select = [this, on_done, &nav](Button&) {
-        if (on_done)
-            on_done(altitude_, lat_, lon_, speed_);
-        nav.pop();
+    button_ok.on_select = [this](Button&) {
+        if (this->on_done)
+            this->on_done(altitude_, lat_, lon_, speed_);
+        nav_.pop();
     };
 }
 
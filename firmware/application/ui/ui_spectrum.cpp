@@ -256,6 +256,13 @@ bool FrequencyScale::on_touch(const TouchEvent touch) {
 // TODO: buffer and use "paint" instead of immediate drawing would help with
 // preventing flicker from drawing. Would use more RAM however.
 
+WaterfallWidget::WaterfallWidget()
+    : row{(size_t)screen_width} {
+    // Centre the row on DC, which the FFT puts in bin 0.
+    constexpr size_t bin_count = std::tuple_size<decltype(ChannelSpectrum::db)>::value;
+    row.set_span(bin_count - screen_width / 2, screen_width);
+}
+
 void WaterfallWidget::on_show() {
     clear();
 
@@ -275,17 +282,7 @@ void WaterfallWidget::on_hide() {
 
 void WaterfallWidget::on_channel_spectrum(
     const ChannelSpectrum& spectrum) {
-    /* TODO: static_assert that message.spectrum.db.size() >= pixel_row.size() */
-    std::vector<Color> pixel_row(screen_width);
-    for (size_t i = 0; i < screen_width / 2; i++) {
-        const auto pixel_color = gradient.lut[spectrum.db[256 - screen_width / 2 + i]];
-        pixel_row[i] = pixel_color;
-    }
-
-    for (size_t i = screen_width / 2; i < screen_width; i++) {
-        const auto pixel_color = gradient.lut[spectrum.db[i - screen_width / 2]];
-        pixel_row[i] = pixel_color;
-    }
+    const auto& pixel_row = row.render(spectrum.db.data(), spectrum.db.size(), gradient.lut);
     const auto draw_y = display.scroll(1);
     display.draw_pixels(
         {{0, draw_y}, {(int)pixel_row.size(), 1}},
@@ -26,6 +26,7 @@
 #include "ui.hpp"
 #include "ui_widget.hpp"
 #include "gradient.hpp"
+#include "waterfall_row.hpp"
 
 #include "event_m0.hpp"
 
@@ -120,9 +121,13 @@ class WaterfallWidget : public Widget {
     void paint(Painter&) override {}
     bool on_touch(const TouchEvent event) override;
 
+    WaterfallWidget();
+
     void on_channel_spectrum(const ChannelSpectrum& spectrum);
 
    private:
+    WaterfallRow row;
+
     void clear();
 };
 
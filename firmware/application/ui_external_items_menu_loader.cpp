@@ -3,6 +3,7 @@
 #include "sd_card.hpp"
 #include "file_path.hpp"
 #include "ui_standalone_view.hpp"
+#include "view_arena.hpp"
 
 #include "i2cdevmanager.hpp"
 #include "i2cdev_ppmod.hpp"
@@ -98,6 +99,10 @@ namespace ui {
 }
 
 /* static */ std::vector<ExternalItemsMenuLoader::GridItemEx> ExternalItemsMenuLoader::load_external_items(app_location_t app_location, NavigationView& nav) {
+    // bitmaps outlives the menu asking for it, so it must not end up in the
+    // arena of a view under construction and pin it after the view is popped.
+    ViewArena::Scope main_heap{nullptr};
+
     bitmaps.clear();
 
     std::vector<GridItemEx> external_apps;
@@ -164,7 +164,7 @@ bool NavigationView::StartAppByName(const char* name) {
 
     auto it = appMap.find(name);
     if (it != appMap.end()) {
-        push_view(std::unique_ptr<View>(it->second.viewFactory->produce(*this)));
+        push_view(*it->second.viewFactory);
         return true;
     }
 
@@ -626,15 +626,29 @@ bool NavigationView::is_valid() const {
     return view_stack.size() != 0;  // work around to check if nav is valid, not elegant i know. so TODO
 }
 
-View* NavigationView::push_view(std::unique_ptr<View> new_view) {
+View* NavigationView::push_view(std::unique_ptr<View> new_view, ViewArena arena) {
+    // The stack itself must not end up in the arena of a view that is still
+    // being constructed (a view pushing a modal from its constructor).
+    ViewArena::Scope main_heap{nullptr};
+
     free_view();
     const auto p = new_view.get();
-    view_stack.emplace_back(ViewState{std::move(new_view), {}});
+    view_stack.emplace_back(ViewState{std::move(arena), std::move(new_view), {}});
 
     update_view();
     return p;
 }
 
+View* NavigationView::push_view(const ViewFactoryBase& factory) {
+    auto arena = ViewArena::create(factory.view_size());
+    std::unique_ptr<View> new_view;
+    {
+        ViewArena::Scope scope{&arena};
+        new_view = factory.produce(*this);
+    }
+    return push_view(std::move(new_view), std::move(arena));
+}
+
 void NavigationView::pop(bool trigger_update) {
     // Don't pop off the NavView.
     if (view_stack.size() <= 1)
@@ -770,7 +784,7 @@ void add_apps(NavigationView& nav, BtnGridView& grid, app_location_t loc) {
             grid.add_item({app.displayName, app.iconColor, app.icon,
                            [&nav, &app]() {
                             i2cdev::I2CDevManager::set_autoscan_interval(0); //if i navigate away from any menu, turn off autoscan
-                            nav.push_view(std::unique_ptr<View>(app.viewFactory->produce(nav))); }},
+                            nav.push_view(*app.viewFactory); }},
                           true);
         }
     };
@@ -51,6 +51,7 @@
 #include "sd_card.hpp"
 #include "external_app.hpp"
 #include "view_factory.hpp"
+#include "view_arena.hpp"
 #include "battery.hpp"
 
 // for incrementing fake date when RTC battery is dead
@@ -106,19 +107,27 @@ class NavigationView : public View {
     bool is_top() const;
     bool is_valid() const;
 
+    /* Views are constructed inside an arena of their own, see ViewArena. */
     template <class T, class... Args>
     T* push(Args&&... args) {
-        return reinterpret_cast<T*>(push_view(std::unique_ptr<View>(new T(*this, std::forward<Args>(args)...))));
+        auto arena = ViewArena::create(sizeof(T));
+        std::unique_ptr<View> new_view;
+        {
+            ViewArena::Scope scope{&arena};
+            new_view.reset(new T(*this, std::forward<Args>(args)...));
+        }
+        return reinterpret_cast<T*>(push_view(std::move(new_view), std::move(arena)));
     }
 
     template <class T, class... Args>
     T* replace(Args&&... args) {
         pop();
-        return reinterpret_cast<T*>(push_view(std::unique_ptr<View>(new T(*this, std::forward<Args>(args)...))));
+        return push<T>(std::forward<Args>(args)...);
     }
 
     void push(View* v);
-    View* push_view(std::unique_ptr<View> new_view);
+    View* push_view(std::unique_ptr<View> new_view, ViewArena arena = {});
+    View* push_view(const ViewFactoryBase& factory);
     void replace(View* v);
     void pop(bool trigger_update = true);
     void home(bool trigger_update);
@@ -149,6 +158,8 @@ class NavigationView : public View {
 
    private:
     struct ViewState {
+        /* Declared first so it outlives the view allocated in it. */
+        ViewArena arena;
         std::unique_ptr<View> view;
         std::function<void()> on_pop;
     };
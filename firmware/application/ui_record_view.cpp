@@ -29,12 +29,17 @@ using namespace portapack;
 #include "io_convert.hpp"
 
 #include "baseband_api.hpp"
+#include "iq_codec.hpp"
+#include "lfsr_random.hpp"
 #include "metadata_file.hpp"
 #include "oversample.hpp"
+#include "sigmf_file.hpp"
 #include "rtc_time.hpp"
 #include "string_format.hpp"
 #include "utility.hpp"
 
+#include "hal.h"
+
 #include <cstdint>
 #include <vector>
 
@@ -110,14 +115,6 @@ uint32_t RecordView::set_sampling_rate(uint32_t new_sampling_rate) {
     auto oversample_rate = get_oversample_rate(new_sampling_rate);
     auto actual_sampling_rate = new_sampling_rate * toUType(oversample_rate);
 
-    // Change the "REC" icon background to yellow when the selected rate exceeds hardware limits.
-    // Above this threshold, samples will be dropped resulting incomplete capture files.
-    if (new_sampling_rate > 1'250'000) {
-        button_record.set_background(Theme::getInstance()->fg_yellow->foreground);
-    } else {
-        button_record.set_background(Theme::getInstance()->fg_yellow->background);
-    }
-
     if (sampling_rate != new_sampling_rate) {
         stop();
 
@@ -132,10 +129,28 @@ uint32_t RecordView::set_sampling_rate(uint32_t new_sampling_rate) {
 
         update_status_display();
     }
+    update_record_background();
 
     return actual_sampling_rate;
 }
 
+void RecordView::set_file_type(const FileType v) {
+    file_type = v;
+    update_record_background();
+}
+
+void RecordView::update_record_background() {
+    // Change the "REC" icon background to yellow when the selected rate exceeds hardware limits,
+    // or what the CIQ encoder keeps up with. Above these, samples will be dropped resulting
+    // incomplete capture files.
+    if (sampling_rate > 1'250'000 ||
+        (file_type == FileType::CompressedS16 && sampling_rate > ciq_max_sampling_rate())) {
+        button_record.set_background(Theme::getInstance()->fg_yellow->foreground);
+    } else {
+        button_record.set_background(Theme::getInstance()->fg_yellow->background);
+    }
+}
+
 OversampleRate RecordView::get_oversample_rate(uint32_t sample_rate) {
     // No oversampling necessary for baseband audio processors.
     if (file_type == FileType::WAV)
@@ -176,6 +191,9 @@ void RecordView::start() {
     text_record_filename.set("");
     text_record_dropped.set("");
     trim_path = "";
+    capture_path = "";
+    metadata_path = "";
+    sigmf_path = "";
 
     if (sampling_rate == 0) {
         return;
@@ -218,8 +236,9 @@ void RecordView::start() {
     switch (file_type) {
         case FileType::WAV: {
             auto p = std::make_unique<WAVFileWriter>();
+            capture_path = base_path.replace_extension(u".WAV");
             auto create_error = p->create(
-                base_path.replace_extension(u".WAV"),
+                capture_path,
                 sampling_rate,
                 to_string_dec_uint(receiver_model.target_frequency()) + "Hz");
             if (create_error.is_valid()) {
@@ -230,21 +249,28 @@ void RecordView::start() {
         } break;
 
         case FileType::RawS8:
-        case FileType::RawS16: {
+        case FileType::RawS16:
+        case FileType::CompressedS16: {
+            metadata_path = get_metadata_path(base_path);
             const auto metadata_file_error = write_metadata_file(
-                get_metadata_path(base_path), {receiver_model.target_frequency(), sampling_rate, latitude, longitude, satinuse});
+                metadata_path, {receiver_model.target_frequency(), sampling_rate, latitude, longitude, satinuse});
             if (metadata_file_error.is_valid()) {
                 handle_error(metadata_file_error.value());
                 return;
             }
 
             auto p = std::make_unique<FileConvertWriter>();
-            trim_path = base_path.replace_extension((file_type == FileType::RawS8) ? u".C8" : u".C16");
-            auto create_error = p->create(trim_path);
+            capture_path = base_path.replace_extension(
+                (file_type == FileType::RawS8) ? u".C8" : (file_type == FileType::CompressedS16) ? u".CIQ"
+                                                                                                : u".C16");
+            if (file_type != FileType::CompressedS16)
+                trim_path = capture_path;
+            auto create_error = p->create(capture_path, preallocate_size());
             if (create_error.is_valid()) {
                 handle_error(create_error.value());
             } else {
                 writer = std::move(p);
+                start_sigmf();
             }
         } break;
 
@@ -252,12 +278,21 @@ void RecordView::start() {
             break;
     };
 
+    // Lets IQ trim profile the capture without reading it all back.
+    std::unique_ptr<iq::PowerIndexBuilder> power_index;
+    if (writer && !trim_path.empty()) {
+        power_index = std::make_unique<iq::PowerIndexBuilder>(
+            iq::get_power_index_path(capture_path),
+            (file_type == FileType::RawS8) ? sizeof(complex8_t) : sizeof(complex16_t),
+            (file_type == FileType::RawS8) ? 8 : 0);
+    }
+
     if (writer) {
         text_record_filename.set(truncate(base_path.filename().string(), 8));
         button_record.set_bitmap(&bitmap_stop);
         capture_thread = std::make_unique<CaptureThread>(
             std::move(writer),
-            write_size, buffer_count,
+            capture_write_size(), capture_buffer_count(),
             []() {
                 CaptureThreadDoneMessage message{};
                 EventDispatcher::send_message(message);
@@ -265,7 +300,9 @@ void RecordView::start() {
             [](File::Error error) {
                 CaptureThreadDoneMessage message{error.code()};
                 EventDispatcher::send_message(message);
-            });
+            },
+            capture_trigger(),
+            std::move(power_index));
     }
 
     update_status_display();
@@ -278,18 +315,91 @@ void RecordView::on_hide() {
 
 void RecordView::stop() {
     if (is_active()) {
+        const bool triggered = capture_thread->state().baseband_bytes_received > 0;
+        drain_annotations(true);
         capture_thread.reset();
         button_record.set_bitmap(&bitmap_record);
-        trim_capture();
+
+        if (is_triggered() && !triggered) {
+            // Still armed, nothing worth keeping.
+            delete_file(capture_path);
+            if (!metadata_path.empty())
+                delete_file(metadata_path);
+            if (!sigmf_path.empty())
+                delete_file(sigmf_path);
+            if (!trim_path.empty())
+                delete_file(iq::get_power_index_path(trim_path));
+            trim_path = "";
+        } else {
+            trim_capture();
+            if (!sigmf_path.empty())
+                sigmf::write_meta_file(sigmf_path, sigmf_metadata);
+        }
+        sigmf_path = "";
+        sigmf_metadata.annotations.clear();
     }
 
     update_status_display();
 }
 
 void RecordView::on_tick_second() {
+    drain_annotations(false);
     update_status_display();
 }
 
+void RecordView::start_sigmf() {
+    sigmf_path = sigmf::get_meta_path(capture_path);
+    rtc_time::now(datetime);
+
+    sigmf_metadata = {};
+    sigmf_metadata.datatype = std::string{sigmf::datatype_for(capture_path)};
+    sigmf_metadata.sample_rate = sampling_rate;
+    sigmf_metadata.center_frequency = receiver_model.target_frequency();
+    sigmf_metadata.datetime = sigmf::to_iso8601(datetime);
+    sigmf_metadata.dataset = capture_path.filename().string();
+    sigmf_metadata.codec = (file_type == FileType::CompressedS16) ? "ciq" : "";
+    sigmf_metadata.latitude = latitude;
+    sigmf_metadata.longitude = longitude;
+    annotation_read_index = 0;
+
+    // Written now so the capture has metadata even if it never stops cleanly.
+    sigmf::write_meta_file(sigmf_path, sigmf_metadata);
+}
+
+void RecordView::drain_annotations(bool closing) {
+    if (!capture_thread || sigmf_path.empty())
+        return;
+
+    // The baseband always streams C16, whatever ends up in the file.
+    constexpr uint64_t bytes_per_sample = sizeof(complex16_t);
+    const auto& state = capture_thread->state();
+    const auto& annotations = state.annotations;
+
+    auto add = [this](uint64_t start, uint64_t end) {
+        if (sigmf_metadata.annotations.size() < sigmf::max_annotations && end > start) {
+            sigmf_metadata.annotations.push_back({start / bytes_per_sample,
+                                                  (end - start) / bytes_per_sample,
+                                                  "signal"});
+        }
+    };
+
+    const uint32_t write_index = annotations.write_index;
+    __DMB();
+    if (write_index - annotation_read_index > CaptureAnnotations::capacity) {
+        // Fell behind, the oldest events were overwritten.
+        annotation_read_index = write_index - CaptureAnnotations::capacity;
+    }
+    for (; annotation_read_index != write_index; annotation_read_index++) {
+        const auto& event = annotations.events[annotation_read_index % CaptureAnnotations::capacity];
+        add(event.start, event.end);
+    }
+
+    // A signal still present at the end runs to the end of the capture.
+    if (closing && annotations.active) {
+        add(annotations.active_start, state.baseband_bytes_received - state.baseband_bytes_dropped);
+    }
+}
+
 void RecordView::update_status_display() {
     if (is_active()) {
         const auto dropped_percent = std::min(99U, capture_thread->state().dropped_percent());
@@ -308,6 +418,7 @@ void RecordView::update_status_display() {
         // - Audio is 1 int16_t per sample or '2' bytes per sample.
         // - C8 captures 2 (I,Q) int8_t per sample or '2' bytes per sample.
         // - C16 captures 2 (I,Q) int16_t per sample or '4' bytes per sample.
+        // - CIQ compresses C16, assume about half on a typical noise floor.
         const auto bytes_per_sample = file_type == FileType::RawS16 ? 4 : 2;
         const uint32_t bytes_per_second = sampling_rate * bytes_per_sample;
         const uint32_t available_seconds = space_info.free / bytes_per_second;
@@ -323,6 +434,96 @@ void RecordView::update_status_display() {
     }
 }
 
+void RecordView::set_trigger(CaptureTrigger::Source source, int8_t squelch_db, uint32_t pre_ms, uint32_t post_ms) {
+    stop();
+    trigger_source = source;
+    trigger_squelch_db = squelch_db;
+    pre_trigger_ms = pre_ms;
+    post_trigger_ms = post_ms;
+}
+
+void RecordView::set_external_trigger(bool active) {
+    if (capture_thread)
+        capture_thread->set_external_trigger(active);
+}
+
+// Triggered captures use twice as many half sized buffers (same baseband
+// RAM), giving the pre-trigger ring a finer granularity.
+size_t RecordView::capture_write_size() const {
+    return is_triggered() ? write_size / 2 : write_size;
+}
+
+size_t RecordView::capture_buffer_count() const {
+    return is_triggered() ? buffer_count * 2 : buffer_count;
+}
+
+// The baseband streams C16 for raw captures (converted here), s16 audio for WAV.
+uint64_t RecordView::stream_bytes_per_second() const {
+    return uint64_t{sampling_rate} * (file_type == FileType::WAV ? 2 : 4);
+}
+
+uint32_t RecordView::pre_trigger_max_ms() const {
+    const auto bytes_per_second = stream_bytes_per_second();
+    if (bytes_per_second == 0)
+        return 0;
+
+    const uint64_t held_bytes = uint64_t{buffer_count * 2 - 1} * (write_size / 2);
+    return held_bytes * 1000 / bytes_per_second;
+}
+
+uint32_t RecordView::ciq_max_sampling_rate() {
+    static uint32_t max_sampling_rate = 0;
+    if (max_sampling_rate != 0)
+        return max_sampling_rate;
+
+    constexpr size_t blocks = 4;
+    auto samples = std::make_unique<complex16_t[]>(iq_codec::block_samples);
+    auto encoded = std::make_unique<uint8_t[]>(iq_codec::max_block_bytes);
+
+    // Noise floor samples, +-32, what most of a capture holds and what CIQ is for.
+    lfsr_word_t v = 1;
+    for (size_t i = 0; i < iq_codec::block_samples; i++) {
+        v = lfsr_iterate(v);
+        samples[i] = {int16_t((v & 0x3f) - 0x20), int16_t(((v >> 16) & 0x3f) - 0x20)};
+    }
+
+    const auto start = halGetCounterValue();
+    for (size_t i = 0; i < blocks; i++)
+        iq_codec::encode_block(samples.get(), iq_codec::block_samples, encoded.get());
+    const halrtcnt_t ticks = std::max<halrtcnt_t>(halGetCounterValue() - start, 1);
+
+    const uint64_t samples_per_second = uint64_t(blocks * iq_codec::block_samples) * halGetCounterFrequency() / ticks;
+    max_sampling_rate = std::max<uint64_t>(samples_per_second / 2, 1);
+    return max_sampling_rate;
+}
+
+CaptureTrigger RecordView::capture_trigger() const {
+    CaptureTrigger trigger{};
+    trigger.squelch_db = trigger_squelch_db;
+    // IQ captures mark where the signals are in their SigMF sidecar.
+    trigger.annotate = file_type != FileType::WAV;
+    const auto bytes_per_second = stream_bytes_per_second();
+    trigger.release_bytes = bytes_per_second * CaptureTrigger::release_ms / 1000;
+    if (!is_triggered())
+        return trigger;
+
+    trigger.source = trigger_source;
+    trigger.pre_trigger_bytes = bytes_per_second * std::min(pre_trigger_ms, pre_trigger_max_ms()) / 1000;
+    trigger.post_trigger_bytes = bytes_per_second * post_trigger_ms / 1000;
+    return trigger;
+}
+
+File::Size RecordView::preallocate_size() const {
+    if (preallocate_seconds == 0)
+        return 0;
+
+    // Leave room for other files, the unused part is freed on stop anyway.
+    const auto space_info = std::filesystem::space(u"");
+    const File::Size bytes_per_sample = file_type == FileType::RawS16 ? 4 : 2;
+    const File::Size size = File::Size{sampling_rate} * bytes_per_sample * preallocate_seconds;
+    return std::min<File::Size>(size, space_info.free / 2);
+}
+
 void RecordView::trim_capture() {
     using bucket_t = iq::PowerBuckets::Bucket;
 
@@ -342,7 +543,8 @@ void RecordView::trim_capture() {
             auto trim_range = iq::compute_trim_range(*info, power_buckets, 7);
 
             trim_ui.show_trimming();
-            iq::trim_capture_with_range(trim_path, trim_range, trim_ui.get_callback(), 1);
+            if (iq::trim_capture_with_range(trim_path, trim_range, trim_ui.get_callback(), 1))
+                sigmf::trim_annotations(sigmf_metadata, trim_range.start_sample, trim_range.end_sample);
         }
 
         trim_ui.clear();
@@ -360,9 +562,14 @@ void RecordView::on_gps(const GPSPosDataMessage* msg) {
 }
 
 void RecordView::handle_capture_thread_done(const File::Error error) {
+    // A finished burst rather than the user pressing stop.
+    const bool rearm = is_active() && capture_thread->state().trigger.done;
     stop();
     if (error.code()) {
         handle_error(error);
+    } else if (rearm) {
+        // Burst written, arm for the next one.
+        start();
     }
 }
 
@@ -28,6 +28,7 @@
 #include "bitmap.hpp"
 #include "capture_thread.hpp"
 #include "iq_trim.hpp"
+#include "sigmf_file.hpp"
 #include "signal.hpp"
 
 #include <cstddef>
@@ -44,6 +45,7 @@ class RecordView : public View {
         RawS8 = 1,
         RawS16 = 2,
         WAV = 3,
+        CompressedS16 = 4,
     };
 
     RecordView(
@@ -63,9 +65,32 @@ class RecordView : public View {
      * that can be used to configure the radio or other UI element. */
     uint32_t set_sampling_rate(uint32_t new_sampling_rate);
 
-    void set_file_type(const FileType v) { file_type = v; }
+    void set_file_type(const FileType v);
     void set_auto_trim(bool v) { auto_trim = v; }
 
+    /* Raw captures reserve a contiguous file extent for this many seconds
+     * up front (0 disables), so FAT updates can't stall the writer. */
+    void set_preallocate_seconds(uint32_t v) { preallocate_seconds = v; }
+
+    /* With a trigger source set, start() arms the capture instead: the
+     * baseband keeps the last pre_ms of samples and writes from there until
+     * post_ms after the trigger drops, then the next capture is armed.
+     * pre_ms is clamped to pre_trigger_max_ms(). */
+    void set_trigger(CaptureTrigger::Source source, int8_t squelch_db, uint32_t pre_ms, uint32_t post_ms);
+    /* Drives CaptureTrigger::Source::External while a capture is armed. */
+    void set_external_trigger(bool active);
+
+    /* The pre-trigger window is held in the baseband's stream buffers, all
+     * but the one being filled: (2 * buffer_count - 1) * write_size / 2 bytes.
+     * That is about 20ms at 500k C16 with the Capture app's 48KB. */
+    uint32_t pre_trigger_max_ms() const;
+
+    /* Highest sampling rate CIQ captures keep up with. Measured once by
+     * timing the encoder on noise floor samples, leaving half the M0 for the
+     * SD card and the UI. Above it the REC icon turns yellow, and what the
+     * encoder can't keep up with shows as dropped samples. */
+    static uint32_t ciq_max_sampling_rate();
+
     void start();
     void stop();
     void on_hide() override;
@@ -81,7 +106,16 @@ class RecordView : public View {
 
     void on_tick_second();
     void update_status_display();
+    void update_record_background();
     void trim_capture();
+    void start_sigmf();
+    void drain_annotations(bool closing);
+    File::Size preallocate_size() const;
+    bool is_triggered() const { return trigger_source != CaptureTrigger::Source::None; }
+    size_t capture_write_size() const;
+    size_t capture_buffer_count() const;
+    uint64_t stream_bytes_per_second() const;
+    CaptureTrigger capture_trigger() const;
 
     void handle_capture_thread_done(const File::Error error);
     void handle_error(const File::Error error);
@@ -109,9 +143,21 @@ class RecordView : public View {
     SignalToken signal_token_tick_second{};
 
     bool auto_trim = false;
+    uint32_t preallocate_seconds = 0;
     std::filesystem::path trim_path{};
     TrimProgressUI trim_ui{};
 
+    CaptureTrigger::Source trigger_source{CaptureTrigger::Source::None};
+    int8_t trigger_squelch_db{-40};
+    uint32_t pre_trigger_ms{0};
+    uint32_t post_trigger_ms{0};
+    std::filesystem::path capture_path{};
+    std::filesystem::path metadata_path{};
+
+    std::filesystem::path sigmf_path{};
+    sigmf::Metadata sigmf_metadata{};
+    uint32_t annotation_read_index{0};
+
     Rectangle rect_background{
         Theme::getInstance()->bg_darkest->background};
 
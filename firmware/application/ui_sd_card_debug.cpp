@@ -24,7 +24,10 @@
 #include "string_format.hpp"
 
 #include "file.hpp"
+#include "file_path.hpp"
 #include "lfsr_random.hpp"
+#include "rtc_time.hpp"
+#include "sd_card_benchmark.hpp"
 
 #include "ff.h"
 #include "diskio.h"
@@ -32,6 +35,8 @@
 #include "ch.h"
 #include "hal.h"
 
+#include <memory>
+
 class SDCardTestThread {
    public:
     enum Result {
@@ -236,6 +241,291 @@ class SDCardTestThread {
 
 Thread* SDCardTestThread::thread{nullptr};
 
+/* Sweeps I/O sizes, sequential vs random and with or without a preallocated
+ * file, then writes a long file in segments. Every case goes to a CSV report
+ * in LOGS. */
+class SDCardBenchmarkThread {
+   public:
+    enum Result {
+        FailIO = -4,
+        FailReport = -3,
+        FailHeap = -2,
+        FailAbort = -1,
+        Incomplete = 0,
+        OK = 1,
+    };
+
+    /* Sequential results for one I/O size, no preallocation. */
+    struct SizeStats {
+        uint32_t p50_us{0};
+        uint32_t p99_us{0};
+        uint32_t max_us{0};
+        uint32_t bytes_per_second{0};
+    };
+
+    static constexpr size_t size_count = 8;  // 512 B to 64 KiB.
+    static_assert((sd_benchmark::min_io_size << (size_count - 1)) == sd_benchmark::max_io_size, "size_count must cover min_io_size to max_io_size");
+
+    struct Summary {
+        std::array<SizeStats, size_count> write{};
+        std::array<SizeStats, size_count> read{};
+        sd_benchmark::CaptureRecommendation recommendation{};
+        sd_benchmark::CaptureRecommendation recommendation_preallocated{};
+        std::filesystem::path report_path{};
+    };
+
+    SDCardBenchmarkThread() {
+        thread = chThdCreateFromHeap(NULL, 3072, NORMALPRIO + 10, SDCardBenchmarkThread::static_fn, this);
+    }
+
+    ~SDCardBenchmarkThread() {
+        chThdTerminate(thread);
+        chThdWait(thread);
+    }
+
+    Result result() const {
+        return _result;
+    }
+
+    /* 0-100, for the UI. */
+    uint8_t progress() const {
+        return _progress;
+    }
+
+    const Summary& summary() const {
+        return _summary;
+    }
+
+    static std::string result_str(Result result) {
+        switch (result) {
+            case FailIO:
+                return "I/O error";
+            case FailReport:
+                return "Report file";
+            case FailHeap:
+                return "Heap";
+            case FailAbort:
+                return "Abort";
+            default:
+                return "";
+        }
+    }
+
+   private:
+    static constexpr File::Size case_bytes = 1024 * 1024;
+    static constexpr File::Size fill_bytes = 128 * 1024 * 1024;
+    static constexpr File::Size fill_segment_bytes = 8 * 1024 * 1024;
+    static constexpr uint32_t fill_io_size = 16384;
+    static constexpr size_t cases_per_size = 4;
+    static constexpr size_t steps = 2 * size_count * cases_per_size + fill_bytes / fill_segment_bytes;
+
+    Thread* thread{nullptr};
+    volatile Result _result{Result::Incomplete};
+    volatile uint8_t _progress{0};
+    size_t step{0};
+    Summary _summary{};
+    sd_benchmark::LatencyHistogram latency{};
+    uint8_t* buffer{nullptr};
+    uint32_t buffer_size{0};
+    lfsr_word_t v{1};
+
+    static msg_t static_fn(void* arg) {
+        auto obj = static_cast<SDCardBenchmarkThread*>(arg);
+        obj->_result = obj->run();
+        if (obj->buffer)
+            chHeapFree(obj->buffer);
+        return 0;
+    }
+
+    /* The counter wraps after ~21s at 204MHz, so whole cases and segments
+     * are summed from per-operation deltas in 64 bits. */
+    static uint32_t ticks_to_us(uint64_t ticks) {
+        return ticks * 1000000U / halGetCounterFrequency();
+    }
+
+    void next_step() {
+        step++;
+        _progress = std::min<size_t>(100, 100 * step / steps);
+    }
+
+    Result run() {
+        using namespace sd_benchmark;
+        const std::filesystem::path filename{u"_PPBENCH.DAT"};
+        // Declared before any File, so the scratch file is closed by the
+        // time this removes it, on every way out.
+        struct ScratchFile {
+            const std::filesystem::path& path;
+            ~ScratchFile() { delete_file(path); }
+        } scratch{filename};
+
+        // Sizes past what the heap can give are left out of the report.
+        for (buffer_size = max_io_size; buffer_size >= min_io_size; buffer_size /= 2) {
+            buffer = static_cast<uint8_t*>(chHeapAlloc(0x0, buffer_size));
+            if (buffer)
+                break;
+        }
+        if (!buffer)
+            return Result::FailHeap;
+
+        ensure_directory(logs_dir);
+        _summary.report_path = next_filename_matching_pattern(logs_dir / u"SDBENCH_????.CSV");
+        if (_summary.report_path.empty())
+            return Result::FailReport;
+
+        File report;
+        if (report.create(_summary.report_path).is_valid() ||
+            report.write_line(csv_header()).is_valid())
+            return Result::FailReport;
+
+        std::array<WriteProfile, size_count> profiles{};
+        std::array<WriteProfile, size_count> profiles_preallocated{};
+
+        for (const bool preallocated : {false, true}) {
+            for (size_t i = 0; i < size_count; i++) {
+                const uint32_t io_size = min_io_size << i;
+                if (io_size > buffer_size) {
+                    step += cases_per_size;
+                    continue;
+                }
+
+                File file;
+                if (file.create(filename).is_valid())
+                    return Result::FailIO;
+                if (preallocated && file.expand(case_bytes).is_valid())
+                    return Result::FailIO;
+
+                for (const auto operation : {Operation::Write, Operation::Read}) {
+                    for (const auto pattern : {Pattern::Sequential, Pattern::Random}) {
+                        if (chThdShouldTerminate())
+                            return Result::FailAbort;
+
+                        const Case c{operation, pattern, preallocated, io_size, 0};
+                        const auto duration_us = run_case(file, c);
+                        if (!duration_us)
+                            return Result::FailIO;
+                        if (report.write_line(csv_row(c, latency, case_bytes, duration_us)).is_valid())
+                            return Result::FailReport;
+
+                        if (pattern == Pattern::Sequential) {
+                            const uint32_t bytes_per_second = case_bytes * 1000000 / duration_us;
+                            if (operation == Operation::Write) {
+                                auto& profile = preallocated ? profiles_preallocated[i] : profiles[i];
+                                profile = {io_size, bytes_per_second, latency.max()};
+                            }
+                            if (!preallocated) {
+                                auto& stats = (operation == Operation::Write) ? _summary.write[i] : _summary.read[i];
+                                stats = {latency.percentile(50), latency.percentile(99), latency.max(), bytes_per_second};
+                            }
+                        }
+                        next_step();
+                    }
+                }
+
+                file.close();
+                delete_file(filename);
+            }
+        }
+
+        _summary.recommendation = recommend_capture_buffers(profiles.data(), profiles.size());
+        _summary.recommendation_preallocated = recommend_capture_buffers(profiles_preallocated.data(), profiles_preallocated.size());
+
+        const auto fill_result = run_fill(filename, report);
+        if (fill_result != Result::OK)
+            return fill_result;
+
+        // Recommendations as comments, so the table still loads as CSV.
+        for (const bool preallocated : {false, true}) {
+            const auto& r = preallocated ? _summary.recommendation_preallocated : _summary.recommendation;
+            report.write_line(
+                std::string{"# recommend"} + (preallocated ? " preallocated" : "") +
+                ": write_size=" + to_string_dec_uint(r.write_size) +
+                " buffer_count=" + to_string_dec_uint(r.buffer_count) +
+                " max_kbytes_per_s=" + to_string_dec_uint(r.bytes_per_second / 1000));
+        }
+
+        return Result::OK;
+    }
+
+    /* Runs one case over case_bytes of the file and fills latency.
+     * Returns the time spent in its operations in us, 0 on error. */
+    uint32_t run_case(File& file, const sd_benchmark::Case& c) {
+        const uint32_t op_count = case_bytes / c.io_size;
+        latency = {};
+
+        if (c.operation == sd_benchmark::Operation::Write)
+            lfsr_fill(v, reinterpret_cast<lfsr_word_t*>(buffer), c.io_size / sizeof(lfsr_word_t));
+
+        uint64_t case_ticks = 0;
+        for (uint32_t n = 0; n < op_count; n++) {
+            const uint32_t index = (c.pattern == sd_benchmark::Pattern::Random)
+                                       ? (v = lfsr_iterate(v)) % op_count
+                                       : n;
+
+            const halrtcnt_t op_start = halGetCounterValue();
+            if (file.seek(uint64_t{index} * c.io_size).is_error())
+                return 0;
+
+            const auto result = (c.operation == sd_benchmark::Operation::Write)
+                                    ? file.write(buffer, c.io_size)
+                                    : file.read(buffer, c.io_size);
+            if (result.is_error() || *result != c.io_size)
+                return 0;
+
+            const halrtcnt_t op_ticks = halGetCounterValue() - op_start;
+            case_ticks += op_ticks;
+            latency.add(ticks_to_us(op_ticks));
+        }
+
+        if (c.operation == sd_benchmark::Operation::Write) {
+            const halrtcnt_t sync_start = halGetCounterValue();
+            file.sync();
+            case_ticks += halGetCounterValue() - sync_start;
+        }
+
+        return std::max<uint32_t>(1, ticks_to_us(case_ticks));
+    }
+
+    /* A long sequential write, reported per segment to show how the card
+     * copes as the file grows (FAT chain walks, card garbage collection). */
+    Result run_fill(const std::filesystem::path& filename, File& report) {
+        const uint32_t io_size = std::min(fill_io_size, buffer_size);
+        const auto space = std::filesystem::space(u"");
+        const File::Size bytes = std::min<File::Size>(fill_bytes, space.free / 2);
+
+        File file;
+        if (file.create(filename).is_valid())
+            return Result::FailIO;
+
+        lfsr_fill(v, reinterpret_cast<lfsr_word_t*>(buffer), io_size / sizeof(lfsr_word_t));
+
+        for (File::Size offset = 0; offset + fill_segment_bytes <= bytes; offset += fill_segment_bytes) {
+            if (chThdShouldTerminate())
+                return Result::FailAbort;
+
+            latency = {};
+            uint64_t segment_ticks = 0;
+            for (File::Size written = 0; written < fill_segment_bytes; written += io_size) {
+                const halrtcnt_t op_start = halGetCounterValue();
+                const auto result = file.write(buffer, io_size);
+                if (result.is_error() || *result != io_size)
+                    return Result::FailIO;
+
+                const halrtcnt_t op_ticks = halGetCounterValue() - op_start;
+                segment_ticks += op_ticks;
+                latency.add(ticks_to_us(op_ticks));
+            }
+            const uint32_t duration_us = std::max<uint32_t>(1, ticks_to_us(segment_ticks));
+
+            const sd_benchmark::Case c{sd_benchmark::Operation::Fill, sd_benchmark::Pattern::Sequential, false, io_size, offset};
+            if (report.write_line(csv_row(c, latency, fill_segment_bytes, duration_us)).is_valid())
+                return Result::FailReport;
+            next_step();
+        }
+
+        return Result::OK;
+    }
+};
+
 namespace ui {
 
 SDCardDebugView::SDCardDebugView(NavigationView& nav) {
@@ -259,12 +549,24 @@ SDCardDebugView::SDCardDebugView(NavigationView& nav) {
         &text_test_read_time_value,
         &text_test_read_rate_title,
         &text_test_read_rate_value,
+        &text_bench_recommendation,
+        &text_bench_status,
         &button_test,
+        &button_bench,
         &button_ok,
     });
 
     button_test.on_select = [this](Button&) { this->on_test(); };
+    button_bench.on_select = [this](Button&) { this->on_bench(); };
     button_ok.on_select = [&nav](Button&) { nav.pop(); };
+
+    signal_token_tick_second = rtc_time::signal_tick_second += [this]() {
+        this->on_tick_second();
+    };
+}
+
+SDCardDebugView::~SDCardDebugView() {
+    rtc_time::signal_tick_second -= signal_token_tick_second;
 }
 
 void SDCardDebugView::on_show() {
@@ -276,6 +578,7 @@ void SDCardDebugView::on_show() {
 
 void SDCardDebugView::on_hide() {
     sd_card::status_signal -= sd_card_status_signal_token;
+    bench_thread.reset();
 }
 
 void SDCardDebugView::focus() {
@@ -399,6 +702,9 @@ static std::string format_bytes_per_ticks_as_mib(const File::Size bytes, const h
 }
 
 void SDCardDebugView::on_test() {
+    if (bench_thread)
+        return;
+
     text_test_write_time_value.set("");
     text_test_write_rate_value.set("");
     text_test_read_time_value.set("");
@@ -450,6 +756,67 @@ void SDCardDebugView::on_test() {
     }
 }
 
+void SDCardDebugView::on_bench() {
+    if (bench_thread)
+        return;
+
+    text_test_write_time_value.set("");
+    text_test_write_rate_value.set("");
+    text_test_read_time_value.set("");
+    text_test_read_rate_value.set("");
+    text_bench_recommendation.set("");
+    text_bench_status.set("Benchmark 0%");
+
+    bench_thread = std::make_unique<SDCardBenchmarkThread>();
+}
+
+void SDCardDebugView::on_tick_second() {
+    if (!bench_thread)
+        return;
+
+    const auto result = bench_thread->result();
+    if (result == SDCardBenchmarkThread::Result::Incomplete) {
+        text_bench_status.set("Benchmark " + to_string_dec_uint(bench_thread->progress()) + "%");
+        return;
+    }
+
+    if (result == SDCardBenchmarkThread::Result::OK) {
+        const auto& summary = bench_thread->summary();
+        // The Capture app preallocates its files, fall back if that failed.
+        const auto& r = (summary.recommendation_preallocated.write_size != 0) ? summary.recommendation_preallocated
+                                                                               : summary.recommendation;
+
+        if (r.write_size == 0) {
+            text_bench_recommendation.set("No usable write results");
+        } else {
+            // Capture app samples are C16, 4 bytes each.
+            text_bench_recommendation.set(
+                "Capture " + to_string_dec_uint(r.write_size) + "x" + to_string_dec_uint(r.buffer_count) +
+                " to " + to_string_dec_uint(r.bytes_per_second / 4000) + "kS/s");
+
+            // Details for the recommended write size.
+            size_t i = 0;
+            while ((sd_benchmark::min_io_size << i) < r.write_size)
+                i++;
+
+            auto format_stats = [](const SDCardBenchmarkThread::SizeStats& stats) {
+                return format_3dot3_string(stats.p50_us) + "/" +
+                       format_3dot3_string(stats.p99_us) + "/" +
+                       format_3dot3_string(stats.max_us);
+            };
+            text_test_write_time_value.set(format_stats(summary.write[i]));
+            text_test_write_rate_value.set(format_3dot3_string(summary.write[i].bytes_per_second / 1000));
+            text_test_read_time_value.set(format_stats(summary.read[i]));
+            text_test_read_rate_value.set(format_3dot3_string(summary.read[i].bytes_per_second / 1000));
+        }
+        text_bench_status.set("p50/99/max " + summary.report_path.filename().string());
+    } else {
+        text_bench_status.set("Fail: " + SDCardBenchmarkThread::result_str(result));
+    }
+
+    bench_thread.reset();
+}
+
 std::string SDCardDebugView::fetch_sdcard_format() {
     const size_t max_len = sizeof("Undefined: 255") + 1;
 
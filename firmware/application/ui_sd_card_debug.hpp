@@ -27,11 +27,16 @@
 
 #include "sd_card.hpp"
 
+#include <memory>
+
+class SDCardBenchmarkThread;
+
 namespace ui {
 
 class SDCardDebugView : public View {
    public:
     SDCardDebugView(NavigationView& nav);
+    ~SDCardDebugView();
 
     void on_show() override;
     void on_hide() override;
@@ -42,9 +47,13 @@ class SDCardDebugView : public View {
 
    private:
     SignalToken sd_card_status_signal_token{};
+    SignalToken signal_token_tick_second{};
+    std::unique_ptr<SDCardBenchmarkThread> bench_thread{};
 
     void on_status(const sd_card::Status status);
     void on_test();
+    void on_bench();
+    void on_tick_second();
     std::string fetch_sdcard_format();
 
     Labels labels{
@@ -173,12 +182,29 @@ class SDCardDebugView : public View {
 
     ///////////////////////////////////////////////////////////////////////
 
+    /* Benchmark: recommended capture buffers, then progress and report. */
+    Text text_bench_recommendation{
+        {0, 11 * 16, screen_width, 16},
+        "",
+    };
+
+    Text text_bench_status{
+        {0, 16 * 16, screen_width, 16},
+        "",
+    };
+
+    ///////////////////////////////////////////////////////////////////////
+
     Button button_test{
-        {16, 17 * 16, 96, 24},
+        {8, 17 * 16, 72, 24},
         "Test"};
 
+    Button button_bench{
+        {(screen_width - 72) / 2, 17 * 16, 72, 24},
+        "Bench"};
+
     Button button_ok{
-        {screen_width - 96 - 16, 17 * 16, 96, 24},
+        {screen_width - 72 - 8, 17 * 16, 72, 24},
         "OK"};
 };
 
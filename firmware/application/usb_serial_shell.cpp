@@ -25,6 +25,7 @@
 #include "core_control.hpp"
 #include "bitmap.hpp"
 #include "png_writer.hpp"
+#include "screen_stream.hpp"
 #include "irq_controls.hpp"
 
 #include "portapack.hpp"
@@ -52,6 +53,7 @@
 
 #include "portapack_persistent_memory.hpp"
 
+#include <memory>
 #include <string>
 #include <cstring>
 #include <libopencm3/lpc43xx/wwdt.h>
@@ -259,6 +261,51 @@ static void cmd_screenframeshort(BaseSequentialStream* chp, int argc, char* argv
     chprintf(chp, "\r\nok\r\n");
 }
 
+// binary frames with only the tiles changed since the previous frame, compressed. format in screen_stream.hpp
+// the encoder (~10KB) only lives for the command, so the first frame of each command has the whole screen.
+static void cmd_screenstream(BaseSequentialStream* chp, int argc, char* argv[]) {
+    const char* usage = "usage: screenstream [frames]\r\n";
+    if (argc > 1) {
+        chprintf(chp, usage);
+        return;
+    }
+
+    int frames = 1;
+    if (argc == 1) {
+        // every command starts from the whole screen, kept for older viewers.
+        if (strcmp(argv[0], "reset") == 0) {
+            chprintf(chp, "ok\r\n");
+            return;
+        }
+        frames = (int)strtol(argv[0], NULL, 10);
+        if (frames < 1 || frames > 1000) {
+            chprintf(chp, usage);
+            return;
+        }
+    }
+
+    auto evtd = getEventDispatcherInstance();
+    auto oqueue = &((SerialUSBDriver*)chp)->oqueue;
+    auto encoder = std::make_unique<screen_stream::Encoder>(ui::Size{ui::screen_width, ui::screen_height});
+
+    // stop early if the viewer went away, the encoder is freed on return either way.
+    for (int i = 0; i < frames && portapack::usb_serial.serial_connected(); i++) {
+        // one frame per paint, and the ui keeps running in between.
+        evtd->wait_finish_frame();
+        evtd->enter_shell_working_mode();
+        encoder->encode_frame(
+            [](ui::Rect r, ui::ColorRGB888* pixels) {
+                portapack::display.read_pixels(r, pixels, r.width() * r.height());
+            },
+            [oqueue](const uint8_t* data, size_t length) {
+                fillOBuffer(oqueue, data, length);
+            });
+        evtd->exit_shell_working_mode();
+    }
+
+    chprintf(chp, "ok\r\n");
+}
+
 static void cmd_write_memory(BaseSequentialStream* chp, int argc, char* argv[]) {
     if (argc != 2) {
         chprintf(chp, "usage: write_memory <address> <value (1 or 4 bytes)>\r\n");
@@ -1392,6 +1439,7 @@ static const ShellCommand commands[] = {
     {"screenshot", cmd_screenshot},
     {"screenframe", cmd_screenframe},
     {"screenframeshort", cmd_screenframeshort},
+    {"screenstream", cmd_screenstream},
     {"write_memory", cmd_write_memory},
     {"read_memory", cmd_read_memory},
     {"button", cmd_button},
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "view_arena.hpp"
+
+#include "chibios_cpp.hpp"
+
+#include <ch.h>
+
+namespace ui {
+
+struct ViewArena::Header {
+    MemoryHeap heap;
+    size_t capacity;
+    Header* next_orphan;
+};
+
+ViewArena::Header* ViewArena::orphans = nullptr;
+
+bool ViewArena::is_unused(Header* const header) {
+    /* Freed blocks coalesce, so an unused heap is a single free fragment. */
+    size_t free_size = 0;
+    return (chHeapStatus(&header->heap, &free_size) == 1) && (free_size == header->capacity);
+}
+
+ViewArena ViewArena::create(const size_t view_size) {
+    collect();
+
+    const size_t header_size = MEM_ALIGN_NEXT(sizeof(Header));
+    const size_t arena_size = MEM_ALIGN_NEXT(view_size + slack_size);
+
+    /* Straight from the main heap, whatever heap is selected right now. */
+    const auto block = chHeapAlloc(nullptr, header_size + arena_size);
+    if (!block)
+        return {};
+
+    const auto header = static_cast<Header*>(block);
+    chHeapInit(&header->heap, static_cast<uint8_t*>(block) + header_size, arena_size);
+    header->capacity = 0;
+    chHeapStatus(&header->heap, &header->capacity);
+    header->next_orphan = nullptr;
+    return ViewArena{header};
+}
+
+void ViewArena::collect() {
+    auto link = &orphans;
+    while (*link) {
+        const auto header = *link;
+        if (is_unused(header)) {
+            *link = header->next_orphan;
+            chHeapFree(header);
+        } else {
+            link = &header->next_orphan;
+        }
+    }
+}
+
+ViewArena::~ViewArena() {
+    release();
+    collect();
+}
+
+ViewArena::ViewArena(ViewArena&& other)
+    : header{other.header} {
+    other.header = nullptr;
+}
+
+ViewArena& ViewArena::operator=(ViewArena&& other) {
+    if (this != &other) {
+        release();
+        header = other.header;
+        other.header = nullptr;
+    }
+    return *this;
+}
+
+void ViewArena::release() {
+    if (!header)
+        return;
+
+    if (is_unused(header)) {
+        chHeapFree(header);
+    } else {
+        header->next_orphan = orphans;
+        orphans = header;
+    }
+    header = nullptr;
+}
+
+ViewArena::Scope::Scope(ViewArena* arena)
+    : previous{chibios::select_heap((arena && arena->header) ? &arena->header->heap : nullptr)} {
+}
+
+ViewArena::Scope::~Scope() {
+    chibios::select_heap(previous);
+}
+
+} /* namespace ui */
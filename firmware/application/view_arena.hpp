@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __VIEW_ARENA_H__
+#define __VIEW_ARENA_H__
+
+#include <cstddef>
+
+struct memory_heap;
+
+namespace ui {
+
+/* A heap of its own for a view pushed on the NavigationView, carved out of
+ * the main heap as one contiguous block. While a Scope is active, whatever
+ * the UI thread allocates (the view object, its widgets' strings, vectors
+ * and handlers) lands in the block instead of being scattered across the
+ * main heap, and the block is handed back in one piece once the view is
+ * gone. Allocations that don't fit fall through to the main heap.
+ *
+ * The block is only released when everything in it has been freed. If
+ * something allocated in the arena outlives the view, the block is kept
+ * and released on a later push or pop once that allocation is gone too.
+ */
+class ViewArena {
+   public:
+    /* Room for the view's own allocations on top of the view object. */
+    static constexpr size_t slack_size = 2048;
+
+    /* An arena sized for a view of view_size bytes. The result is empty
+     * (and the view is allocated as usual) if the main heap has no free
+     * block that large. */
+    static ViewArena create(const size_t view_size);
+
+    /* Releases blocks of popped views that have since become unused. */
+    static void collect();
+
+    ViewArena() = default;
+    ~ViewArena();
+
+    ViewArena(const ViewArena&) = delete;
+    ViewArena& operator=(const ViewArena&) = delete;
+    ViewArena(ViewArena&& other);
+    ViewArena& operator=(ViewArena&& other);
+
+    explicit operator bool() const {
+        return header != nullptr;
+    }
+
+    /* Routes the calling thread's allocations to arena for the lifetime of
+     * the scope. A null or empty arena selects the main heap. */
+    class Scope {
+       public:
+        explicit Scope(ViewArena* arena);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+       private:
+        memory_heap* previous;
+    };
+
+   private:
+    struct Header;
+
+    /* Blocks of popped views that still had live allocations in them. */
+    static Header* orphans;
+
+    Header* header{nullptr};
+
+    explicit ViewArena(Header* header)
+        : header{header} {}
+
+    static bool is_unused(Header* const header);
+
+    void release();
+};
+
+} /* namespace ui */
+
+#endif /*__VIEW_ARENA_H__*/
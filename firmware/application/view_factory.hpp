@@ -32,6 +32,10 @@ class ViewFactory : public ViewFactoryBase {
     virtual std::unique_ptr<View> produce(NavigationView& nav) const override {
         return std::unique_ptr<View>(new T(nav));
     }
+
+    virtual size_t view_size() const override {
+        return sizeof(T);
+    }
 };
 
 }  // namespace ui
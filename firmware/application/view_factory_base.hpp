@@ -33,6 +33,7 @@ class ViewFactoryBase {
    public:
     virtual ~ViewFactoryBase();
     virtual std::unique_ptr<View> produce(NavigationView& nav) const = 0;
+    virtual size_t view_size() const = 0;
 };
 
 }  // namespace ui
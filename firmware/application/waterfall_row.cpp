@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "waterfall_row.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+WaterfallRow::WaterfallRow(size_t width)
+    : power(width),
+      row(width),
+      span_{width} {
+}
+
+void WaterfallRow::set_span(size_t first, size_t span) {
+    first_ = first;
+    span_ = std::max<size_t>(span, 1);
+}
+
+const std::vector<ui::Color>& WaterfallRow::render(const uint8_t* bins, size_t count, const LUT& lut) {
+    if (count == 0)
+        return row;
+
+    map_bins(bins, count);
+    map_colors(lut);
+    return row;
+}
+
+void WaterfallRow::map_bins(const uint8_t* bins, size_t count) {
+    const size_t width = power.size();
+    size_t bin = first_ % count;
+
+    if (span_ == width) {
+        // Straight copy, in up to count sized pieces as the span wraps.
+        for (size_t x = 0; x < width;) {
+            const size_t n = std::min(width - x, count - bin);
+            std::memcpy(&power[x], &bins[bin], n);
+            x += n;
+            bin = 0;
+        }
+    } else if (span_ > width) {
+        // Pixel x covers bins [x * span / width, (x + 1) * span / width).
+        size_t error = 0;
+        for (size_t x = 0; x < width; x++) {
+            uint8_t peak = 0;
+            error += span_;
+            for (; error >= width; error -= width) {
+                peak = std::max(peak, bins[bin]);
+                if (++bin == count)
+                    bin = 0;
+            }
+            power[x] = peak;
+        }
+    } else {
+        // Pixel x shows bin x * span / width.
+        size_t error = 0;
+        for (size_t x = 0; x < width; x++) {
+            power[x] = bins[bin];
+            for (error += span_; error >= width; error -= width) {
+                if (++bin == count)
+                    bin = 0;
+            }
+        }
+    }
+}
+
+void WaterfallRow::map_colors(const LUT& lut) {
+    const size_t width = power.size();
+    const uint8_t* src = power.data();
+    ui::Color* dst = row.data();
+
+    // Four bins per load, little endian.
+    size_t x = 0;
+    for (; x + 4 <= width; x += 4) {
+        uint32_t w;
+        std::memcpy(&w, &src[x], sizeof(w));
+        dst[x + 0] = lut[w & 0xff];
+        dst[x + 1] = lut[(w >> 8) & 0xff];
+        dst[x + 2] = lut[(w >> 16) & 0xff];
+        dst[x + 3] = lut[w >> 24];
+    }
+    for (; x < width; x++)
+        dst[x] = lut[src[x]];
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __WATERFALL_ROW_H__
+#define __WATERFALL_ROW_H__
+
+#include "ui.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/* Turns a frame of power bins into a row of waterfall pixels.
+ * The row buffers are allocated once, so drawing a frame doesn't touch the
+ * heap. A span of bins is spread across the row: one bin per pixel when they
+ * match, the strongest bin under each pixel when there are more bins than
+ * pixels (max-hold, so narrow carriers don't vanish), repeated bins when
+ * there are fewer.
+ */
+class WaterfallRow {
+   public:
+    using LUT = std::array<ui::Color, 256>;
+
+    explicit WaterfallRow(size_t width);
+
+    size_t width() const { return row.size(); }
+
+    /* Bins first to first + span - 1 (modulo the bin count) fill the row.
+     * The default span is the row width starting at bin 0. */
+    void set_span(size_t first, size_t span);
+
+    const std::vector<ui::Color>& render(const uint8_t* bins, size_t count, const LUT& lut);
+
+   private:
+    std::vector<uint8_t> power;
+    std::vector<ui::Color> row;
+    size_t first_{0};
+    size_t span_;
+
+    void map_bins(const uint8_t* bins, size_t count);
+    void map_colors(const LUT& lut);
+};
+
+#endif /*__WATERFALL_ROW_H__*/
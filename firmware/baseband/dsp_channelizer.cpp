@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "dsp_channelizer.hpp"
+
+#include "dsp_fft.hpp"
+#include "utility.hpp"
+
+#include <cmath>
+
+namespace dsp {
+namespace channelizer {
+
+void PolyphaseChannelizer::configure(const float cutoff_normalized) {
+    constexpr float center = (taps_count - 1) / 2.0f;
+
+    std::array<float, taps_count> h{};
+    float sum = 0.0f;
+    for (size_t i = 0; i < taps_count; i++) {
+        const float t = i - center;
+        const float x = 2.0f * pi * cutoff_normalized * t;
+        const float sinc = (t == 0.0f) ? 1.0f : (std::sin(x) / x);
+        const float window = 0.54f - 0.46f * std::cos(2.0f * pi * i / (taps_count - 1));
+        h[i] = sinc * window;
+        sum += h[i];
+    }
+
+    /* Unity gain at DC, Q15. */
+    for (size_t i = 0; i < taps_count; i++) {
+        taps[i] = static_cast<int16_t>(std::lround(h[i] / sum * 32768.0f));
+    }
+
+    constexpr size_t bits = log_2(channel_count);
+    for (size_t i = 0; i < channel_count; i++) {
+        size_t r = 0;
+        for (size_t b = 0; b < bits; b++) {
+            r |= ((i >> b) & 1) << (bits - 1 - b);
+        }
+        bit_reverse[i] = r;
+    }
+
+    history.fill({0, 0});
+    write_index = 0;
+    phase = 0;
+    odd_output = false;
+}
+
+const PolyphaseChannelizer::channels_t& PolyphaseChannelizer::compute() {
+    constexpr float k = 1.0f / 32768.0f;
+
+    /* x[j] is the j-th most recent input sample. Branch p sums every
+     * channel_count-th tap starting at p, then the branch outputs are
+     * rotated into channels by the DFT.
+     */
+    const complex16_t* const x = &history[write_index];
+    for (size_t p = 0; p < channel_count; p++) {
+        int32_t acc_r = 0;
+        int32_t acc_i = 0;
+        for (size_t j = p; j < taps_count; j += channel_count) {
+            acc_r += taps[j] * x[j].real();
+            acc_i += taps[j] * x[j].imag();
+        }
+        work[bit_reverse[p]] = {acc_r * k, acc_i * k};
+    }
+
+    fft_c_preswapped(work, 0, log_2(channel_count));
+
+    /* The forward DFT puts channel +c in bin -c. Hopping by half the bank
+     * size rotates odd channels by pi every other output, undo that too.
+     */
+    for (size_t i = 0; i < channel_count; i++) {
+        const size_t c = (i + channel_count / 2) % channel_count;
+        const auto y = work[(channel_count - c) % channel_count];
+        channels[i] = (odd_output && (c & 1)) ? -y : y;
+    }
+    odd_output = !odd_output;
+
+    return channels;
+}
+
+} /* namespace channelizer */
+} /* namespace dsp */
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __DSP_CHANNELIZER_H__
+#define __DSP_CHANNELIZER_H__
+
+#include "dsp_types.hpp"
+
+#include <array>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+
+namespace dsp {
+namespace channelizer {
+
+/* Polyphase analysis filter bank, oversampled by two.
+ * Splits a complex baseband of rate fs into channel_count channels spaced
+ * fs / channel_count apart. One set of channel samples is produced every
+ * decimation_factor input samples, so each channel runs at twice its spacing
+ * and the channel filter skirts do not alias back into the passband.
+ */
+class PolyphaseChannelizer {
+   public:
+    static constexpr size_t channel_count = 32;
+    static constexpr size_t taps_per_branch = 16;
+    static constexpr size_t taps_count = channel_count * taps_per_branch;
+    static constexpr size_t decimation_factor = channel_count / 2;
+
+    using channels_t = std::array<std::complex<float>, channel_count>;
+
+    /* Designs the prototype low-pass filter (Hamming windowed sinc).
+     * cutoff_normalized is the -6dB point relative to the input sampling rate;
+     * 0.5 / channel_count places it half way between two channel centres.
+     */
+    void configure(const float cutoff_normalized);
+
+    /* channels[i] is centred on (i - channel_count / 2) * fs / channel_count,
+     * scaled so a tone on a channel centre comes out at its input amplitude.
+     */
+    template <typename ChannelsHandler>
+    void execute(const buffer_c16_t& src, ChannelsHandler&& channels_handler) {
+        for (size_t i = 0; i < src.count; i++) {
+            push(src.p[i]);
+            if (++phase == decimation_factor) {
+                phase = 0;
+                channels_handler(compute());
+            }
+        }
+    }
+
+   private:
+    std::array<int16_t, taps_count> taps{};
+    /* Delay line is stored twice so the newest taps_count samples are always contiguous. */
+    std::array<complex16_t, taps_count * 2> history{};
+    std::array<uint8_t, channel_count> bit_reverse{};
+    std::array<std::complex<float>, channel_count> work{};
+    channels_t channels{};
+    size_t write_index{0};
+    size_t phase{0};
+    bool odd_output{false};
+
+    void push(const complex16_t sample) {
+        write_index = (write_index == 0) ? (taps_count - 1) : (write_index - 1);
+        history[write_index] = sample;
+        history[write_index + taps_count] = sample;
+    }
+
+    const channels_t& compute();
+};
+
+} /* namespace channelizer */
+} /* namespace dsp */
+
+#endif /*__DSP_CHANNELIZER_H__*/
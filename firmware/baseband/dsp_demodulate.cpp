@@ -108,6 +108,12 @@ buffer_f32_t SSB_FM::execute(    // Added to handle AMFM (WFAX, HF weather map )
 buffer_f32_t FM::execute(
     const buffer_c16_t& src,
     const buffer_f32_t& dst) {
+    if (accuracy_ == Accuracy::Fast) {
+        return execute_fxpt<false>(src, dst);
+    } else if (accuracy_ == Accuracy::Precise) {
+        return execute_fxpt<true>(src, dst);
+    }
+
     auto z = z_;
 
     const void* src_p = src.p;
@@ -130,6 +136,12 @@ buffer_f32_t FM::execute(
 buffer_s16_t FM::execute(
     const buffer_c16_t& src,
     const buffer_s16_t& dst) {
+    if (accuracy_ == Accuracy::Fast) {
+        return execute_fxpt<false>(src, dst);
+    } else if (accuracy_ == Accuracy::Precise) {
+        return execute_fxpt<true>(src, dst);
+    }
+
     auto z = z_;
 
     const void* src_p = src.p;
@@ -155,7 +167,64 @@ buffer_s16_t FM::execute(
     return {dst.p, src.count, src.sampling_rate};
 }
 
-void FM::configure(const float sampling_rate, const float deviation_hz) {
+/* Same loops as above with the integer arctangent. The angle comes out in
+ * 1/32768ths of pi, so the float gain folds in pi / 32768 and the s16 gain
+ * is a Q16 multiplier. */
+template <bool Precise>
+buffer_f32_t FM::execute_fxpt(
+    const buffer_c16_t& src,
+    const buffer_f32_t& dst) {
+    auto z = z_;
+
+    const void* src_p = src.p;
+    const auto src_end = &src.p[src.count];
+    auto dst_p = dst.p;
+    while (src_p < src_end) {
+        const auto s0 = *__SIMD32(src_p)++;
+        const auto s1 = *__SIMD32(src_p)++;
+        const auto t0 = multiply_conjugate_s16_s32(s0, z);
+        const auto t1 = multiply_conjugate_s16_s32(s1, s0);
+        z = s1;
+        *(dst_p++) = fxpt_atan2_s32<Precise>(t0.imag(), t0.real()) * kf_fxpt;
+        *(dst_p++) = fxpt_atan2_s32<Precise>(t1.imag(), t1.real()) * kf_fxpt;
+    }
+    z_ = z;
+
+    return {dst.p, src.count, src.sampling_rate};
+}
+
+template <bool Precise>
+buffer_s16_t FM::execute_fxpt(
+    const buffer_c16_t& src,
+    const buffer_s16_t& dst) {
+    auto z = z_;
+
+    const void* src_p = src.p;
+    const auto src_end = &src.p[src.count];
+    void* dst_p = dst.p;
+    while (src_p < src_end) {
+        const auto s0 = *__SIMD32(src_p)++;
+        const auto s1 = *__SIMD32(src_p)++;
+        const auto t0 = multiply_conjugate_s16_s32(s0, z);
+        const auto t1 = multiply_conjugate_s16_s32(s1, s0);
+        z = s1;
+        const int32_t theta0 = fxpt_atan2_s32<Precise>(t0.imag(), t0.real());
+        const int32_t theta1 = fxpt_atan2_s32<Precise>(t1.imag(), t1.real());
+        const int32_t theta0_int = (static_cast<int64_t>(theta0) * ks16_fxpt) >> 16;
+        const int32_t theta0_sat = __SSAT(theta0_int, 16);
+        const int32_t theta1_int = (static_cast<int64_t>(theta1) * ks16_fxpt) >> 16;
+        const int32_t theta1_sat = __SSAT(theta1_int, 16);
+        *__SIMD32(dst_p)++ = __PKHBT(
+            theta0_sat,
+            theta1_sat,
+            16);
+    }
+    z_ = z;
+
+    return {dst.p, src.count, src.sampling_rate};
+}
+
+void FM::configure(const float sampling_rate, const float deviation_hz, const Accuracy accuracy) {
     /*
      * angle: -pi to pi. output range: -32768 to 32767.
      * Maximum delta-theta (output of atan2) at maximum deviation frequency:
@@ -163,6 +232,9 @@ void FM::configure(const float sampling_rate, const float deviation_hz) {
      */
     kf = static_cast<float>(1.0f / (2.0 * pi * deviation_hz / sampling_rate));
     ks16 = 32767.0f * kf;
+    kf_fxpt = kf * pi / 32768.0f;
+    ks16_fxpt = static_cast<int32_t>(ks16 * pi * 2.0f);
+    accuracy_ = accuracy;
 }
 
 }  // namespace demodulate
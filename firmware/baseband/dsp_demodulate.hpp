@@ -61,6 +61,14 @@ class SSB_FM {  // Added to handle AMFM for WFAX
 
 class FM {
    public:
+    /* Fast and Precise use the fixed-point arctangent (~0.23 and ~0.1 degree
+     * max error), Float is the original floating point discriminator. */
+    enum class Accuracy : uint8_t {
+        Fast,
+        Precise,
+        Float,
+    };
+
     buffer_f32_t execute(
         const buffer_c16_t& src,
         const buffer_f32_t& dst);
@@ -69,12 +77,25 @@ class FM {
         const buffer_c16_t& src,
         const buffer_s16_t& dst);
 
-    void configure(const float sampling_rate, const float deviation_hz);
+    void configure(const float sampling_rate, const float deviation_hz, const Accuracy accuracy = Accuracy::Precise);
 
    private:
     complex16_t::rep_type z_{0};
     float kf{0};
     float ks16{0};
+    float kf_fxpt{0};
+    int32_t ks16_fxpt{0};
+    Accuracy accuracy_{Accuracy::Precise};
+
+    template <bool Precise>
+    buffer_f32_t execute_fxpt(
+        const buffer_c16_t& src,
+        const buffer_f32_t& dst);
+
+    template <bool Precise>
+    buffer_s16_t execute_fxpt(
+        const buffer_c16_t& src,
+        const buffer_s16_t& dst);
 };
 
 } /* namespace demodulate */
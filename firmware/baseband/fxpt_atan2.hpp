@@ -26,4 +26,44 @@
 
 int16_t fxpt_atan2(const int16_t y, const int16_t x);
 
+/* Four-quadrant arctangent of a 32-bit vector such as the conjugate product
+ * in an FM discriminator. Returns the angle in 1/32768ths of pi (-32768 to
+ * 32768). Precise uses a third order polynomial (max error ~0.1 degree),
+ * otherwise a first order one (~0.23 degree) saves two multiplies.
+ */
+template <bool Precise>
+static inline int32_t fxpt_atan2_s32(const int32_t y, const int32_t x) {
+    const uint32_t ax = (x < 0) ? -static_cast<uint32_t>(x) : x;
+    const uint32_t ay = (y < 0) ? -static_cast<uint32_t>(y) : y;
+    const bool steep = ay > ax;
+    const uint32_t num = steep ? ax : ay;
+    const uint32_t den = steep ? ay : ax;
+    if (den == 0) {
+        return 0;
+    }
+
+    /* Scale both so den has its top bit set, then divide in Q15. */
+    const int shift = __builtin_clz(den);
+    const uint32_t den16 = (den << shift) >> 16;
+    const uint32_t num16 = (num << shift) >> 16;
+    const int32_t z = (num16 << 15) / den16;
+
+    /* atan(z) / pi for 0 <= z <= 1, in Q15. */
+    const int32_t z_1mz = (z * (32768 - z)) >> 15;
+    int32_t angle;
+    if (Precise) {
+        angle = (z >> 2) + ((z_1mz * (2552 + ((692 * z) >> 15))) >> 15);
+    } else {
+        angle = (z >> 2) + ((z_1mz * 2847) >> 15);
+    }
+
+    if (steep) {
+        angle = 16384 - angle;
+    }
+    if (x < 0) {
+        angle = 32768 - angle;
+    }
+    return (y < 0) ? -angle : angle;
+}
+
 #endif /*__FXPT_ATAN2_H__*/
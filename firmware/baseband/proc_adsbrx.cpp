@@ -27,6 +27,7 @@
 #include "sine_table_int8.hpp"
 #include "event_m4.hpp"
 #include "audio_dma.hpp"
+#include "utility_m4.hpp"
 
 #include <cstdint>
 #include <cstddef>
@@ -42,103 +43,118 @@ void ADSBRXProcessor::execute(const buffer_c8_t& buffer) {
 
     if (!configured) return;
 
-    uint8_t bit = 0;
-    uint8_t byte = 0;
-
-    for (size_t i = 0; i < buffer.count; i++) {
-        // Compute sample's magnitude.
-        int8_t re = buffer.p[i].real();
-        int8_t im = buffer.p[i].imag();
-        uint16_t mag = (re * re) + (im * im);
-
-        if (decoding) {
-            // 1 bit == 2 samples, transition defines bit value.
-            if ((sample_count & 1) == 1) {
-                if (bit_count >= msg_len) {
-                    const ADSBFrameMessage message(frame, amp);
-                    shared_memory.application_queue.push(message);
-                    decoding = false;
-                    bit = (prev_mag > mag) ? 1 : 0;
-                } else {
-                    bit = (prev_mag > mag) ? 1 : 0;
-                }
-
-                byte = bit | (byte << 1);
-                bit_count++;
-
-                // Every 8th bit...
-                if ((bit_count & 0x7) == 0) {
-                    // Store the byte.
-                    frame.push_byte(byte);
-
-                    // Perform additional check on the first byte.
-                    if (bit_count == 8) {
-                        // try to receive all frames instead
-                        msg_len = (byte & 0x80) ? 112 : 56;  // determine message len by type
-                    }
-                }
-            }
-
-            sample_count++;
-        }
+    // Two c8 samples per word: split into [re0, im0] and [re1, im1] halfwords
+    // so each magnitude is a single dual multiply-accumulate.
+    const uint32_t* src = reinterpret_cast<const uint32_t*>(buffer.p);
+    for (size_t i = 0; i < buffer.count / 2; i++) {
+        const uint32_t pair = src[i];
+        const uint32_t re = __SXTB16(pair);
+        const uint32_t im = __SXTB16(pair >> 8);
+        const uint32_t s0 = __PKHBT(re, im, 16);
+        const uint32_t s1 = __PKHTB(im, re, 16);
+
+        on_magnitude(__SMUAD(s0, s0));
+        on_magnitude(__SMUAD(s1, s1));
+    }
+}
 
-        // Continue looking for preamble, even if in a packet.
-        // Switch if new preamble is higher magnitude.
+void ADSBRXProcessor::on_magnitude(const uint32_t mag) {
+    if (decoding)
+        decode(mag);
 
-        // Shift the preamble.
-        for (uint8_t c = 0; c < ADSB_PREAMBLE_LENGTH; c++) {
-            shifter[c] = shifter[c + 1];
-        }
-        shifter[ADSB_PREAMBLE_LENGTH] = mag;
-
-        // First check of relations between the first 12 samples
-        // representing a valid preamble. We don't even investigate
-        // further if this simple test is not passed.
-        // Preamble is 8us - or 16 samples.
-        //    0123456789ABCDEF
-        //    _-_-____-_-_____
-        if (shifter[0] < shifter[1] &&
-            shifter[1] > shifter[2] &&
-            shifter[2] < shifter[3] &&
-            shifter[3] > shifter[4] &&
-            shifter[4] < shifter[1] &&
-            shifter[5] < shifter[1] &&
-            shifter[6] < shifter[1] &&
-            shifter[7] < shifter[1] &&
-            shifter[8] > shifter[9] &&
-            shifter[9] < shifter[10] &&
-            shifter[10] > shifter[11]) {
-            // The samples between the two spikes must be < than the average
-            // of the high spikes level. We don't test bits too near to
-            // the high levels as signals can be out of phase so part of the
-            // energy can be in the near samples.
-            int32_t this_amp = (shifter[1] + shifter[3] + shifter[8] + shifter[10]);
-            uint32_t high = this_amp / 9;  // TBD: Why 9?
-            if (shifter[5] < high &&
-                shifter[6] < high &&
-                // Similarly samples in the range 11-13 must be low, as it is the
-                // space between the preamble and real data. Again we don't test
-                // bits too near to high levels, see above.
-                shifter[12] < high &&
-                shifter[13] < high &&
-                shifter[14] < high) {
-                if ((decoding == false) ||                     // New preamble
-                    ((decoding == true) && (this_amp > amp)))  // Higher power than existing packet
-                {
-                    decoding = true;
-                    amp = this_amp;
-                    sample_count = 0;
-                    bit_count = 0;
-                    frame.clear();
-                }
-            }
+    mag_index = (mag_index + 1) & (mag_history_size - 1);
+    mag_history[mag_index] = mag;
+
+    // Continue looking for preamble, even if in a packet.
+    // Switch if new preamble is higher magnitude.
+    detect_preamble();
+}
+
+void ADSBRXProcessor::decode(const uint32_t mag) {
+    // 1 bit == 2 samples, transition defines bit value.
+    if ((sample_count++ & 1) == 0) {
+        first_mag = mag;
+        return;
+    }
+
+    // When the preamble showed the pulses straddling two samples, part of
+    // the previous bit's second half leaks into this bit's first half.
+    uint32_t first = first_mag;
+    if (phase_correction && bit_count > 0)
+        first = bit ? ((first * 5) >> 2) : ((first * 13) >> 4);
+
+    bit = (first > mag) ? 1 : 0;
+    byte = bit | (byte << 1);
+    bit_count++;
+
+    // Every 8th bit...
+    if ((bit_count & 0x7) == 0) {
+        // Store the byte.
+        frame.push_byte(byte);
+
+        // Perform additional check on the first byte.
+        if (bit_count == 8) {
+            // try to receive all frames instead
+            msg_len = (byte & 0x80) ? 112 : 56;  // determine message len by type
         }
+    }
 
-        // Store mag for next time.
-        prev_mag = mag;
+    if (bit_count >= msg_len) {
+        frame.correct_single_bit_error();
+
+        const ADSBFrameMessage message(frame, amp);
+        shared_memory.application_queue.push(message);
+        decoding = false;
     }
 }
 
+void ADSBRXProcessor::detect_preamble() {
+    // m(n) follows the 16 sample preamble layout, m(0) is the sample before it.
+    //    0123456789ABCDEFG
+    //    _-_-____-_-______
+    const auto m = [this](const size_t n) { return history(ADSB_PREAMBLE_LENGTH - n); };
+
+    // Stage one: the first two pulses must stand out from their neighbours.
+    // Noise fails here after one or two compares.
+    const uint32_t m1 = m(1);
+    const uint32_t m2 = m(2);
+    const uint32_t m3 = m(3);
+    if (m1 <= m2 || m3 <= m2 || m1 <= m(0) || m3 <= m(4))
+        return;
+
+    // Stage two: same shape for the last two pulses, then the quiet samples
+    // must stay under the average pulse energy. Samples right next to pulses
+    // are not tested as an out of phase signal spreads energy into them.
+    const uint32_t m8 = m(8);
+    const uint32_t m9 = m(9);
+    const uint32_t m10 = m(10);
+    if (m8 <= m9 || m10 <= m9 || m10 <= m(11))
+        return;
+
+    const uint32_t pulse_sum = m1 + m3 + m8 + m10;
+    if (m(5) * 9 >= pulse_sum ||
+        m(6) * 9 >= pulse_sum ||
+        // Similarly the space between the preamble and the data must be low.
+        m(12) * 9 >= pulse_sum ||
+        m(13) * 9 >= pulse_sum ||
+        m(14) * 9 >= pulse_sum)
+        return;
+
+    const int32_t this_amp = pulse_sum;
+    if (decoding && (this_amp <= amp))  // Only replace a packet with a stronger one.
+        return;
+
+    decoding = true;
+    amp = this_amp;
+    // Energy trailing the pulses means the bits are sampled late.
+    phase_correction = (m(4) + m(11)) * 3 > (m3 + m10);
+    sample_count = 0;
+    bit_count = 0;
+    bit = 0;
+    byte = 0;
+    frame.clear();
+}
+
 void ADSBRXProcessor::on_message(const Message* const message) {
     switch (message->id) {
         case Message::ID::ADSBConfigure:
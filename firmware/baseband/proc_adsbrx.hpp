@@ -29,6 +29,8 @@
 
 #include "adsb_frame.hpp"
 
+#include <array>
+
 using namespace adsb;
 
 #define ADSB_PREAMBLE_LENGTH 16
@@ -40,18 +42,32 @@ class ADSBRXProcessor : public BasebandProcessor {
 
    private:
     static constexpr size_t baseband_fs = 2'000'000;
+    static constexpr size_t mag_history_size = 32;  // Power of two > ADSB_PREAMBLE_LENGTH.
     size_t msg_len{112};
 
     ADSBFrame frame{};
     bool configured{false};
     bool decoding{false};
+    bool phase_correction{false};
 
-    uint32_t prev_mag{0};
+    uint32_t first_mag{0};
+    uint8_t bit{0};
+    uint8_t byte{0};
     int32_t amp{0};
     size_t bit_count{0};
     size_t sample_count{0};
 
-    uint32_t shifter[ADSB_PREAMBLE_LENGTH + 1];
+    /* Magnitudes of the last samples, indexed circularly so nothing is moved per sample. */
+    std::array<uint16_t, mag_history_size> mag_history{};
+    size_t mag_index{0};
+
+    uint32_t history(const size_t age) const {
+        return mag_history[(mag_index - age) & (mag_history_size - 1)];
+    }
+
+    void on_magnitude(const uint32_t mag);
+    void decode(const uint32_t mag);
+    void detect_preamble();
 
     void on_beep_message(const AudioBeepMessage& message);
 
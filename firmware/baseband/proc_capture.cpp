@@ -34,17 +34,18 @@ CaptureProcessor::CaptureProcessor() {
 }
 
 void CaptureProcessor::execute(const buffer_c8_t& buffer) {
-    auto decim_0_out = decim_0.execute(buffer, dst_buffer);
-    auto out_buffer = decim_1.execute(decim_0_out, dst_buffer);
-
-    if (stream) {
-        const size_t bytes_to_write = sizeof(*out_buffer.p) * out_buffer.count;
-        const size_t written = stream->write(out_buffer.p, bytes_to_write);
-        if (written != bytes_to_write) {
-            // TODO: Send an error message to the app?
-        }
-    }
-
+    // Decimate straight into the stream buffer when there's room for the
+    // first stage's output, the second stage works in place after it.
+    const size_t decim_0_count = buffer.count / decim_0.decimation_factor();
+    void* const in_place = stream ? stream->claim(decim_0_count * sizeof(complex16_t)) : nullptr;
+    const buffer_c16_t out{
+        in_place ? static_cast<complex16_t*>(in_place) : dst.data(),
+        in_place ? decim_0_count : dst.size()};
+
+    auto decim_0_out = decim_0.execute(buffer, out);
+    auto out_buffer = decim_1.execute(decim_0_out, out);
+
+    // Before the stream gets it, the application may convert full buffers in place.
     feed_channel_stats(out_buffer);
 
     spectrum_samples += out_buffer.count;
@@ -53,6 +54,15 @@ void CaptureProcessor::execute(const buffer_c8_t& buffer) {
         channel_spectrum.feed(out_buffer, channel_filter_low_f,
                               channel_filter_high_f, channel_filter_transition);
     }
+
+    if (stream) {
+        const size_t bytes_to_write = sizeof(*out_buffer.p) * out_buffer.count;
+        const size_t written = in_place ? stream->commit(bytes_to_write)
+                                        : stream->write(out_buffer.p, bytes_to_write);
+        if (written != bytes_to_write) {
+            // TODO: Send an error message to the app?
+        }
+    }
 }
 
 void CaptureProcessor::on_signal_message(const RequestSignalMessage& message) {
@@ -99,10 +99,8 @@ class CaptureProcessor : public BasebandProcessor {
     size_t baseband_fs = 3072000;  // aka: sample_rate
     static constexpr auto spectrum_rate_hz = 50.0f;
 
+    /* Decimator output when the stream buffer can't take it in place. */
     std::array<complex16_t, 512> dst{};
-    const buffer_c16_t dst_buffer{
-        dst.data(),
-        dst.size()};
 
     /* The actual type will be configured depending on the sample rate. */
     MultiDecimator<
@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "proc_channelizer.hpp"
+#include "portapack_shared_memory.hpp"
+#include "dsp_fir_design.hpp"
+#include "dsp_iir_config.hpp"
+#include "utility.hpp"
+
+#include "audio_dma.hpp"
+
+#include "event_m4.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+
+void ChannelizerProcessor::execute(const buffer_c8_t& buffer) {
+    if (!configured) {
+        return;
+    }
+
+    const auto decim_0_out = decim_0.execute(buffer, dst_buffer);
+    const auto decim_1_out = decim_1.execute(decim_0_out, dst_buffer);
+
+    channel_samples = 0;
+    channelizer.execute(decim_1_out, [this](const Channelizer::channels_t& channels) {
+        on_channels(channels);
+    });
+
+    const buffer_c16_t channel_buffer{channel.data(), channel_samples, channel_fs};
+    feed_channel_stats(channel_buffer);
+
+    auto demodulated = demod_fm.execute(channel_buffer, demod_buffer);
+    if (active_channel < 0) {
+        std::fill_n(demodulated.p, demodulated.count, 0.0f);
+    }
+
+    audio_samples = 0;
+    for (size_t i = 0; i < demodulated.count; i++) {
+        resampler(demodulated.p[i], [this](const float sample) {
+            if (audio_samples < audio.size()) {
+                audio[audio_samples++] = sample;
+            }
+        });
+    }
+    audio_output.write(buffer_f32_t{audio.data(), audio_samples, audio_fs});
+}
+
+void ChannelizerProcessor::on_channels(const Channelizer::channels_t& channels) {
+    for (size_t i = 0; i < channel_count; i++) {
+        power_acc[i] += std::norm(channels[first_channel + i]);
+    }
+
+    /* Keep demodulating the centre channel while closed so the FM state stays warm. */
+    const size_t selected = (active_channel < 0) ? (channel_count / 2) : active_channel;
+    const auto sample = channels[first_channel + selected];
+    if (channel_samples < channel.size()) {
+        channel[channel_samples++] = {
+            static_cast<int16_t>(std::clamp(sample.real(), -32768.0f, 32767.0f)),
+            static_cast<int16_t>(std::clamp(sample.imag(), -32768.0f, 32767.0f))};
+    }
+
+    if (++window_count == window_outputs) {
+        window_count = 0;
+        on_window();
+    }
+}
+
+void ChannelizerProcessor::on_window() {
+    constexpr float full_scale_mag2 = 32768.0f * 32768.0f;
+    constexpr float scale = 1.0f / (window_outputs * full_scale_mag2);
+
+    std::array<float, channel_count> window_db{};
+    int strongest = -1;
+    float strongest_db = squelch_db;
+    for (size_t i = 0; i < channel_count; i++) {
+        /* Offset keeps log2 away from zero on an idle channel. */
+        window_db[i] = mag2_to_dbv_norm(power_acc[i] * scale + 1e-13f);
+        power_acc[i] = 0.0f;
+
+        power_peak_db[i] = std::max(power_peak_db[i], window_db[i]);
+        if (window_db[i] >= strongest_db) {
+            strongest = i;
+            strongest_db = window_db[i];
+        }
+    }
+
+    const bool hold_active = (active_channel >= 0) &&
+                             (window_db[active_channel] >= squelch_db - squelch_hysteresis_db);
+    if (!hold_active) {
+        active_channel = strongest;
+    }
+
+    if (++report_count == windows_per_report) {
+        report_count = 0;
+
+        ChannelizerStatistics statistics{};
+        for (size_t i = 0; i < channel_count; i++) {
+            statistics.db[i] = static_cast<int8_t>(std::clamp(power_peak_db[i], -127.0f, 0.0f));
+            power_peak_db[i] = -127.0f;
+        }
+        statistics.active_channel = active_channel;
+
+        const ChannelizerStatisticsMessage message{statistics};
+        shared_memory.application_queue.push(message);
+    }
+}
+
+void ChannelizerProcessor::on_message(const Message* const message) {
+    switch (message->id) {
+        case Message::ID::ChannelizerConfigure:
+            configure(*reinterpret_cast<const ChannelizerConfigureMessage*>(message));
+            break;
+
+        default:
+            break;
+    }
+}
+
+void ChannelizerProcessor::configure(const ChannelizerConfigureMessage& message) {
+    /* Only the central channels are used, so the pass band is +/-100kHz at
+     * both stages of the exact 3.2M -> 800k -> 400k chain. */
+    static constexpr auto taps_decim_0 = fir_design::decimator_real<24>(baseband_fs, 100000, 4);
+    static constexpr auto taps_decim_1 = fir_design::decimator_real<16>(baseband_fs / 4, 100000, 2);
+    decim_0.configure(taps_decim_0.taps);
+    decim_1.configure(taps_decim_1.taps);
+
+    if (!configured) {
+        channelizer.configure(0.5f / Channelizer::channel_count);
+        power_peak_db.fill(-127.0f);
+    }
+
+    demod_fm.configure(channel_fs, message.deviation);
+    resampler.configure(channel_fs, audio_fs);
+    audio_output.configure(audio_24k_hpf_300hz_config, audio_24k_deemph_300_6_config, 0.0f);
+
+    squelch_db = message.squelch_db;
+    configured = true;
+}
+
+int main() {
+    audio::dma::init_audio_out();
+
+    EventDispatcher event_dispatcher{std::make_unique<ChannelizerProcessor>()};
+    event_dispatcher.run();
+    return 0;
+}
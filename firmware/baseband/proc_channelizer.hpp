@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __PROC_CHANNELIZER_H__
+#define __PROC_CHANNELIZER_H__
+
+#include "baseband_processor.hpp"
+#include "baseband_thread.hpp"
+#include "rssi_thread.hpp"
+
+#include "dsp_decimate.hpp"
+#include "dsp_demodulate.hpp"
+#include "dsp_channelizer.hpp"
+#include "linear_resampler.hpp"
+
+#include "audio_output.hpp"
+
+#include <array>
+#include <cstdint>
+
+/* Watches ChannelizerStatistics::channel_count NFM channels at once and plays
+ * the strongest one that is open. 3.2Msps -> 400ksps -> 32 x 12.5kHz channels,
+ * of which the central 16 are inside the decimation filters' passband.
+ */
+class ChannelizerProcessor : public BasebandProcessor {
+   public:
+    void execute(const buffer_c8_t& buffer) override;
+    void on_message(const Message* const message) override;
+
+   private:
+    using Channelizer = dsp::channelizer::PolyphaseChannelizer;
+
+    static constexpr size_t baseband_fs = ChannelizerStatistics::sampling_rate;
+    static constexpr size_t channelizer_fs = baseband_fs / 4 / 2;
+    static constexpr size_t channel_fs = channelizer_fs / Channelizer::decimation_factor;
+    static constexpr size_t audio_fs = 24000;
+    static constexpr size_t channel_count = ChannelizerStatistics::channel_count;
+    static constexpr size_t first_channel = (Channelizer::channel_count - channel_count) / 2;
+
+    /* Squelch decisions every 10ms, reports to the application every 100ms. */
+    static constexpr size_t window_outputs = channel_fs / 100;
+    static constexpr size_t windows_per_report = 10;
+    static constexpr float squelch_hysteresis_db = 3.0f;
+
+    std::array<complex16_t, 512> dst{};
+    const buffer_c16_t dst_buffer{
+        dst.data(),
+        dst.size()};
+
+    std::array<complex16_t, 32> channel{};
+    size_t channel_samples{0};
+
+    std::array<float, 32> demod{};
+    const buffer_f32_t demod_buffer{
+        demod.data(),
+        demod.size()};
+
+    std::array<float, 32> audio{};
+    size_t audio_samples{0};
+
+    dsp::decimate::FIRC8xR16x24FS4Decim4 decim_0{};
+    dsp::decimate::FIRC16xR16x16Decim2 decim_1{};
+    Channelizer channelizer{};
+    dsp::demodulate::FM demod_fm{};
+    dsp::interpolation::LinearResampler resampler{};
+
+    AudioOutput audio_output{};
+
+    std::array<float, channel_count> power_acc{};
+    std::array<float, channel_count> power_peak_db{};
+    size_t window_count{0};
+    size_t report_count{0};
+    float squelch_db{-70.0f};
+    int active_channel{-1};
+
+    bool configured{false};
+
+    /* NB: Threads should be the last members in the class definition. */
+    BasebandThread baseband_thread{baseband_fs, this, baseband::Direction::Receive};
+    RSSIThread rssi_thread{};
+
+    void on_channels(const Channelizer::channels_t& channels);
+    void on_window();
+    void configure(const ChannelizerConfigureMessage& message);
+};
+
+#endif /*__PROC_CHANNELIZER_H__*/
@@ -24,6 +24,8 @@
 #include "lpc43xx_cpp.hpp"
 using namespace lpc43xx;
 
+#include <cmath>
+
 StreamInput::StreamInput(CaptureConfig* const config)
     : fifo_buffers_empty{buffers_empty.data(), buffer_count_max_log2},
       fifo_buffers_full{buffers_full.data(), buffer_count_max_log2},
@@ -36,10 +38,90 @@ StreamInput::StreamInput(CaptureConfig* const config)
         buffers[i] = {&(data.get()[i * config->write_size]), config->write_size};
         fifo_buffers_empty.in(&buffers[i]);
     }
+
+    const auto& trigger = config->trigger;
+    detect_activity = trigger.annotate || trigger.source != CaptureTrigger::Source::None;
+    // Mean power of full scale s16 samples is 32768^2.
+    squelch_power = 32768.0f * 32768.0f * std::pow(10.0f, trigger.squelch_db / 10.0f);
+    release_power = squelch_power / 2;
+
+    if (trigger.source != CaptureTrigger::Source::None) {
+        state = State::Armed;
+    }
 }
 
 size_t StreamInput::write(const void* const data, const size_t length) {
     const uint8_t* p = static_cast<const uint8_t*>(data);
+
+    if (state == State::Done) {
+        return 0;
+    }
+
+    const bool active = detect_activity && update_activity(data, length);
+
+    switch (state) {
+        case State::Streaming:
+            break;
+
+        case State::Armed:
+            if (!active) {
+                hold(p, length);
+                return length;
+            }
+            release_held();
+            state = State::Triggered;
+            break;
+
+        case State::Triggered:
+            if (!active) {
+                post_trigger_remaining = config->trigger.post_trigger_bytes;
+                state = State::PostTrigger;
+            }
+            break;
+
+        case State::PostTrigger:
+            if (active) {
+                state = State::Triggered;
+            } else if (post_trigger_remaining <= length) {
+                annotate(active);
+                const auto written = write_buffers(p, post_trigger_remaining);
+                finish();
+                return written;
+            } else {
+                post_trigger_remaining -= length;
+            }
+            break;
+
+        case State::Done:
+            return 0;
+    }
+
+    annotate(active);
+    return write_buffers(p, length);
+}
+
+void* StreamInput::claim(const size_t length) {
+    // Holding may recycle buffers, keep that on the copying path.
+    if (state == State::Armed || state == State::Done) {
+        return nullptr;
+    }
+
+    if (!active_buffer && !fifo_buffers_empty.out(active_buffer)) {
+        return nullptr;
+    }
+
+    if (active_buffer->capacity() - active_buffer->size() < length) {
+        return nullptr;
+    }
+
+    return static_cast<uint8_t*>(active_buffer->data()) + active_buffer->size();
+}
+
+size_t StreamInput::commit(const size_t length) {
+    return write(static_cast<uint8_t*>(active_buffer->data()) + active_buffer->size(), length);
+}
+
+size_t StreamInput::write_buffers(const uint8_t* const p, const size_t length) {
     size_t written = 0;
 
     while (written < length) {
@@ -52,7 +134,15 @@ size_t StreamInput::write(const void* const data, const size_t length) {
         }
 
         const auto remaining = length - written;
-        written += active_buffer->write(&p[written], remaining);
+        const auto in_place = static_cast<uint8_t*>(active_buffer->data()) + active_buffer->size();
+        if (&p[written] == in_place) {
+            // Filled in through claim(), nothing to copy.
+            const auto n = std::min(remaining, active_buffer->capacity() - active_buffer->size());
+            active_buffer->set_size(active_buffer->size() + n);
+            written += n;
+        } else {
+            written += active_buffer->write(&p[written], remaining);
+        }
 
         if (active_buffer->is_full()) {
             if (!fifo_buffers_full.in(active_buffer)) {
@@ -70,6 +160,131 @@ size_t StreamInput::write(const void* const data, const size_t length) {
 
     config->baseband_bytes_received += length;
     config->baseband_bytes_dropped += (length - written);
+    stream_position += written;
 
     return written;
 }
+
+/* Records activity edges at the current stream position. The event is in
+ * place before write_index moves, the application reads them in that order. */
+void StreamInput::annotate(const bool active) {
+    auto& annotations = config->annotations;
+    if (!config->trigger.annotate || active == annotations.active) {
+        return;
+    }
+
+    if (active) {
+        annotations.active_start = stream_position;
+    } else {
+        annotations.events[annotations.write_index % CaptureAnnotations::capacity] = {
+            annotations.active_start, stream_position};
+        __DMB();
+        annotations.write_index++;
+    }
+    __DMB();
+    annotations.active = active;
+}
+
+/* Same as write_buffers() but full buffers go to the held ring, and the
+ * oldest held buffer is overwritten when no empty one is left. */
+void StreamInput::hold(const uint8_t* const p, const size_t length) {
+    size_t written = 0;
+
+    while (written < length) {
+        if (!active_buffer && !fifo_buffers_empty.out(active_buffer)) {
+            if (held_count == 0)
+                return;
+            active_buffer = held[held_first];
+            active_buffer->empty();
+            held_first = (held_first + 1) % buffer_count_max;
+            held_count--;
+        }
+
+        written += active_buffer->write(&p[written], length - written);
+
+        if (active_buffer->is_full()) {
+            held[(held_first + held_count) % buffer_count_max] = active_buffer;
+            held_count++;
+            active_buffer = nullptr;
+        }
+    }
+}
+
+/* Hands over the held buffers covering the pre-trigger window, oldest first.
+ * The partially filled active buffer follows as it fills up. */
+void StreamInput::release_held() {
+    const auto write_size = config->write_size;
+    const size_t wanted = (config->trigger.pre_trigger_bytes + write_size - 1) / write_size;
+
+    while (held_count > 0) {
+        auto buffer = held[held_first];
+        held_first = (held_first + 1) % buffer_count_max;
+
+        if (held_count > wanted) {
+            buffer->empty();
+            fifo_buffers_empty.in(buffer);
+        } else {
+            fifo_buffers_full.in(buffer);
+            config->baseband_bytes_received += buffer->size();
+            stream_position += buffer->size();
+        }
+        held_count--;
+    }
+
+    creg::m4txevent::assert_event();
+}
+
+/* Flushes the partial buffer and tells the application the burst is over.
+ * The application stops once it sees done with no buffers left, so the last
+ * buffer must be in the FIFO before done is. */
+void StreamInput::finish() {
+    state = State::Done;
+
+    if (active_buffer || fifo_buffers_empty.out(active_buffer)) {
+        fifo_buffers_full.in(active_buffer);
+        active_buffer = nullptr;
+    }
+
+    __DMB();
+    config->trigger.done = true;
+    creg::m4txevent::assert_event();
+}
+
+/* Activity starts above the squelch and ends once the power has stayed
+ * below the release level for release_bytes, so noise around the squelch
+ * doesn't flap it. Levels in between hold the current state. */
+bool StreamInput::update_activity(const void* const data, const size_t length) {
+    const auto& trigger = config->trigger;
+
+    bool above = false;
+    bool below = true;
+    if (trigger.source == CaptureTrigger::Source::External) {
+        above = trigger.external;
+        below = !above;
+    } else {
+        // Squelch on the mean power of the s16 samples (I/Q pairs or audio).
+        const uint32_t* p = static_cast<const uint32_t*>(data);
+        const size_t count = length / sizeof(uint32_t);
+        if (count > 0) {
+            uint64_t sum = 0;
+            for (size_t i = 0; i < count; i++) {
+                sum = __SMLALD(p[i], p[i], sum);
+            }
+            const float power = static_cast<float>(sum) / (count * 2);
+            above = power > squelch_power;
+            below = power < release_power;
+        }
+    }
+
+    if (above) {
+        activity = true;
+        quiet_bytes = 0;
+    } else if (!below) {
+        quiet_bytes = 0;
+    } else if (activity) {
+        quiet_bytes += length;
+        if (quiet_bytes >= trigger.release_bytes)
+            activity = false;
+    }
+    return activity;
+}
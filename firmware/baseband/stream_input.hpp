@@ -41,10 +41,26 @@ class StreamInput {
 
     size_t write(const void* const data, const size_t length);
 
+    /* Room for the next length bytes in the active buffer, for a producer
+     * to fill in place instead of going through write(). nullptr when they
+     * don't fit the buffer or are held back for a trigger. */
+    void* claim(const size_t length);
+
+    /* Hands over length bytes filled in at claim(). */
+    size_t commit(const size_t length);
+
    private:
     static constexpr size_t buffer_count_max_log2 = 3;
     static constexpr size_t buffer_count_max = 1U << buffer_count_max_log2;
 
+    enum class State {
+        Streaming,
+        Armed,
+        Triggered,
+        PostTrigger,
+        Done,
+    };
+
     FIFO<StreamBuffer*> fifo_buffers_empty;
     FIFO<StreamBuffer*> fifo_buffers_full;
     std::array<StreamBuffer, buffer_count_max> buffers{};
@@ -53,6 +69,27 @@ class StreamInput {
     StreamBuffer* active_buffer{nullptr};
     CaptureConfig* const config{nullptr};
     std::unique_ptr<uint8_t[]> data{};
+
+    /* Full buffers kept back while armed, oldest at held_first. */
+    State state{State::Streaming};
+    std::array<StreamBuffer*, buffer_count_max> held{};
+    size_t held_first{0};
+    size_t held_count{0};
+    size_t post_trigger_remaining{0};
+    float squelch_power{0};
+    float release_power{0};
+    bool detect_activity{false};
+    bool activity{false};
+    uint32_t quiet_bytes{0};
+    /* Bytes handed to the application so far. */
+    uint64_t stream_position{0};
+
+    size_t write_buffers(const uint8_t* const p, const size_t length);
+    void hold(const uint8_t* const p, const size_t length);
+    void release_held();
+    void finish();
+    void annotate(const bool active);
+    bool update_activity(const void* const data, const size_t length);
 };
 
 #endif /*__STREAM_INPUT_H__*/
@@ -25,15 +25,20 @@
 #include "lpc43xx_cpp.hpp"
 using namespace lpc43xx;
 
+#include <ch.h>
+
 StreamOutput::StreamOutput(ReplayConfig* const config)
     : fifo_buffers_empty{buffers_empty.data(), buffer_count_max_log2},
       fifo_buffers_full{buffers_full.data(), buffer_count_max_log2},
-      config{config},
-      data{std::make_unique<uint8_t[]>(config->read_size * config->buffer_count)} {
+      config{config} {
+    // A deeper pool rides out longer SD card stalls.
+    const auto buffer_count = pool_buffer_count();
+    data = std::make_unique<uint8_t[]>(config->read_size * buffer_count);
+    config->buffers_allocated = buffer_count;
     config->fifo_buffers_empty = &fifo_buffers_empty;
     config->fifo_buffers_full = &fifo_buffers_full;
 
-    for (size_t i = 0; i < config->buffer_count; i++) {
+    for (size_t i = 0; i < buffer_count; i++) {
         // Set buffers to point consecutively in previously allocated unique_ptr "data"
         buffers[i] = {&(data.get()[i * config->read_size]), config->read_size};
         // Put all buffer pointers in the "empty buffer" FIFO
@@ -70,7 +75,33 @@ size_t StreamOutput::read(void* const data, const size_t length) {
         }
     }
 
+    if (read < length) {
+        // Ran dry, a hole in the transmission unless the file has ended.
+        if (!config->end_of_stream) {
+            if (!starved) {
+                config->underruns++;
+            }
+            config->baseband_bytes_missed += length - read;
+        }
+        starved = true;
+    } else {
+        starved = false;
+    }
+
     config->baseband_bytes_received += length;
 
     return read;
 }
+
+// As many buffers as the FIFOs take and the heap allows, at least the number requested.
+size_t StreamOutput::pool_buffer_count() const {
+    size_t count = buffer_count_max;
+    for (; count > config->buffer_count; count--) {
+        void* p = chHeapAlloc(nullptr, config->read_size * count + heap_reserve);
+        if (p) {
+            chHeapFree(p);
+            break;
+        }
+    }
+    return count;
+}
@@ -43,6 +43,9 @@ class StreamOutput {
     size_t read(void* const data, const size_t length);
 
    private:
+    /* Heap left for the rest of the processor when growing the pool. */
+    static constexpr size_t heap_reserve = 8192;
+
     static constexpr size_t buffer_count_max_log2 = 3;
     static constexpr size_t buffer_count_max = 1U << buffer_count_max_log2;
 
@@ -54,6 +57,9 @@ class StreamOutput {
     StreamBuffer* active_buffer{nullptr};
     ReplayConfig* const config{nullptr};
     std::unique_ptr<uint8_t[]> data{};
+    bool starved{false};
+
+    size_t pool_buffer_count() const;
 };
 
 #endif /*__STREAM_OUTPUT_H__*/
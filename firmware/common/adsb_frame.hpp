@@ -23,6 +23,7 @@
 #ifndef __ADSB_FRAME_H__
 #define __ADSB_FRAME_H__
 
+#include <array>
 #include <cstring>
 #include <string>
 #include <cstdint>
@@ -32,6 +33,22 @@ namespace adsb {
 alignas(4) const uint8_t adsb_preamble[16] = {1, 0, 1, 0, 0, 0, 0, 1, 0, 1, 0, 0, 0, 0, 0, 0};
 alignas(4) const char icao_id_lut[65] = "#ABCDEFGHIJKLMNOPQRSTUVWXYZ##### ###############0123456789######";
 
+/* Parity change caused by flipping bit i (MSB first) of a 112 bit frame,
+ * x^(111 - i) mod the Mode S generator. A 56 bit frame uses entries 56-111.
+ */
+constexpr std::array<uint32_t, 112> make_crc_syndromes() {
+    std::array<uint32_t, 112> syndromes{};
+    uint32_t r = 1;
+    for (size_t i = syndromes.size(); i-- > 0;) {
+        syndromes[i] = r;
+        r <<= 1;
+        if (r & 0x1000000) r ^= 0x1FFF409;
+    }
+    return syndromes;
+}
+
+alignas(4) constexpr std::array<uint32_t, 112> crc_syndromes = make_crc_syndromes();
+
 class ADSBFrame {
    public:
     uint8_t get_DF() {
@@ -100,6 +117,29 @@ class ADSBFrame {
         return (received_CRC ^ computed_CRC) & 0xFFFFFF;
     }
 
+    /* Repairs a single flipped bit in a DF17/18 frame. Other formats overlay
+     * the parity with the address, so their syndrome is not an error pattern.
+     * Returns true if the frame checks out afterwards.
+     */
+    bool correct_single_bit_error() {
+        const uint8_t df = get_DF();
+        if (df != 17 && df != 18)
+            return false;
+
+        const uint32_t syndrome = check_CRC();
+        if (syndrome == 0)
+            return true;
+
+        // Never flip the DF field itself.
+        for (size_t i = 5; i < crc_syndromes.size(); i++) {
+            if (crc_syndromes[i] == syndrome) {
+                raw_data[i >> 3] ^= (0x80 >> (i & 7));
+                return true;
+            }
+        }
+        return false;
+    }
+
     bool empty() {
         return (index == 0);
     }
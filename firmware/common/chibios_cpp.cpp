@@ -25,18 +25,26 @@
 
 #include <ch.h>
 
-void* operator new(size_t size) {
-    void* p = chHeapAlloc(0x0, size);
+static MemoryHeap* selected_heap = nullptr;
+static Thread* selected_heap_thread = nullptr;
+
+static void* allocate(size_t size) {
+    void* p = nullptr;
+    if (selected_heap && (selected_heap_thread == chThdSelf()))
+        p = chHeapAlloc(selected_heap, size);
+    if (p == nullptr)
+        p = chHeapAlloc(0x0, size);
     if (p == nullptr)
         chDbgPanic("Out of Memory");
     return p;
 }
 
+void* operator new(size_t size) {
+    return allocate(size);
+}
+
 void* operator new[](size_t size) {
-    void* p = chHeapAlloc(0x0, size);
-    if (p == nullptr)
-        chDbgPanic("Out of Memory");
-    return p;
+    return allocate(size);
 }
 
 void operator delete(void* p) noexcept {
@@ -71,4 +79,11 @@ size_t heap_used() {
     return heap_size() - (core_free + heap_free);
 }
 
+MemoryHeap* select_heap(MemoryHeap* heap) {
+    const auto previous = (selected_heap_thread == chThdSelf()) ? selected_heap : nullptr;
+    selected_heap = heap;
+    selected_heap_thread = heap ? chThdSelf() : nullptr;
+    return previous;
+}
+
 } /* namespace chibios */
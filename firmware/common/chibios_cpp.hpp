@@ -28,16 +28,24 @@
 /* NOTE: Do not inline these, it doesn't work. ;-) */
 void* operator new(size_t size);
 void* operator new[](size_t size);
-void operator delete(void* p);
-void operator delete[](void* p);
-void operator delete(void* ptr, std::size_t);
-void operator delete[](void* ptr, std::size_t);
+void operator delete(void* p) noexcept;
+void operator delete[](void* p) noexcept;
+void operator delete(void* ptr, std::size_t) noexcept;
+void operator delete[](void* ptr, std::size_t) noexcept;
+
+struct memory_heap;
 
 namespace chibios {
 
 size_t heap_size();
 size_t heap_used();
 
+/* Makes operator new on the calling thread allocate from heap first, falling
+ * back to the default heap once it is exhausted. Allocations made by other
+ * threads are unaffected. Pass nullptr to restore the default heap.
+ * Returns the heap that was previously selected for this thread, if any. */
+memory_heap* select_heap(memory_heap* heap);
+
 } /* namespace chibios */
 
 #endif /*__CHIBIOS_CPP_H__*/
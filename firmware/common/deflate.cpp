@@ -0,0 +1,452 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "deflate.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace deflate {
+
+namespace {
+
+constexpr size_t end_of_block = 256;
+
+constexpr std::array<uint16_t, 29> length_base{{
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258}};
+constexpr std::array<uint8_t, 29> length_extra{{
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0}};
+
+constexpr std::array<uint16_t, 30> distance_base{{
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577}};
+constexpr std::array<uint8_t, 30> distance_extra{{
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13}};
+
+/* Index of the last base <= value. */
+template <size_t N>
+size_t code_for(const std::array<uint16_t, N>& base, size_t value) {
+    size_t i = 0;
+    while (i + 1 < N && base[i + 1] <= value)
+        i++;
+    return i;
+}
+
+}  // namespace
+
+/* Encoder ***************************************************************/
+
+Encoder::Encoder(Sink sink, bool zlib)
+    : sink{std::move(sink)},
+      zlib{zlib} {
+    reset();
+}
+
+void Encoder::reset() {
+    finished = false;
+    adler_32 = {};
+    position = 0;
+    end = 0;
+    head.fill(0);
+    prev.fill(0);
+    bits = 0;
+    bit_count = 0;
+    output_used = 0;
+
+    if (zlib) {
+        put_bits(zlib_header[0], 8);
+        put_bits(zlib_header[1], 8);
+    }
+
+    // The whole stream is one final, fixed Huffman block.
+    put_bits(1, 1);
+    put_bits(1, 2);
+}
+
+void Encoder::write(const void* data, size_t length) {
+    if (finished)
+        return;
+
+    auto p = static_cast<const uint8_t*>(data);
+    if (zlib)
+        adler_32.feed(p, length);
+
+    while (length > 0) {
+        if (end == buffer_size)
+            slide();
+
+        const size_t n = std::min(length, buffer_size - end);
+        std::memcpy(&buffer[end], p, n);
+        end += n;
+        p += n;
+        length -= n;
+
+        compress(false);
+    }
+}
+
+void Encoder::finish() {
+    if (finished)
+        return;
+
+    compress(true);
+    put_code(end_of_block - 256, 7);
+    if (bit_count > 0)
+        put_bits(0, 8 - bit_count);
+
+    if (zlib) {
+        for (auto b : adler_32.bytes())
+            put_bits(b, 8);
+    }
+
+    flush_output();
+    finished = true;
+}
+
+/* Codes everything but the last max_match bytes, which may still get
+ * longer matches, unless flushing. */
+void Encoder::compress(bool flush) {
+    while (position < end && (flush || end - position >= max_match)) {
+        size_t distance = 0;
+        const size_t length = find_match(position, distance);
+        insert(position);
+
+        if (length >= min_match) {
+            put_match(length, distance);
+            for (size_t i = 1; i < length; i++)
+                insert(position + i);
+            position += length;
+        } else {
+            put_literal(buffer[position]);
+            position++;
+        }
+    }
+}
+
+/* Drops the older half of the buffer, only the newer one is in the window. */
+void Encoder::slide() {
+    std::memmove(&buffer[0], &buffer[window_size], window_size);
+    position -= window_size;
+    end -= window_size;
+
+    auto rebase = [](uint16_t& v) {
+        v = (v > window_size) ? v - window_size : 0;
+    };
+    std::for_each(head.begin(), head.end(), rebase);
+    std::for_each(prev.begin(), prev.end(), rebase);
+}
+
+static size_t hash(const uint8_t* p) {
+    const uint32_t v = (p[0] << 16) | (p[1] << 8) | p[2];
+    return (v * 2654435761U) >> 22;
+}
+
+void Encoder::insert(size_t at) {
+    if (end - at < min_match)
+        return;
+
+    auto& h = head[hash(&buffer[at])];
+    prev[at % window_size] = h;
+    h = at + 1;
+}
+
+size_t Encoder::find_match(size_t at, size_t& distance) const {
+    const size_t limit = std::min(max_match, end - at);
+    if (limit < min_match)
+        return 0;
+
+    size_t best = 0;
+    size_t chain = max_chain;
+    uint16_t next = head[hash(&buffer[at])];
+
+    while (next != 0 && chain-- > 0) {
+        const size_t candidate = next - 1;
+        if (candidate >= at || at - candidate > window_size)
+            break;
+
+        // Only worth comparing if it could beat the best so far.
+        if (buffer[candidate + best] == buffer[at + best]) {
+            size_t length = 0;
+            while (length < limit && buffer[candidate + length] == buffer[at + length])
+                length++;
+
+            if (length > best) {
+                best = length;
+                distance = at - candidate;
+                if (length == limit)
+                    break;
+            }
+        }
+
+        next = prev[candidate % window_size];
+    }
+
+    return (best >= min_match) ? best : 0;
+}
+
+void Encoder::put_bits(uint32_t value, size_t count) {
+    bits |= value << bit_count;
+    bit_count += count;
+
+    while (bit_count >= 8) {
+        put_byte(bits & 0xff);
+        bits >>= 8;
+        bit_count -= 8;
+    }
+}
+
+/* Huffman codes go out most significant bit first. */
+void Encoder::put_code(uint32_t code, size_t length) {
+    uint32_t reversed = 0;
+    for (size_t i = 0; i < length; i++) {
+        reversed = (reversed << 1) | (code & 1);
+        code >>= 1;
+    }
+    put_bits(reversed, length);
+}
+
+/* Fixed literal/length code (RFC 1951 3.2.6). */
+void Encoder::put_literal(uint8_t value) {
+    if (value < 144)
+        put_code(0x30 + value, 8);
+    else
+        put_code(0x190 + (value - 144), 9);
+}
+
+void Encoder::put_match(size_t length, size_t distance) {
+    const size_t l = code_for(length_base, length);
+    const size_t symbol = 257 + l;
+    if (symbol < 280)
+        put_code(symbol - 256, 7);
+    else
+        put_code(0xc0 + (symbol - 280), 8);
+    put_bits(length - length_base[l], length_extra[l]);
+
+    const size_t d = code_for(distance_base, distance);
+    put_code(d, 5);
+    put_bits(distance - distance_base[d], distance_extra[d]);
+}
+
+void Encoder::put_byte(uint8_t value) {
+    output[output_used++] = value;
+    if (output_used == output_size)
+        flush_output();
+}
+
+void Encoder::flush_output() {
+    if (output_used > 0) {
+        sink(output.data(), output_used);
+        output_used = 0;
+    }
+}
+
+/* Decoder ***************************************************************/
+
+Decoder::Decoder(Source source, bool zlib)
+    : source{std::move(source)},
+      zlib{zlib},
+      state{zlib ? State::Header : State::BlockHeader} {
+}
+
+size_t Decoder::read(void* data, size_t length) {
+    uint8_t* const begin = static_cast<uint8_t*>(data);
+    uint8_t* out = begin;
+    uint8_t* const out_end = begin + length;
+
+    while (out < out_end && !error_) {
+        if (copy_remaining > 0) {
+            put(window[(window_position + window_size - copy_distance) % window_size], out);
+            copy_remaining--;
+            continue;
+        }
+
+        uint32_t v = 0;
+        switch (state) {
+            case State::Header: {
+                uint32_t cmf = 0;
+                uint32_t flg = 0;
+                if (!get_bits(8, cmf) || !get_bits(8, flg))
+                    return out - begin;
+                // Deflate, no preset dictionary.
+                if ((cmf & 0x0f) != 8 || ((cmf << 8) | flg) % 31 != 0 || (flg & 0x20))
+                    fail();
+                state = State::BlockHeader;
+            } break;
+
+            case State::BlockHeader: {
+                if (final_block) {
+                    state = State::Done;
+                    break;
+                }
+
+                uint32_t type = 0;
+                if (!get_bits(1, v) || !get_bits(2, type))
+                    return out - begin;
+                final_block = v;
+
+                if (type == 0) {
+                    // Stored blocks start on a byte boundary.
+                    bits >>= bit_count % 8;
+                    bit_count -= bit_count % 8;
+
+                    uint32_t nlen = 0;
+                    if (!get_bits(16, v) || !get_bits(16, nlen))
+                        return out - begin;
+                    if ((v ^ 0xffff) != nlen)
+                        fail();
+                    stored_remaining = v;
+                    state = State::Stored;
+                } else if (type == 1) {
+                    state = State::Fixed;
+                } else {
+                    // Dynamic Huffman isn't supported.
+                    fail();
+                }
+            } break;
+
+            case State::Stored:
+                if (stored_remaining == 0) {
+                    state = State::BlockHeader;
+                } else if (get_bits(8, v)) {
+                    put(v, out);
+                    stored_remaining--;
+                }
+                break;
+
+            case State::Fixed: {
+                uint32_t symbol = 0;
+                if (!decode_literal_length(symbol))
+                    break;
+
+                if (symbol < 256) {
+                    put(symbol, out);
+                    break;
+                }
+                if (symbol == end_of_block) {
+                    state = State::BlockHeader;
+                    break;
+                }
+
+                const size_t l = symbol - 257;
+                if (l >= length_base.size() || !get_bits(length_extra[l], v)) {
+                    fail();
+                    break;
+                }
+                copy_remaining = length_base[l] + v;
+
+                // 5 bit distance codes, most significant bit first.
+                uint32_t d = 0;
+                for (size_t i = 0; i < 5; i++) {
+                    uint32_t b = 0;
+                    if (!get_bits(1, b))
+                        break;
+                    d = (d << 1) | b;
+                }
+                if (error_ || d >= distance_base.size() || !get_bits(distance_extra[d], v)) {
+                    fail();
+                    break;
+                }
+                copy_distance = distance_base[d] + v;
+                if (copy_distance > window_size)
+                    fail();
+            } break;
+
+            case State::Done:
+                return out - begin;
+        }
+    }
+
+    return out - begin;
+}
+
+bool Decoder::next_byte(uint8_t& value) {
+    if (input_used == input_end) {
+        input_end = source(input.data(), input.size());
+        input_used = 0;
+        if (input_end == 0)
+            return false;
+    }
+
+    value = input[input_used++];
+    return true;
+}
+
+bool Decoder::get_bits(size_t count, uint32_t& value) {
+    while (bit_count < count) {
+        uint8_t b = 0;
+        if (!next_byte(b))
+            return fail();
+        bits |= uint32_t{b} << bit_count;
+        bit_count += 8;
+    }
+
+    value = bits & ((1U << count) - 1);
+    bits >>= count;
+    bit_count -= count;
+    return true;
+}
+
+/* Fixed literal/length codes are 7 to 9 bits, see Encoder::put_literal(). */
+bool Decoder::decode_literal_length(uint32_t& symbol) {
+    uint32_t code = 0;
+    for (size_t length = 1; length <= 9; length++) {
+        uint32_t b = 0;
+        if (!get_bits(1, b))
+            return false;
+        code = (code << 1) | b;
+
+        if (length == 7 && code <= 23) {
+            symbol = 256 + code;
+            return true;
+        }
+        if (length == 8 && code >= 0x30 && code <= 0xbf) {
+            symbol = code - 0x30;
+            return true;
+        }
+        if (length == 8 && code >= 0xc0 && code <= 0xc7) {
+            symbol = 280 + (code - 0xc0);
+            return true;
+        }
+        if (length == 9 && code >= 0x190) {
+            symbol = 144 + (code - 0x190);
+            return true;
+        }
+    }
+
+    return fail();
+}
+
+void Decoder::put(uint8_t value, uint8_t*& out) {
+    *out++ = value;
+    window[window_position] = value;
+    window_position = (window_position + 1) % window_size;
+}
+
+bool Decoder::fail() {
+    error_ = true;
+    state = State::Done;
+    return false;
+}
+
+} /* namespace deflate */
@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __DEFLATE_H__
+#define __DEFLATE_H__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "crc.hpp"
+
+/* Small streaming DEFLATE (RFC 1951) for images written on the M0.
+ *
+ * The encoder emits a single fixed Huffman block and finds matches with a
+ * hash chain over a short window, so it needs about 6 KiB and no tables.
+ * The decoder takes stored and fixed Huffman blocks, enough for anything
+ * the encoder (or the older stored-only PNGWriter) produced, but not the
+ * dynamic Huffman blocks most desktop tools write.
+ */
+namespace deflate {
+
+constexpr size_t window_size = 1024;
+constexpr size_t min_match = 3;
+constexpr size_t max_match = 258;
+
+/* Zlib (RFC 1950) header declaring window_size. */
+constexpr std::array<uint8_t, 2> zlib_header{{0x28, 0x15}};
+
+class Encoder {
+   public:
+    /* Compressed bytes go to sink in pieces of up to output_size. */
+    using Sink = std::function<void(const uint8_t* data, size_t length)>;
+    static constexpr size_t output_size = 1024;
+
+    /* With zlib set, the stream has the zlib header and Adler-32 trailer. */
+    Encoder(Sink sink, bool zlib = true);
+
+    void write(const void* data, size_t length);
+
+    /* Ends the stream and flushes everything to the sink. */
+    void finish();
+
+    /* Drops any unfinished stream and starts a new one to the same sink. */
+    void reset();
+
+   private:
+    static constexpr size_t buffer_size = 2 * window_size;
+    static constexpr size_t hash_size = 1024;
+    static constexpr size_t max_chain = 16;
+
+    Sink sink;
+    bool zlib;
+    bool finished{false};
+    Adler32 adler_32{};
+
+    std::array<uint8_t, buffer_size> buffer{};
+    size_t position{0};
+    size_t end{0};
+    /* Buffer positions + 1 of the latest string per hash and the one
+     * before it per window slot, 0 for none. */
+    std::array<uint16_t, hash_size> head{};
+    std::array<uint16_t, window_size> prev{};
+
+    uint32_t bits{0};
+    size_t bit_count{0};
+    std::array<uint8_t, output_size> output{};
+    size_t output_used{0};
+
+    void compress(bool flush);
+    void slide();
+    void insert(size_t at);
+    size_t find_match(size_t at, size_t& distance) const;
+
+    void put_bits(uint32_t value, size_t count);
+    void put_code(uint32_t code, size_t length);
+    void put_literal(uint8_t value);
+    void put_match(size_t length, size_t distance);
+    void put_byte(uint8_t value);
+    void flush_output();
+};
+
+class Decoder {
+   public:
+    /* Fills data with up to length compressed bytes, returns how many. */
+    using Source = std::function<size_t(uint8_t* data, size_t length)>;
+
+    /* With zlib set, the zlib header is checked and the trailer skipped. */
+    Decoder(Source source, bool zlib = true);
+
+    /* Decompresses up to length bytes into data. Returns fewer at the end of
+     * the stream, check error() to tell a corrupt or unsupported one. */
+    size_t read(void* data, size_t length);
+
+    bool error() const { return error_; }
+
+   private:
+    static constexpr size_t input_size = 256;
+
+    enum class State {
+        Header,
+        BlockHeader,
+        Stored,
+        Fixed,
+        Done,
+    };
+
+    Source source;
+    bool zlib;
+    bool error_{false};
+    bool final_block{false};
+    State state;
+
+    std::array<uint8_t, input_size> input{};
+    size_t input_used{0};
+    size_t input_end{0};
+    uint32_t bits{0};
+    size_t bit_count{0};
+
+    std::array<uint8_t, window_size> window{};
+    size_t window_position{0};
+    size_t stored_remaining{0};
+    size_t copy_remaining{0};
+    size_t copy_distance{0};
+
+    bool next_byte(uint8_t& value);
+    bool get_bits(size_t count, uint32_t& value);
+    bool decode_literal_length(uint32_t& symbol);
+    void put(uint8_t value, uint8_t*& out);
+    bool fail();
+};
+
+} /* namespace deflate */
+
+#endif /*__DEFLATE_H__*/
@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __DELEGATE_H__
+#define __DELEGATE_H__
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/* Callback wrapper for widget handlers, a std::function that never
+ * allocates. The callable is stored inline in room for four pointers
+ * (16 bytes on the M0). A callable that doesn't fit fails to compile; have
+ * it capture a reference or pointer to the larger state instead. Callables
+ * that are trivially copyable, such as the usual [this] or [this, &nav]
+ * lambdas, are copied as plain bytes and need no destructor call.
+ */
+template <typename Signature, size_t Capacity = 4 * sizeof(void*)>
+class Delegate;
+
+template <typename R, typename... Args, size_t Capacity>
+class Delegate<R(Args...), Capacity> {
+    template <typename F>
+    using enable_if_callable = std::enable_if_t<
+        !std::is_same_v<std::decay_t<F>, Delegate> &&
+        !std::is_same_v<std::decay_t<F>, std::nullptr_t> &&
+        std::is_invocable_r_v<R, std::decay_t<F>&, Args...>>;
+
+   public:
+    static constexpr size_t capacity = Capacity;
+
+    Delegate() = default;
+    Delegate(std::nullptr_t) {}
+
+    template <typename F, typename = enable_if_callable<F>>
+    Delegate(F f) {
+        store(std::move(f));
+    }
+
+    Delegate(const Delegate& other) {
+        copy_from(other);
+    }
+
+    Delegate(Delegate&& other) {
+        move_from(other);
+    }
+
+    ~Delegate() {
+        reset();
+    }
+
+    Delegate& operator=(const Delegate& other) {
+        if (this != &other) {
+            reset();
+            copy_from(other);
+        }
+        return *this;
+    }
+
+    Delegate& operator=(Delegate&& other) {
+        if (this != &other) {
+            reset();
+            move_from(other);
+        }
+        return *this;
+    }
+
+    Delegate& operator=(std::nullptr_t) {
+        reset();
+        return *this;
+    }
+
+    template <typename F, typename = enable_if_callable<F>>
+    Delegate& operator=(F f) {
+        reset();
+        store(std::move(f));
+        return *this;
+    }
+
+    explicit operator bool() const {
+        return invoker != nullptr;
+    }
+
+    friend bool operator==(const Delegate& d, std::nullptr_t) { return !d; }
+    friend bool operator==(std::nullptr_t, const Delegate& d) { return !d; }
+    friend bool operator!=(const Delegate& d, std::nullptr_t) { return static_cast<bool>(d); }
+    friend bool operator!=(std::nullptr_t, const Delegate& d) { return static_cast<bool>(d); }
+
+    /* Like std::function, the delegate must not be empty. */
+    R operator()(Args... args) const {
+        return invoker(storage, std::forward<Args>(args)...);
+    }
+
+   private:
+    enum class Operation {
+        Copy,
+        Move,
+        Destroy,
+    };
+
+    using Invoker = R (*)(void*, Args&&...);
+    using Manager = void (*)(Operation, void* dst, void* src);
+
+    alignas(std::max_align_t) mutable unsigned char storage[Capacity];
+    Invoker invoker{nullptr};
+    Manager manager{nullptr};
+
+    template <typename F>
+    static R invoke(void* callable, Args&&... args) {
+        if constexpr (std::is_void_v<R>)
+            std::invoke(*static_cast<F*>(callable), std::forward<Args>(args)...);
+        else
+            return std::invoke(*static_cast<F*>(callable), std::forward<Args>(args)...);
+    }
+
+    template <typename F>
+    static void manage(const Operation operation, void* dst, void* src) {
+        switch (operation) {
+            case Operation::Copy:
+                new (dst) F(*static_cast<const F*>(src));
+                break;
+            case Operation::Move:
+                new (dst) F(std::move(*static_cast<F*>(src)));
+                break;
+            case Operation::Destroy:
+                static_cast<F*>(dst)->~F();
+                break;
+        }
+    }
+
+    /* Empty function pointers and std::functions make an empty delegate. */
+    template <typename F>
+    static bool is_empty(const F& f) {
+        if constexpr (std::is_constructible_v<bool, const F&>)
+            return !static_cast<bool>(f);
+        else
+            return false;
+    }
+
+    template <typename F>
+    void store(F&& f) {
+        static_assert(sizeof(F) <= Capacity, "Callable is too large for a Delegate, capture less or capture by reference");
+        static_assert(alignof(F) <= alignof(std::max_align_t), "Callable is over-aligned for a Delegate");
+
+        if (is_empty(f))
+            return;
+
+        new (storage) F(std::move(f));
+        invoker = &invoke<F>;
+        if constexpr (!(std::is_trivially_copyable_v<F> && std::is_trivially_destructible_v<F>))
+            manager = &manage<F>;
+    }
+
+    void copy_from(const Delegate& other) {
+        if (other.manager)
+            other.manager(Operation::Copy, storage, other.storage);
+        else if (other.invoker)
+            std::memcpy(storage, other.storage, sizeof(storage));
+        invoker = other.invoker;
+        manager = other.manager;
+    }
+
+    void move_from(Delegate& other) {
+        if (other.manager)
+            other.manager(Operation::Move, storage, other.storage);
+        else if (other.invoker)
+            std::memcpy(storage, other.storage, sizeof(storage));
+        invoker = other.invoker;
+        manager = other.manager;
+        other.reset();
+    }
+
+    void reset() {
+        if (manager)
+            manager(Operation::Destroy, storage, nullptr);
+        invoker = nullptr;
+        manager = nullptr;
+    }
+};
+
+#endif /*__DELEGATE_H__*/
@@ -0,0 +1,215 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __DSP_FIR_DESIGN_H__
+#define __DSP_FIR_DESIGN_H__
+
+#include <cstddef>
+#include <cstdint>
+
+#include "dsp_fir_taps.hpp"
+
+/* Compile-time Kaiser windowed-sinc FIR designer.
+ *
+ * Produces the same fir_taps_real<N> / fir_taps_complex<N> structures as the
+ * hand-pasted tables in dsp_fir_taps.hpp, so a processor can declare a filter
+ * for its exact rates:
+ *
+ *   constexpr auto taps_decim_0 = fir_design::decimator_real<24>(3200000, 100000, 4);
+ *
+ * Everything is evaluated by the compiler; a table nobody references never
+ * reaches the image. The tap sum is the filter's DC gain in fixed point:
+ * the decimators in this tree expect 32768, channel filters 65536.
+ */
+namespace fir_design {
+
+namespace detail {
+
+constexpr double pi = 3.14159265358979323846;
+
+/* Taylor series after reducing the argument to [-pi, pi]. */
+constexpr double sin(double x) {
+    while (x > pi) x -= 2 * pi;
+    while (x < -pi) x += 2 * pi;
+
+    const double x2 = x * x;
+    double term = x;
+    double sum = x;
+    for (int n = 1; n < 16; n++) {
+        term *= -x2 / ((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double cos(const double x) {
+    return sin(x + pi / 2);
+}
+
+constexpr double sqrt(const double x) {
+    if (x <= 0) return 0;
+    double r = (x > 1) ? x : 1;
+    for (int i = 0; i < 64; i++) {
+        r = 0.5 * (r + x / r);
+    }
+    return r;
+}
+
+/* Zeroth order modified Bessel function of the first kind. */
+constexpr double bessel_i0(const double x) {
+    const double q = x * x / 4;
+    double term = 1;
+    double sum = 1;
+    for (int k = 1; k < 64; k++) {
+        term *= q / (static_cast<double>(k) * k);
+        sum += term;
+        if (term < sum * 1e-12) break;
+    }
+    return sum;
+}
+
+constexpr int32_t round(const double x) {
+    return static_cast<int32_t>((x < 0) ? (x - 0.5) : (x + 0.5));
+}
+
+/* Kaiser's empirical beta for a given stop band attenuation. */
+constexpr double kaiser_beta(const double attenuation_db) {
+    if (attenuation_db > 50) {
+        return 0.1102 * (attenuation_db - 8.7);
+    } else if (attenuation_db >= 21) {
+        const double a = attenuation_db - 21;
+        /* a^0.4 is the fifth root of a^2, by Newton's method. */
+        double r = 1;
+        for (int i = 0; i < 64; i++) {
+            r = r - (r * r * r * r * r - a * a) / (5 * r * r * r * r);
+        }
+        return 0.5842 * r + 0.07886 * a;
+    }
+    return 0;
+}
+
+/* Windowed ideal low pass of cutoff fc (normalized to fs), unscaled. */
+template <size_t N>
+constexpr void kaiser_lowpass(double (&h)[N], const double fc, const double attenuation_db) {
+    const double beta = kaiser_beta(attenuation_db);
+    const double i0_beta = bessel_i0(beta);
+    const double m = (N - 1) / 2.0;
+
+    for (size_t n = 0; n < N; n++) {
+        const double t = n - m;
+        const double sinc = (t == 0) ? (2 * fc) : (sin(2 * pi * fc * t) / (pi * t));
+        const double r = (m == 0) ? 0 : (t / m);
+        h[n] = sinc * bessel_i0(beta * sqrt(1 - r * r)) / i0_beta;
+    }
+}
+
+}  // namespace detail
+
+/* Kaiser's estimate of the number of taps needed for a transition band of
+ * transition_normalized (relative to fs) at the given attenuation.
+ * Use with static_assert to check a fixed tap count is sufficient.
+ */
+constexpr size_t kaiser_taps_estimate(const float transition_normalized, const float attenuation_db) {
+    return static_cast<size_t>((attenuation_db - 7.95) / (14.36 * transition_normalized)) + 1;
+}
+
+/* Real low pass with pass band edge pass_hz and stop band edge stop_hz. */
+template <size_t N>
+constexpr fir_taps_real<N> lowpass_real(
+    const float sampling_rate,
+    const float pass_hz,
+    const float stop_hz,
+    const float attenuation_db = 60.0f,
+    const int32_t tap_sum = 32768) {
+    double h[N]{};
+    detail::kaiser_lowpass(h, (pass_hz + stop_hz) / 2.0 / sampling_rate, attenuation_db);
+
+    double sum = 0;
+    for (size_t n = 0; n < N; n++) sum += h[n];
+
+    fir_taps_real<N> result{
+        -pass_hz / sampling_rate,
+        pass_hz / sampling_rate,
+        (stop_hz - pass_hz) / sampling_rate,
+        {}};
+    for (size_t n = 0; n < N; n++) {
+        result.taps[n] = static_cast<int16_t>(detail::round(h[n] * tap_sum / sum));
+    }
+    return result;
+}
+
+/* Anti-alias filter for decimating by decimation_factor: everything that
+ * would fold back onto the pass band after decimation is in the stop band.
+ */
+template <size_t N>
+constexpr fir_taps_real<N> decimator_real(
+    const float sampling_rate,
+    const float pass_hz,
+    const size_t decimation_factor,
+    const float attenuation_db = 60.0f,
+    const int32_t tap_sum = 32768) {
+    return lowpass_real<N>(
+        sampling_rate,
+        pass_hz,
+        sampling_rate / decimation_factor - pass_hz,
+        attenuation_db,
+        tap_sum);
+}
+
+/* Complex band pass from low_hz to high_hz (either may be negative), made by
+ * shifting a low pass prototype to the centre of the band.
+ */
+template <size_t N>
+constexpr fir_taps_complex<N> bandpass_complex(
+    const float sampling_rate,
+    const float low_hz,
+    const float high_hz,
+    const float transition_hz,
+    const float attenuation_db = 60.0f,
+    const int32_t tap_sum = 65536) {
+    const double half_width = (high_hz - low_hz) / 2.0;
+    const double center = (high_hz + low_hz) / 2.0 / sampling_rate;
+
+    double h[N]{};
+    detail::kaiser_lowpass(h, (half_width + transition_hz / 2.0) / sampling_rate, attenuation_db);
+
+    double sum = 0;
+    for (size_t n = 0; n < N; n++) sum += h[n];
+
+    fir_taps_complex<N> result{
+        low_hz / sampling_rate,
+        high_hz / sampling_rate,
+        transition_hz / sampling_rate,
+        {}};
+    const double m = (N - 1) / 2.0;
+    for (size_t n = 0; n < N; n++) {
+        const double phase = 2 * detail::pi * center * (n - m);
+        const double k = h[n] * tap_sum / sum;
+        result.taps[n] = {
+            static_cast<int16_t>(detail::round(k * detail::cos(phase))),
+            static_cast<int16_t>(detail::round(k * detail::sin(phase)))};
+    }
+    return result;
+}
+
+}  // namespace fir_design
+
+#endif /*__DSP_FIR_DESIGN_H__*/
@@ -0,0 +1,346 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __INDEXED_LRU_LIST_H__
+#define __INDEXED_LRU_LIST_H__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/* Multiplicative (Fibonacci) hash, good enough for IDs such as ICAO
+ * addresses or MMSIs whose low bits are not uniformly distributed. */
+template <typename Key>
+struct IndexedLRUHash {
+    uint32_t operator()(const Key& key) const {
+        const uint64_t k = static_cast<uint64_t>(key);
+        return static_cast<uint32_t>(k ^ (k >> 32)) * 0x9E3779B1u;
+    }
+};
+
+template <typename A, typename B>
+struct IndexedLRUHash<std::pair<A, B>> {
+    uint32_t operator()(const std::pair<A, B>& key) const {
+        const uint64_t k = (static_cast<uint64_t>(IndexedLRUHash<A>{}(key.first)) << 32) |
+                           IndexedLRUHash<B>{}(key.second);
+        return IndexedLRUHash<uint64_t>{}(k);
+    }
+};
+
+/* Fixed-capacity list of items looked up by T::key() in O(1).
+ * Items live in a preallocated pool, a doubly linked list through the pool
+ * gives the order and an open-addressing table (linear probing, backward
+ * shift deletion) indexes them by key. Nothing is allocated after construction.
+ *
+ * emplace_front() on a full list evicts the back item, so keeping the list
+ * in most-recently-used order (move_to_front) gives LRU eviction.
+ * sort() is an insertion sort, linear when only a few items moved since the
+ * last sort. References stay valid until the item is erased or evicted.
+ * An item's key must not change while it is in the list.
+ */
+template <typename T, size_t Capacity, typename Hash = IndexedLRUHash<typename T::Key>>
+class IndexedLRUList {
+    using index_t = std::conditional_t<(Capacity < 0xff), uint8_t, uint16_t>;
+    static_assert(Capacity > 0 && Capacity < 0xffff, "IndexedLRUList capacity out of range");
+
+    static constexpr index_t none = std::numeric_limits<index_t>::max();
+
+    static constexpr size_t table_bits_for(size_t bits) {
+        return ((size_t{1} << bits) >= Capacity * 2) ? bits : table_bits_for(bits + 1);
+    }
+    static constexpr size_t table_bits = table_bits_for(1);
+    static constexpr size_t table_size = size_t{1} << table_bits;
+    static constexpr size_t table_mask = table_size - 1;
+
+    template <bool Const>
+    class iterator_base {
+       public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+        using list_type = std::conditional_t<Const, const IndexedLRUList, IndexedLRUList>;
+
+        iterator_base() = default;
+        iterator_base(list_type* list, index_t index)
+            : list_{list}, index_{index} {}
+
+        /* iterator converts to const_iterator. */
+        template <bool C = Const, typename = std::enable_if_t<C>>
+        iterator_base(const iterator_base<false>& other)
+            : list_{other.list_}, index_{other.index_} {}
+
+        reference operator*() const { return list_->at(index_); }
+        pointer operator->() const { return &list_->at(index_); }
+
+        iterator_base& operator++() {
+            index_ = list_->links_[index_].next;
+            return *this;
+        }
+        iterator_base operator++(int) {
+            auto old = *this;
+            ++*this;
+            return old;
+        }
+        iterator_base& operator--() {
+            index_ = (index_ == none) ? list_->tail_ : list_->links_[index_].prev;
+            return *this;
+        }
+        iterator_base operator--(int) {
+            auto old = *this;
+            --*this;
+            return old;
+        }
+
+        bool operator==(const iterator_base& other) const { return index_ == other.index_; }
+        bool operator!=(const iterator_base& other) const { return index_ != other.index_; }
+
+       private:
+        list_type* list_{nullptr};
+        index_t index_{none};
+
+        friend class IndexedLRUList;
+        friend class iterator_base<true>;
+    };
+
+   public:
+    using value_type = T;
+    using reference = T&;
+    using const_reference = const T&;
+    using size_type = size_t;
+    using key_type = typename T::Key;
+    using iterator = iterator_base<false>;
+    using const_iterator = iterator_base<true>;
+
+    IndexedLRUList() {
+        clear_index();
+    }
+
+    ~IndexedLRUList() {
+        clear();
+    }
+
+    IndexedLRUList(const IndexedLRUList&) = delete;
+    IndexedLRUList(IndexedLRUList&&) = delete;
+    IndexedLRUList& operator=(const IndexedLRUList&) = delete;
+    IndexedLRUList& operator=(IndexedLRUList&&) = delete;
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    static constexpr size_t max_size() { return Capacity; }
+
+    iterator begin() { return {this, head_}; }
+    iterator end() { return {this, none}; }
+    const_iterator begin() const { return {this, head_}; }
+    const_iterator end() const { return {this, none}; }
+
+    T& front() { return at(head_); }
+    T& back() { return at(tail_); }
+    const T& front() const { return at(head_); }
+    const T& back() const { return at(tail_); }
+
+    iterator find(const key_type& key) {
+        const auto slot = find_slot(key);
+        return {this, (slot == table_size) ? none : slots_[slot]};
+    }
+
+    const_iterator find(const key_type& key) const {
+        const auto slot = find_slot(key);
+        return {this, (slot == table_size) ? none : slots_[slot]};
+    }
+
+    /* Constructs a new item at the front, evicting the back item when full.
+     * The caller ensures no item with the same key is present. */
+    template <typename... Args>
+    T& emplace_front(Args&&... args) {
+        if (size_ == Capacity)
+            pop_back();
+
+        const index_t i = free_;
+        free_ = links_[i].next;
+        new (&storage_[i]) T(std::forward<Args>(args)...);
+
+        link_front(i);
+        index(i);
+        size_++;
+        return at(i);
+    }
+
+    void move_to_front(const iterator it) {
+        if (it.index_ == head_)
+            return;
+        unlink(it.index_);
+        link_front(it.index_);
+    }
+
+    void pop_back() {
+        if (!empty())
+            erase(iterator{this, tail_});
+    }
+
+    /* Returns the iterator following the erased item. */
+    iterator erase(const iterator it) {
+        const index_t i = it.index_;
+        const index_t next = links_[i].next;
+
+        unindex(find_slot(at(i).key()));
+        unlink(i);
+        at(i).~T();
+
+        links_[i].next = free_;
+        free_ = i;
+        size_--;
+        return {this, next};
+    }
+
+    void clear() {
+        for (auto i = head_; i != none; i = links_[i].next)
+            at(i).~T();
+        clear_index();
+    }
+
+    /* Stable insertion sort. */
+    template <typename Compare>
+    void sort(Compare comp) {
+        if (empty())
+            return;
+
+        index_t i = links_[head_].next;
+        while (i != none) {
+            const index_t next = links_[i].next;
+            index_t p = links_[i].prev;
+
+            if (comp(at(i), at(p))) {
+                unlink(i);
+                while (p != none && comp(at(i), at(p)))
+                    p = links_[p].prev;
+
+                if (p == none) {
+                    link_front(i);
+                } else {
+                    link_after(p, i);
+                }
+            }
+            i = next;
+        }
+    }
+
+   private:
+    struct Link {
+        index_t prev;
+        index_t next;
+    };
+
+    std::array<std::aligned_storage_t<sizeof(T), alignof(T)>, Capacity> storage_{};
+    std::array<Link, Capacity> links_{};
+    std::array<index_t, table_size> slots_{};
+    index_t head_{none};
+    index_t tail_{none};
+    index_t free_{0};
+    index_t size_{0};
+
+    T& at(const index_t i) { return *std::launder(reinterpret_cast<T*>(&storage_[i])); }
+    const T& at(const index_t i) const { return *std::launder(reinterpret_cast<const T*>(&storage_[i])); }
+
+    static size_t home_slot(const key_type& key) {
+        return Hash{}(key) >> (32 - table_bits);
+    }
+
+    /* Returns table_size if key is not present. */
+    size_t find_slot(const key_type& key) const {
+        for (size_t s = home_slot(key); slots_[s] != none; s = (s + 1) & table_mask) {
+            if (at(slots_[s]).key() == key)
+                return s;
+        }
+        return table_size;
+    }
+
+    void index(const index_t i) {
+        size_t s = home_slot(at(i).key());
+        while (slots_[s] != none)
+            s = (s + 1) & table_mask;
+        slots_[s] = i;
+    }
+
+    /* Closes the gap so probing never needs tombstones. */
+    void unindex(size_t hole) {
+        for (size_t s = (hole + 1) & table_mask; slots_[s] != none; s = (s + 1) & table_mask) {
+            const size_t home = home_slot(at(slots_[s]).key());
+            if (((s - home) & table_mask) >= ((s - hole) & table_mask)) {
+                slots_[hole] = slots_[s];
+                hole = s;
+            }
+        }
+        slots_[hole] = none;
+    }
+
+    void clear_index() {
+        slots_.fill(none);
+        for (size_t i = 0; i < Capacity; i++)
+            links_[i].next = (i + 1 < Capacity) ? i + 1 : none;
+        head_ = none;
+        tail_ = none;
+        free_ = 0;
+        size_ = 0;
+    }
+
+    void link_front(const index_t i) {
+        links_[i].prev = none;
+        links_[i].next = head_;
+        if (head_ != none)
+            links_[head_].prev = i;
+        else
+            tail_ = i;
+        head_ = i;
+    }
+
+    void link_after(const index_t p, const index_t i) {
+        const index_t n = links_[p].next;
+        links_[i].prev = p;
+        links_[i].next = n;
+        links_[p].next = i;
+        if (n != none)
+            links_[n].prev = i;
+        else
+            tail_ = i;
+    }
+
+    void unlink(const index_t i) {
+        const index_t p = links_[i].prev;
+        const index_t n = links_[i].next;
+        if (p != none)
+            links_[p].next = n;
+        else
+            head_ = n;
+        if (n != none)
+            links_[n].prev = p;
+        else
+            tail_ = p;
+    }
+};
+
+#endif /*__INDEXED_LRU_LIST_H__*/
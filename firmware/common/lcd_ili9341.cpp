@@ -802,6 +802,43 @@ void ILI9341::draw_glyph(
     draw_bitmap(p, glyph.size(), glyph.pixels(), foreground, background, zoom_level);
 }
 
+void ILI9341::draw_glyph_run(
+    const ui::Point p,
+    const RunGlyph* glyphs,
+    const size_t count,
+    const int height,
+    const ui::Color background) {
+    int width = 0;
+    for (size_t i = 0; i < count; i++)
+        width += glyphs[i].width;
+
+    if (width == 0 || height == 0)
+        return;
+
+    lcd_start_ram_write(p, {width, height});
+
+    for (int y = 0; y < height; y++) {
+        ui::Color run_color = background;
+        size_t run_length = 0;
+
+        for (size_t i = 0; i < count; i++) {
+            const auto& glyph = glyphs[i];
+            size_t bit = y * glyph.width;
+            for (size_t x = 0; x < glyph.width; x++, bit++) {
+                const auto color = (glyph.pixels[bit >> 3] & (1U << (bit & 7))) ? glyph.foreground : background;
+                if (color.v != run_color.v) {
+                    io.lcd_write_pixels(run_color, run_length);
+                    run_color = color;
+                    run_length = 0;
+                }
+                run_length++;
+            }
+        }
+
+        io.lcd_write_pixels(run_color, run_length);
+    }
+}
+
 void ILI9341::scroll_set_area(
     const ui::Coord top_y,
     const ui::Coord bottom_y) {
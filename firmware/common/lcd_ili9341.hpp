@@ -106,6 +106,22 @@ class ILI9341 {
         const ui::Color background,
         uint8_t zoom_level = 1);
 
+    /* Glyphs of one height drawn side by side through a single window. Each
+     * scanline goes out as runs of one colour rather than pixel by pixel. */
+    struct RunGlyph {
+        const uint8_t* pixels;
+        uint8_t width;
+        ui::Color foreground;
+    };
+    static constexpr size_t max_glyph_run = 32;
+
+    void draw_glyph_run(
+        const ui::Point p,
+        const RunGlyph* glyphs,
+        const size_t count,
+        const int height,
+        const ui::Color background);
+
     /*** Scrolling ***
      * Scrolling support is implemented in the ILI9341 driver. Basically a region
      * of the screen is set up to act as a circular buffer. The VSA (vertical scroll
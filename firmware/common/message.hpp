@@ -147,6 +147,8 @@ class Message {
         SSTVRXCalibration = 89,
         SubCarData = 90,
         TXDisabled = 91,
+        ChannelizerConfigure = 92,
+        ChannelizerStatistics = 93,
         MAX
     };
 
@@ -757,6 +759,57 @@ class StreamBuffer {
     }
 };
 
+/* Pre-trigger capture. The baseband keeps the most recent stream buffers
+ * instead of handing them over until the trigger fires, then sends the last
+ * pre_trigger_bytes of them followed by the live stream. Once the trigger
+ * drops and post_trigger_bytes more were sent, it flushes and sets done.
+ */
+struct CaptureTrigger {
+    enum class Source : uint8_t {
+        None,     // Continuous capture.
+        Squelch,  // Stream sample power above squelch_db (dBFS).
+        External  // external flag, set by the application.
+    };
+
+    Source source{Source::None};
+    int8_t squelch_db{-40};
+    uint32_t pre_trigger_bytes{0};
+    uint32_t post_trigger_bytes{0};
+    /* Report when the trigger condition comes and goes in annotations, with
+     * or without a source to trigger on. */
+    bool annotate{false};
+    /* The condition only ends once the power stays 3dB below squelch_db, or
+     * external stays clear, for release_bytes. RecordView sets release_ms
+     * worth, which bounds activity events to 1000 / release_ms a second. */
+    static constexpr uint32_t release_ms = 50;
+    uint32_t release_bytes{0};
+
+    /* Shared state, written by one core and polled by the other. */
+    volatile bool external{false};
+    volatile bool done{false};
+};
+
+/* Signal activity seen by the baseband, as byte offsets into the stream it
+ * handed to the application. Written by the baseband, drained by the
+ * application once a second, which capacity covers at the fastest the
+ * activity can come and go.
+ */
+struct CaptureAnnotations {
+    static constexpr size_t capacity = 32;
+    static_assert(capacity > 1000 / CaptureTrigger::release_ms);
+
+    struct Event {
+        uint64_t start;
+        uint64_t end;
+    };
+
+    std::array<Event, capacity> events{};
+    uint32_t write_index{0};
+    /* Activity still in progress, from active_start. */
+    uint64_t active_start{0};
+    bool active{false};
+};
+
 struct CaptureConfig {
     const size_t write_size;
     const size_t buffer_count;
@@ -764,16 +817,21 @@ struct CaptureConfig {
     uint64_t baseband_bytes_dropped;
     FIFO<StreamBuffer*>* fifo_buffers_empty;
     FIFO<StreamBuffer*>* fifo_buffers_full;
+    CaptureTrigger trigger;
+    CaptureAnnotations annotations;
 
-    constexpr CaptureConfig(
+    CaptureConfig(
         const size_t write_size,
-        const size_t buffer_count)
+        const size_t buffer_count,
+        const CaptureTrigger& trigger = {})
         : write_size{write_size},
           buffer_count{buffer_count},
           baseband_bytes_received{0},
           baseband_bytes_dropped{0},
           fifo_buffers_empty{nullptr},
-          fifo_buffers_full{nullptr} {
+          fifo_buffers_full{nullptr},
+          trigger{trigger},
+          annotations{} {
     }
 
     size_t dropped_percent() const {
@@ -781,7 +839,7 @@ struct CaptureConfig {
             return 0;
         } else {
             const size_t percent = baseband_bytes_dropped * 100U / baseband_bytes_received;
-            return std::max(1U, percent);
+            return std::max<size_t>(1, percent);
         }
     }
 };
@@ -799,8 +857,16 @@ class CaptureConfigMessage : public Message {
 
 struct ReplayConfig {
     const size_t read_size;
+    /* Minimum, the baseband adds more buffers when it has the RAM. */
     const size_t buffer_count;
+    size_t buffers_allocated;
     uint64_t baseband_bytes_received;
+    /* Times the baseband ran out of full buffers, and the bytes it missed. */
+    uint32_t underruns;
+    uint64_t baseband_bytes_missed;
+    /* Set by the application once the last buffer is queued, so running dry
+     * at the end of the file isn't counted as an underrun. */
+    volatile bool end_of_stream;
     FIFO<StreamBuffer*>* fifo_buffers_empty;
     FIFO<StreamBuffer*>* fifo_buffers_full;
 
@@ -809,10 +875,23 @@ struct ReplayConfig {
         const size_t buffer_count)
         : read_size{read_size},
           buffer_count{buffer_count},
+          buffers_allocated{0},
           baseband_bytes_received{0},
+          underruns{0},
+          baseband_bytes_missed{0},
+          end_of_stream{false},
           fifo_buffers_empty{nullptr},
           fifo_buffers_full{nullptr} {
     }
+
+    size_t underrun_percent() const {
+        if (baseband_bytes_missed == 0) {
+            return 0;
+        } else {
+            const size_t percent = baseband_bytes_missed * 100U / baseband_bytes_received;
+            return std::max<size_t>(1U, percent);
+        }
+    }
 };
 
 class ReplayConfigMessage : public Message {
@@ -1154,7 +1233,7 @@ class SSTVRXConfigureMessage : public Message {
    public:
     constexpr SSTVRXConfigureMessage(
         const uint8_t code)
-        : Message{id : ID::SSTVRXConfigure},
+        : Message{ID::SSTVRXConfigure},
           code(code) {
     }
 
@@ -1707,4 +1786,40 @@ class TXDisabledMessage : public Message {
     }
 };
 
+class ChannelizerConfigureMessage : public Message {
+   public:
+    constexpr ChannelizerConfigureMessage(
+        const int8_t squelch_db,
+        const uint32_t deviation)
+        : Message{ID::ChannelizerConfigure},
+          squelch_db{squelch_db},
+          deviation{deviation} {
+    }
+
+    int8_t squelch_db;
+    uint32_t deviation;
+};
+
+struct ChannelizerStatistics {
+    static constexpr size_t channel_count = 16;
+    static constexpr uint32_t channel_spacing = 12500;
+    static constexpr uint32_t sampling_rate = 3200000;
+
+    /* Peak channel power in dBFS over the report interval, lowest channel first.
+     * Channel i is centred on (i - channel_count / 2) * channel_spacing. */
+    std::array<int8_t, channel_count> db{};
+    int8_t active_channel{-1};
+};
+
+class ChannelizerStatisticsMessage : public Message {
+   public:
+    constexpr ChannelizerStatisticsMessage(
+        const ChannelizerStatistics& statistics)
+        : Message{ID::ChannelizerStatistics},
+          statistics{statistics} {
+    }
+
+    ChannelizerStatistics statistics;
+};
+
 #endif /*__MESSAGE_H__*/
@@ -21,6 +21,9 @@
 
 #include "png_writer.hpp"
 
+#include <algorithm>
+#include <cstdlib>
+
 static constexpr std::array<uint8_t, 8> png_file_header{{
     0x89,
     0x50,
@@ -56,7 +59,12 @@ static constexpr std::array<uint8_t, 12> png_iend{{
 }};
 
 Optional<File::Error> PNGWriter::create(
-    const std::filesystem::path& filename) {
+    const std::filesystem::path& filename,
+    int width,
+    int height) {
+    this->width = width;
+    this->height = height;
+
     const auto create_error = file.create(filename);
     if (create_error.is_valid()) {
         return create_error;
@@ -91,78 +99,92 @@ Optional<File::Error> PNGWriter::create(
 
     file.write(png_ihdr_dyn);
 
-    write_chunk_header(
-        2 + height * (5 + 1 + width * 3) + 4,
-        png_idat_chunk_type);
-
-    constexpr std::array<uint8_t, 2> zlib_header{0x78, 0x01};  // Zlib CM, CINFO, FLG.
-    write_chunk_content(zlib_header);
+    previous.assign(width * sizeof(ui::ColorRGB888), 0);
+    filtered.resize(1 + previous.size());
+    encoder = std::make_unique<deflate::Encoder>(
+        [this](const uint8_t* data, size_t length) {
+            write_idat(data, length);
+        });
 
     return {};
 }
 
 PNGWriter::~PNGWriter() {
-    write_chunk_content(adler_32.bytes());
-    write_chunk_crc();
+    if (!encoder)
+        return;
 
+    encoder->finish();
     file.write(png_iend);
 }
 
 void PNGWriter::write_scanline(const std::array<ui::ColorRGB888, 240>& scanline) {
-    constexpr uint8_t scanline_filter_type = 0;
-    constexpr uint32_t deflate_block_length = 1 + sizeof(scanline);
-
-    const std::array<uint8_t, 6> deflate_and_scanline_header{
-        static_cast<uint8_t>((scanline_count == (height - 1)) ? 0x01 : 0x00),  // DEFLATE header bits, bfinal=0, btype=00
-        static_cast<uint8_t>((deflate_block_length >> 0) & 0xff),              // Length LSB
-        static_cast<uint8_t>((deflate_block_length >> 8) & 0xff),              // Length MSB
-        static_cast<uint8_t>((deflate_block_length >> 0) & 0xff) ^ 0xff,       // ~Length LSB
-        static_cast<uint8_t>((deflate_block_length >> 8) & 0xff) ^ 0xff,       // ~Length MSB
-        scanline_filter_type,
-    };
-    write_chunk_content(deflate_and_scanline_header);
-
-    adler_32.feed(scanline_filter_type);
-    adler_32.feed(scanline);
-
-    // Small writes to avoid some sort of large-transfer plus block
-    // boundary FatFs or SDC driver bug?
-    write_chunk_content(&scanline[0], 80 * sizeof(ui::ColorRGB888));
-    write_chunk_content(&scanline[80], 80 * sizeof(ui::ColorRGB888));
-    write_chunk_content(&scanline[160], 80 * sizeof(ui::ColorRGB888));
-
-    scanline_count++;
+    write_scanline(scanline.data(), scanline.size());
 }
 
 void PNGWriter::write_scanline(const std::vector<ui::ColorRGB888>& scanline) {
-    constexpr uint8_t scanline_filter_type = 0;
-
-    // Total block length = 1 filter byte + scanline byte length
-    const uint32_t deflate_block_length = 1 + static_cast<uint32_t>(scanline.size() * sizeof(ui::ColorRGB888));
+    write_scanline(scanline.data(), scanline.size());
+}
 
-    const std::array<uint8_t, 6> deflate_and_scanline_header{
-        static_cast<uint8_t>((scanline_count == (height - 1)) ? 0x01 : 0x00),  // Final block?
-        static_cast<uint8_t>(deflate_block_length & 0xff),                     // Length LSB
-        static_cast<uint8_t>((deflate_block_length >> 8) & 0xff),              // Length MSB
-        static_cast<uint8_t>((deflate_block_length & 0xff) ^ 0xff),            // ~Length LSB
-        static_cast<uint8_t>(((deflate_block_length >> 8) & 0xff) ^ 0xff),     // ~Length MSB
-        scanline_filter_type};
-    write_chunk_content(deflate_and_scanline_header);
+void PNGWriter::write_scanline(const ui::ColorRGB888* scanline, size_t count) {
+    if (!encoder || scanline_count >= height)
+        return;
 
-    adler_32.feed(scanline_filter_type);
-    adler_32.feed(scanline);
+    // Short scanlines are padded with black.
+    const auto raw = reinterpret_cast<const uint8_t*>(scanline);
+    const size_t raw_size = std::min(count * sizeof(ui::ColorRGB888), previous.size());
+    auto byte_at = [raw, raw_size](size_t i) -> uint8_t {
+        return (i < raw_size) ? raw[i] : 0;
+    };
 
-    // Chunked writing to avoid large single writes
-    constexpr size_t CHUNK_SIZE = 80;  // Tune for your hardware/filesystem
+    // Pick the filter with the smallest sum of signed residuals, the usual
+    // heuristic: flat areas go to Sub, repeated rows to Up.
+    constexpr size_t bpp = sizeof(ui::ColorRGB888);
+    uint32_t cost_none = 0;
+    uint32_t cost_sub = 0;
+    uint32_t cost_up = 0;
+    for (size_t i = 0; i < previous.size(); i++) {
+        const uint8_t x = byte_at(i);
+        const uint8_t a = (i >= bpp) ? byte_at(i - bpp) : 0;
+        cost_none += std::abs(static_cast<int8_t>(x));
+        cost_sub += std::abs(static_cast<int8_t>(x - a));
+        cost_up += std::abs(static_cast<int8_t>(x - previous[i]));
+    }
 
-    for (size_t i = 0; i < scanline.size(); i += CHUNK_SIZE) {
-        size_t chunk_len = std::min(CHUNK_SIZE, scanline.size() - i);
-        write_chunk_content(&scanline[i], chunk_len * sizeof(ui::ColorRGB888));
+    Filter filter = Filter::None;
+    if (cost_sub < cost_none && cost_sub <= cost_up)
+        filter = Filter::Sub;
+    else if (cost_up < cost_none)
+        filter = Filter::Up;
+
+    filtered[0] = filter;
+    for (size_t i = 0; i < previous.size(); i++) {
+        const uint8_t x = byte_at(i);
+        switch (filter) {
+            case Filter::Sub:
+                filtered[1 + i] = x - ((i >= bpp) ? byte_at(i - bpp) : 0);
+                break;
+            case Filter::Up:
+                filtered[1 + i] = x - previous[i];
+                break;
+            default:
+                filtered[1 + i] = x;
+                break;
+        }
     }
+    encoder->write(filtered.data(), filtered.size());
+
+    for (size_t i = 0; i < previous.size(); i++)
+        previous[i] = byte_at(i);
 
     scanline_count++;
 }
 
+void PNGWriter::write_idat(const uint8_t* data, size_t length) {
+    write_chunk_header(length, png_idat_chunk_type);
+    write_chunk_content(data, length);
+    write_chunk_crc();
+}
+
 void PNGWriter::write_chunk_header(
     const size_t length,
     const std::array<uint8_t, 4>& type) {
@@ -26,30 +26,50 @@
 #include <cstddef>
 #include <string>
 #include <array>
+#include <memory>
+#include <vector>
 
 #include "ui.hpp"
 #include "file.hpp"
 #include "crc.hpp"
+#include "deflate.hpp"
 
+/* Writes 8 bit RGB PNGs a scanline at a time. Each scanline gets the PNG
+ * filter (None, Sub or Up) that leaves it smallest and the image data is
+ * deflate compressed, written out as IDAT chunks of up to 1 KiB. */
 class PNGWriter {
    public:
     ~PNGWriter();
 
-    Optional<File::Error> create(const std::filesystem::path& filename);
+    Optional<File::Error> create(
+        const std::filesystem::path& filename,
+        int width = ui::screen_width,
+        int height = ui::screen_height);
 
     void write_scanline(const std::array<ui::ColorRGB888, 240>& scanline);
     void write_scanline(const std::vector<ui::ColorRGB888>& scanline);
+    void write_scanline(const ui::ColorRGB888* scanline, size_t count);
 
    private:
-    // TODO: These constants are baked in a few places, do not change blithely.
+    enum Filter : uint8_t {
+        None = 0,
+        Sub = 1,
+        Up = 2,
+    };
+
     int width{ui::screen_width};
     int height{ui::screen_height};
 
     File file{};
     int scanline_count{0};
     CRC<32, true, true> crc{0x04c11db7, 0xffffffff, 0xffffffff};
-    Adler32 adler_32{};
 
+    /* Heap allocated, screenshots are taken from deep UI call stacks. */
+    std::unique_ptr<deflate::Encoder> encoder{};
+    std::vector<uint8_t> previous{};
+    std::vector<uint8_t> filtered{};
+
+    void write_idat(const uint8_t* data, size_t length);
     void write_chunk_header(const size_t length, const std::array<uint8_t, 4>& type);
     void write_chunk_content(const void* const p, const size_t count);
 
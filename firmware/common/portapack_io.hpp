@@ -209,22 +209,15 @@ class IO {
         return lcd_read_data();
     }
 
+    /* Bulk writes. The bus is bit-banged (data on GPIO3, WRX on GPIO1), so
+     * DMA can't drive it; these keep the brightness check out of the loop
+     * and unroll it instead. */
     void lcd_write_pixels(ui::Color pixel, size_t n) {
         if (dark_cover_enabled) {
             pixel.v = DARKENED_PIXEL(pixel.v, brightness);
         }
-        while (n--) {
-            lcd_write_data(pixel.v);
-        }
-    }
-
-    void lcd_write_pixels_unrolled8(ui::Color pixel, size_t n) {
-        if (dark_cover_enabled) {
-            pixel.v = DARKENED_PIXEL(pixel.v, brightness);
-        }
-        auto v = pixel.v;
-        n >>= 3;
-        while (n--) {
+        const auto v = pixel.v;
+        for (; n >= 8; n -= 8) {
             lcd_write_data(v);
             lcd_write_data(v);
             lcd_write_data(v);
@@ -234,11 +227,30 @@ class IO {
             lcd_write_data(v);
             lcd_write_data(v);
         }
+        while (n--) {
+            lcd_write_data(v);
+        }
     }
 
-    void lcd_write_pixels(const ui::Color* const pixels, size_t n) {
-        for (size_t i = 0; i < n; i++) {
-            lcd_write_pixel(pixels[i]);
+    void lcd_write_pixels_unrolled8(ui::Color pixel, size_t n) {
+        lcd_write_pixels(pixel, n);
+    }
+
+    void lcd_write_pixels(const ui::Color* pixels, size_t n) {
+        if (dark_cover_enabled) {
+            while (n--) {
+                lcd_write_data(DARKENED_PIXEL((pixels++)->v, brightness));
+            }
+            return;
+        }
+        for (; n >= 4; n -= 4, pixels += 4) {
+            lcd_write_data(pixels[0].v);
+            lcd_write_data(pixels[1].v);
+            lcd_write_data(pixels[2].v);
+            lcd_write_data(pixels[3].v);
+        }
+        while (n--) {
+            lcd_write_data((pixels++)->v);
         }
     }
 
@@ -124,6 +124,7 @@ constexpr image_tag_t image_tag_protoview{'P', 'P', 'V', 'W'};
 constexpr image_tag_t image_tag_wefaxrx{'P', 'W', 'F', 'X'};
 constexpr image_tag_t image_tag_noaaapt_rx{'P', 'N', 'O', 'A'};
 constexpr image_tag_t image_tag_sstv_rx{'P', 'S', 'R', 'X'};
+constexpr image_tag_t image_tag_channelizer{'P', 'C', 'H', 'N'};
 
 constexpr image_tag_t image_tag_noop{'P', 'N', 'O', 'P'};
 
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __UI_DAMAGE_H__
+#define __UI_DAMAGE_H__
+
+#include "ui.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
+namespace ui {
+
+/* Screen areas exposed since the last paint, by widgets being hidden, moved
+ * or removed. Rects are merged when their union covers no more than the two
+ * of them; when the list is full a new rect is merged into the one it grows
+ * the least, so the region may cover a little more than was damaged.
+ */
+template <size_t Capacity>
+class DamageRegion {
+   public:
+    void add(Rect r) {
+        if (r.is_empty())
+            return;
+
+        // Absorb everything r covers or merges cheaply with, r may grow as it does.
+        for (size_t i = 0; i < count;) {
+            if (contains(rects[i], r))
+                return;
+
+            if (contains(r, rects[i]) || area(bounds(r, rects[i])) <= area(r) + area(rects[i])) {
+                r = bounds(r, rects[i]);
+                rects[i] = rects[--count];
+                i = 0;
+            } else {
+                i++;
+            }
+        }
+
+        if (count < Capacity) {
+            rects[count++] = r;
+            return;
+        }
+
+        size_t best = 0;
+        for (size_t i = 1; i < count; i++) {
+            if (growth(rects[i], r) < growth(rects[best], r))
+                best = i;
+        }
+        rects[best] = bounds(rects[best], r);
+    }
+
+    void clear() { count = 0; }
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+
+    const Rect* begin() const { return rects.data(); }
+    const Rect* end() const { return rects.data() + count; }
+
+    static bool contains(const Rect& outer, const Rect& inner) {
+        return inner.left() >= outer.left() && inner.right() <= outer.right() &&
+               inner.top() >= outer.top() && inner.bottom() <= outer.bottom();
+    }
+
+    static bool overlaps(const Rect& a, const Rect& b) {
+        return a.left() < b.right() && b.left() < a.right() &&
+               a.top() < b.bottom() && b.top() < a.bottom();
+    }
+
+   private:
+    std::array<Rect, Capacity> rects{};
+    size_t count{0};
+
+    static int area(const Rect& r) {
+        return r.width() * r.height();
+    }
+
+    static Rect bounds(const Rect& a, const Rect& b) {
+        const int left = std::min(a.left(), b.left());
+        const int top = std::min(a.top(), b.top());
+        return {left, top,
+                std::max(a.right(), b.right()) - left,
+                std::max(a.bottom(), b.bottom()) - top};
+    }
+
+    static int growth(const Rect& r, const Rect& added) {
+        return area(bounds(r, added)) - area(r);
+    }
+};
+
+} /* namespace ui */
+
+#endif /*__UI_DAMAGE_H__*/
@@ -24,6 +24,9 @@
 
 #include "ui_widget.hpp"
 
+#include <algorithm>
+#include <array>
+
 #include "portapack.hpp"
 using namespace portapack;
 
@@ -38,6 +41,8 @@ Style Style::invert() const {
 
 int Painter::draw_char(Point p, const Style& style, char c, uint8_t zoom_level) {
     const auto glyph = style.font.glyph(c);
+    if (!clip_allows({p, {glyph.w() * zoom_level, glyph.h() * zoom_level}}))
+        return glyph.advance().x() * zoom_level;
 
     display.draw_glyph(p, glyph, style.foreground, style.background, zoom_level);
 
@@ -58,6 +63,38 @@ int Painter::draw_string(
     size_t width = 0;
     Color pen = foreground;
 
+    // On-screen glyphs are batched into runs sharing one LCD window.
+    std::array<lcd::ILI9341::RunGlyph, lcd::ILI9341::max_glyph_run> run;
+    size_t run_count = 0;
+    int run_height = 0;
+    Point run_p = p;
+
+    auto flush = [&]() {
+        if (run_count)
+            display.draw_glyph_run(run_p, run.data(), run_count, run_height, background);
+        run_count = 0;
+    };
+
+    // Magenta backgrounds are transparent, those go pixel by pixel.
+    const bool transparent = (background.v == Color::magenta().v);
+
+    // Glyphs share one clip check over the whole string.
+    if (!clip_.is_empty()) {
+        int text_width = 0;
+        int text_height = 0;
+        for (size_t i = 0; i < text.size(); i++) {
+            if (text[i] == '\x1B') {
+                i++;
+            } else {
+                const auto glyph = font.glyph(text[i]);
+                text_width += glyph.advance().x();
+                text_height = std::max<int>(text_height, glyph.h());
+            }
+        }
+        if (!clip_allows({p, {text_width, text_height}}))
+            return text_width;
+    }
+
     for (auto c : text) {
         if (escape) {
             if (c < std::size(term_colors))
@@ -70,13 +107,30 @@ int Painter::draw_string(
                 escape = true;
             } else {
                 const auto glyph = font.glyph(c);
-                display.draw_glyph(p, glyph, pen, background);
+                const bool on_screen = p.x() >= 0 && p.y() >= 0 &&
+                                       p.x() + glyph.w() <= screen_width &&
+                                       p.y() + glyph.h() <= screen_height;
+
+                if (transparent || !on_screen) {
+                    flush();
+                    display.draw_glyph(p, glyph, pen, background);
+                } else {
+                    if (run_count == run.size() || (run_count && glyph.h() != run_height))
+                        flush();
+                    if (run_count == 0) {
+                        run_p = p;
+                        run_height = glyph.h();
+                    }
+                    run[run_count++] = {glyph.pixels(), static_cast<uint8_t>(glyph.w()), pen};
+                }
+
                 const auto advance = glyph.advance();
                 p += advance;
                 width += advance.x();
             }
         }
     }
+    flush();
 
     return width;
 }
@@ -86,15 +140,18 @@ void Painter::draw_bitmap(Point p, const Bitmap& bitmap, Color foreground, Color
     if ((background.v == ui::Color::white().v) && (foreground.to_greyscale() > 146))
         foreground = foreground.dark();
 
+    if (!clip_allows({p, bitmap.size}))
+        return;
+
     display.draw_bitmap(p, bitmap.size, bitmap.data, foreground, background);
 }
 
 void Painter::draw_hline(Point p, int width, Color c) {
-    display.fill_rectangle({p, {width, 1}}, c);
+    display.fill_rectangle(clipped({p, {width, 1}}), c);
 }
 
 void Painter::draw_vline(Point p, int height, Color c) {
-    display.fill_rectangle({p, {1, height}}, c);
+    display.fill_rectangle(clipped({p, {1, height}}), c);
 }
 
 void Painter::draw_rectangle(Rect r, Color c) {
@@ -105,20 +162,83 @@ void Painter::draw_rectangle(Rect r, Color c) {
 }
 
 void Painter::fill_rectangle(Rect r, Color c) {
-    display.fill_rectangle(r, c);
+    display.fill_rectangle(clipped(r), c);
 }
 
 void Painter::fill_rectangle_unrolled8(Rect r, Color c) {
-    display.fill_rectangle_unrolled8(r, c);
+    display.fill_rectangle_unrolled8(clipped(r), c);
+}
+
+bool Painter::clip_allows(Rect r) {
+    if (clip_.is_empty() || Damage::contains(clip_, r))
+        return true;
+
+    if (Damage::overlaps(clip_, r))
+        clip_overflow_ = true;
+    return false;
 }
 
 void Painter::paint_widget_tree(Widget* w) {
     if (ui::is_dirty()) {
+        for (const auto& r : ui::damage())
+            repair_damage(w, r);
+        ui::damage().clear();
+
         paint_widget(w);
         ui::dirty_clear();
     }
 }
 
+void Painter::repair_damage(Widget* root, const Rect& damaged) {
+    // The topmost, deepest widget covering the whole area repaints it...
+    Widget* container = root;
+    for (bool descended = true; descended;) {
+        descended = false;
+        const auto& children = container->children();
+        for (auto it = children.rbegin(); it != children.rend(); ++it) {
+            auto child = *it;
+            if (!child->hidden() && child->visible() && Damage::contains(child->screen_rect(), damaged)) {
+                container = child;
+                descended = true;
+                break;
+            }
+        }
+    }
+
+    // ...unless it, or a parent, is going to repaint entirely anyway.
+    for (auto w = container; w; w = w->parent()) {
+        if (w->dirty())
+            return;
+    }
+
+    clip_ = damaged;
+    clip_overflow_ = false;
+    container->paint(*this);
+    clip_ = {};
+
+    if (clip_overflow_) {
+        container->set_dirty();
+        return;
+    }
+
+    // Then the children under it, and the later (higher) siblings those overlap.
+    Damage exposed{};
+    exposed.add(damaged);
+    for (const auto child : container->children()) {
+        if (child->hidden())
+            continue;
+
+        const auto r = child->screen_rect();
+        for (const auto& e : exposed) {
+            if (Damage::overlaps(r, e)) {
+                child->set_dirty();
+                exposed.add(r);
+                break;
+            }
+        }
+    }
+}
+
 void Painter::paint_widget(Widget* w) {
     if (w->hidden()) {
         // Mark widget (and all children) as invisible.
@@ -81,12 +81,27 @@ class Painter {
     void fill_rectangle(Rect r, Color c);
     void fill_rectangle_unrolled8(Rect r, Color c);
 
+    /* Repairs the damaged screen areas, then paints the dirty widgets. */
     void paint_widget_tree(Widget* w);
 
     void draw_hline(Point p, int width, Color c);
     void draw_vline(Point p, int height, Color c);
 
    private:
+    /* While repairing damage, rectangle fills are clipped to this. Glyphs
+     * and bitmaps can't be; ones reaching out of it are skipped and flag
+     * clip_overflow_, so the repair repaints the whole container instead. */
+    Rect clip_{};
+    bool clip_overflow_{false};
+
+    Rect clipped(Rect r) const {
+        return clip_.is_empty() ? r : r.intersect(clip_);
+    }
+
+    /* Whether unclippable output covering r can be drawn. */
+    bool clip_allows(Rect r);
+
+    void repair_damage(Widget* root, const Rect& damaged);
     void paint_widget(Widget* w);
 };
 
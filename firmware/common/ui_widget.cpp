@@ -43,6 +43,7 @@ using namespace rtc_time;
 namespace ui {
 
 static bool ui_dirty = true;
+static Damage ui_damage{};
 
 void dirty_set() {
     ui_dirty = true;
@@ -56,6 +57,15 @@ bool is_dirty() {
     return ui_dirty;
 }
 
+void dirty_rect(const Rect& r) {
+    ui_damage.add(r);
+    dirty_set();
+}
+
+Damage& damage() {
+    return ui_damage;
+}
+
 /* Widget ****************************************************************/
 
 const std::vector<Widget*> Widget::no_children{};
@@ -77,6 +87,10 @@ Rect Widget::parent_rect() const {
 }
 
 void Widget::set_parent_rect(const Rect new_parent_rect) {
+    // Whatever the new rect doesn't cover shows through again.
+    if (flags.visible && parent_ && !Damage::contains(new_parent_rect, _parent_rect))
+        dirty_rect(screen_rect());
+
     _parent_rect = new_parent_rect;
     set_dirty();
 }
@@ -92,7 +106,8 @@ void Widget::set_parent(Widget* const widget) {
 
     if (parent_ && !widget) {
         // We have a parent, but are losing it. Update visible status.
-        dirty_overlapping_children_in_rect(screen_rect());
+        if (flags.visible)
+            dirty_rect(screen_rect());
         visible(false);
     }
 
@@ -126,10 +141,9 @@ void Widget::hidden(bool hide) {
 
         // If parent is hidden, either of these is a no-op.
         if (hide) {
-            // TODO: Instead of dirtying parent entirely, dirty only children
-            // that overlap with this widget.
-
-            // parent()->dirty_overlapping_children_in_rect(parent_rect());
+            // Repaint what was underneath, not the whole parent.
+            if (flags.visible && parent_)
+                dirty_rect(screen_rect());
 
             /* TODO: Notify self and all non-hidden children that they're
              * now effectively hidden?
@@ -380,7 +394,8 @@ Text::Text(
 }
 
 void Text::set(std::string_view value) {
-    text = std::string{value};
+    // Reuses the string's buffer, so steady updates don't allocate.
+    text.assign(value.data(), value.size());
     set_dirty();
 }
 
@@ -3072,7 +3087,7 @@ VuMeter::VuMeter(
       LEDs_{LEDs},
       show_max_{show_max} {
     // set_focusable(false);
-    LED_height = std::max(1UL, parent_rect.size().height() / LEDs);
+    LED_height = std::max<uint32_t>(1, parent_rect.size().height() / LEDs);
     split = 256 / LEDs;
 }
 
@@ -28,12 +28,14 @@
 #include "ui.hpp"
 #include "ui_text.hpp"
 #include "ui_painter.hpp"
+#include "ui_damage.hpp"
 #include "ui_focus.hpp"
 #include "rtc_time.hpp"
 #include "radio.hpp"
 
 #include "portapack.hpp"
 #include "utility.hpp"
+#include "delegate.hpp"
 
 #include "ui/ui_font_fixed_5x8.hpp"
 
@@ -49,6 +51,11 @@ void dirty_set();
 void dirty_clear();
 bool is_dirty();
 
+/* Screen areas to repair on the next paint, see Painter::paint_widget_tree(). */
+using Damage = DamageRegion<8>;
+void dirty_rect(const Rect& r);
+Damage& damage();
+
 class Context {
    public:
     FocusManager& focus_manager() {
@@ -378,7 +385,7 @@ class Console : public Widget {
 
 class Checkbox : public Widget {
    public:
-    std::function<void(Checkbox&, bool)> on_select{};
+    Delegate<void(Checkbox&, bool)> on_select{};
 
     Checkbox(Point parent_pos, size_t length, std::string text, bool small);
     Checkbox(
@@ -418,11 +425,11 @@ class Checkbox : public Widget {
 
 class Button : public Widget {
    public:
-    std::function<void(Button&)> on_select{};
-    std::function<void(Button&)> on_touch_release{};  // Executed when releasing touch, after on_select.
-    std::function<void(Button&)> on_touch_press{};    // Executed when touching, before on_select.
-    std::function<bool(Button&, KeyEvent)> on_dir{};
-    std::function<void(Button&)> on_highlight{};
+    Delegate<void(Button&)> on_select{};
+    Delegate<void(Button&)> on_touch_release{};  // Executed when releasing touch, after on_select.
+    Delegate<void(Button&)> on_touch_press{};    // Executed when touching, before on_select.
+    Delegate<bool(Button&, KeyEvent)> on_dir{};
+    Delegate<void(Button&)> on_highlight{};
 
     Button(Rect parent_rect, std::string text, bool instant_exec);  // instant_exec: Execute on_select when you touching instead of releasing
     Button(
@@ -454,11 +461,11 @@ class Button : public Widget {
 
 class ButtonWithEncoder : public Widget {
    public:
-    std::function<void(ButtonWithEncoder&)> on_select{};
-    std::function<void(ButtonWithEncoder&)> on_touch_release{};  // Executed when releasing touch, after on_select.
-    std::function<void(ButtonWithEncoder&)> on_touch_press{};    // Executed when touching, before on_select.
-    std::function<bool(ButtonWithEncoder&, KeyEvent)> on_dir{};
-    std::function<void(ButtonWithEncoder&)> on_highlight{};
+    Delegate<void(ButtonWithEncoder&)> on_select{};
+    Delegate<void(ButtonWithEncoder&)> on_touch_release{};  // Executed when releasing touch, after on_select.
+    Delegate<void(ButtonWithEncoder&)> on_touch_press{};    // Executed when touching, before on_select.
+    Delegate<bool(ButtonWithEncoder&, KeyEvent)> on_dir{};
+    Delegate<void(ButtonWithEncoder&)> on_highlight{};
 
     ButtonWithEncoder(Rect parent_rect, std::string text, bool instant_exec);  // instant_exec: Execute on_select when you touching instead of releasing
     ButtonWithEncoder(
@@ -471,7 +478,7 @@ class ButtonWithEncoder : public Widget {
         : ButtonWithEncoder{{}, {}} {
     }
 
-    std::function<void()> on_change{};
+    Delegate<void()> on_change{};
 
     void set_text(const std::string value);
     int32_t get_encoder_delta();
@@ -498,10 +505,10 @@ class ButtonWithEncoder : public Widget {
 
 class NewButton : public Widget {
    public:
-    std::function<void(void)> on_select{};
+    Delegate<void(void)> on_select{};
     // std::function<void(NewButton&)> on_select{};
-    std::function<bool(NewButton&, KeyEvent)> on_dir{};
-    std::function<void(NewButton&)> on_highlight{};
+    Delegate<bool(NewButton&, KeyEvent)> on_dir{};
+    Delegate<void(NewButton&)> on_highlight{};
 
     NewButton(const NewButton&) = delete;
     NewButton& operator=(const NewButton&) = delete;
@@ -572,7 +579,7 @@ class Image : public Widget {
 
 class ImageButton : public Image {
    public:
-    std::function<void(ImageButton&)> on_select{};
+    Delegate<void(ImageButton&)> on_select{};
 
     ImageButton(
         const Rect parent_rect,
@@ -590,7 +597,7 @@ class ImageButton : public Image {
 /* A button that toggles between two images when set. */
 class ImageToggle : public ImageButton {
    public:
-    std::function<void(bool value)> on_change{};
+    Delegate<void(bool value)> on_change{};
 
     ImageToggle(
         Rect parent_rect,
@@ -639,8 +646,8 @@ class ImageOptionsField : public Widget {
     using option_t = std::pair<const Bitmap*, value_t>;
     using options_t = std::vector<option_t>;
 
-    std::function<void(size_t, value_t)> on_change{};
-    std::function<void(void)> on_show_options{};
+    Delegate<void(size_t, value_t)> on_change{};
+    Delegate<void(void)> on_show_options{};
 
     ImageOptionsField(
         Rect parent_rect,
@@ -683,8 +690,8 @@ class OptionsField : public Widget {
     using option_t = std::pair<name_t, value_t>;
     using options_t = std::vector<option_t>;
 
-    std::function<void(size_t, value_t)> on_change{};
-    std::function<void(void)> on_show_options{};
+    Delegate<void(size_t, value_t)> on_change{};
+    Delegate<void(void)> on_show_options{};
 
     OptionsField(Point parent_pos, size_t length, options_t options, bool centered = false);
 
@@ -772,9 +779,9 @@ class TextEdit : public Widget {
 
 class TextField : public Text {
    public:
-    std::function<void(TextField&)> on_select{};
-    std::function<void(TextField&)> on_change{};
-    std::function<void(TextField&, EncoderEvent)> on_encoder_change{};
+    Delegate<void(TextField&)> on_select{};
+    Delegate<void(TextField&)> on_change{};
+    Delegate<void(TextField&, EncoderEvent)> on_encoder_change{};
 
     TextField(Rect parent_rect, std::string text);
 
@@ -794,7 +801,7 @@ class TextField : public Text {
 
 class BatteryTextField : public Widget {
    public:
-    std::function<void()> on_select{};
+    Delegate<void()> on_select{};
 
     BatteryTextField(Rect parent_rect, uint8_t percent);
     void paint(Painter& painter) override;
@@ -822,7 +829,7 @@ class BatteryTextField : public Widget {
 
 class BatteryIcon : public Widget {
    public:
-    std::function<void()> on_select{};
+    Delegate<void()> on_select{};
 
     BatteryIcon(Rect parent_rect, uint8_t percent);
     void paint(Painter& painter) override;
@@ -842,9 +849,9 @@ class BatteryIcon : public Widget {
 
 class NumberField : public Widget {
    public:
-    std::function<void(NumberField&)> on_select{};
-    std::function<void(int32_t)> on_change{};
-    std::function<void(int32_t)> on_wrap{};
+    Delegate<void(NumberField&)> on_select{};
+    Delegate<void(int32_t)> on_change{};
+    Delegate<void(int32_t)> on_wrap{};
 
     using range_t = std::pair<int32_t, int32_t>;
 
@@ -888,7 +895,7 @@ class NumberField : public Widget {
 /* A widget that allows for character-by-character editing of its value. */
 class SymField : public Widget {
    public:
-    std::function<void(SymField&)> on_change{};
+    Delegate<void(SymField&)> on_change{};
 
     enum class Type {
         Custom,
@@ -977,7 +984,7 @@ class SymField : public Widget {
 
 class Waveform : public Widget {
    public:
-    std::function<void(Waveform&)> on_select{};
+    Delegate<void(Waveform&)> on_select{};
 
     Waveform(Rect parent_rect, int16_t* data, uint32_t length, uint32_t offset, bool digital, Color color, bool clickable = false);
 
@@ -1019,7 +1026,7 @@ class Waveform : public Widget {
 
 class GraphEq : public Widget {
    public:
-    std::function<void(GraphEq&)> on_select{};
+    Delegate<void(GraphEq&)> on_select{};
 
     GraphEq(Rect parent_rect, bool clickable = false);
     GraphEq(const GraphEq&) = delete;
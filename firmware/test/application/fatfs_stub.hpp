@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __FATFS_STUB_H
+#define __FATFS_STUB_H
+
+#include "ff.h"
+
+#include <cstddef>
+
+/* Lets tests steer and observe the FatFs stubs in linker_stubs.cpp.
+ * Files opened through the stubs live on a fake volume whose data area
+ * starts at volume_database with one sector per cluster. */
+struct FatFsStub {
+    static constexpr DWORD volume_database = 1000;
+    static constexpr DWORD file_cluster = 10;
+
+    FRESULT expand_result{FR_OK};
+
+    size_t disk_writes{0};
+    DWORD disk_write_sector{0};
+    size_t disk_write_sectors{0};
+
+    size_t f_writes{0};
+    size_t f_write_bytes{0};
+    size_t truncates{0};
+
+    void reset() { *this = {}; }
+};
+
+extern FatFsStub fatfs_stub;
+
+#endif /*__FATFS_STUB_H*/
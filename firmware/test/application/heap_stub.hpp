@@ -0,0 +1,37 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __HEAP_STUB_H
+#define __HEAP_STUB_H
+
+#include <cstddef>
+
+/* The tests allocate through chibios_cpp.cpp and ChibiOS' own chheap.c, as
+ * the firmware does. The memory core behind the default heap is a static
+ * pool, see linker_stubs.cpp. */
+namespace heap_stub {
+
+/* Bytes taken from the default heap and not yet freed. */
+size_t used();
+
+} /* namespace heap_stub */
+
+#endif /*__HEAP_STUB_H*/
@@ -26,16 +26,86 @@
  * will not or cannot work (e.g. filesystem). We could build abstractions
  * but that's just device overhead that only supports testing. */
 
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
 #include <string>
 
+/* ChibiOS kernel stubs, enough for chheap.c and chibios_cpp.cpp */
+#include "ch.h"
+#include "heap_stub.hpp"
+
+ReadyList rlist{};
+static Thread stub_thread{};
+
+static constexpr size_t core_size = 64 * 1024 * 1024;
+alignas(16) static uint8_t core[core_size];
+static size_t core_used = 0;
+
+// Only chibios::heap_size() reads these, which the tests don't use.
+uint8_t __heap_base__[1];
+uint8_t __heap_end__[1];
+
+// Before any static constructor allocates.
+__attribute__((constructor(101))) static void stub_kernel_init() {
+    rlist.r_current = &stub_thread;
+    _heap_init();
+}
+
+void* chCoreAlloc(size_t size) {
+    size = MEM_ALIGN_NEXT(size);
+    if (size > core_size - core_used)
+        return nullptr;
+    void* p = &core[core_used];
+    core_used += size;
+    return p;
+}
+size_t chCoreStatus(void) {
+    return core_size - core_used;
+}
+void chMtxInit(Mutex*) {}
+void chMtxLock(Mutex*) {}
+Mutex* chMtxUnlock(void) {
+    return nullptr;
+}
+void chDbgPanic(const char* msg) {
+    std::fprintf(stderr, "panic: %s\n", msg);
+    std::abort();
+}
+
+size_t heap_stub::used() {
+    size_t heap_free = 0;
+    chHeapStatus(nullptr, &heap_free);
+    return core_used - heap_free;
+}
+
 /* FatFS stubs */
 #include "ff.h"
+#include "diskio.h"
+#include "fatfs_stub.hpp"
+FatFsStub fatfs_stub{};
+static FATFS stub_volume{};
+DRESULT disk_write(BYTE, const BYTE*, DWORD sector, UINT count) {
+    fatfs_stub.disk_writes++;
+    fatfs_stub.disk_write_sector = sector;
+    fatfs_stub.disk_write_sectors += count;
+    return RES_OK;
+}
+int ff_req_grant(_SYNC_t) {
+    return 1;
+}
+void ff_rel_grant(_SYNC_t) {}
 FRESULT f_close(FIL*) {
     return FR_OK;
 }
 FRESULT f_closedir(DIR*) {
     return FR_OK;
 }
+FRESULT f_expand(FIL* fp, FSIZE_t size, BYTE) {
+    if (fatfs_stub.expand_result == FR_OK)
+        fp->obj.objsize = size;
+    return fatfs_stub.expand_result;
+}
 FRESULT f_findfirst(DIR*, FILINFO*, const TCHAR*, const TCHAR*) {
     return FR_OK;
 }
@@ -45,13 +115,20 @@ FRESULT f_findnext(DIR*, FILINFO*) {
 FRESULT f_getfree(const TCHAR*, DWORD*, FATFS**) {
     return FR_OK;
 }
-FRESULT f_lseek(FIL*, FSIZE_t) {
+FRESULT f_lseek(FIL* fp, FSIZE_t offset) {
+    fp->fptr = offset;
     return FR_OK;
 }
 FRESULT f_mkdir(const TCHAR*) {
     return FR_OK;
 }
-FRESULT f_open(FIL*, const TCHAR*, BYTE) {
+FRESULT f_open(FIL* fp, const TCHAR*, BYTE) {
+    stub_volume.database = FatFsStub::volume_database;
+    stub_volume.csize = 1;
+    fp->obj.fs = &stub_volume;
+    fp->obj.sclust = FatFsStub::file_cluster;
+    fp->obj.objsize = 0;
+    fp->fptr = 0;
     return FR_OK;
 }
 FRESULT f_read(FIL*, void*, UINT, UINT*) {
@@ -66,13 +143,21 @@ FRESULT f_stat(const TCHAR*, FILINFO*) {
 FRESULT f_sync(FIL*) {
     return FR_OK;
 }
-FRESULT f_truncate(FIL*) {
+FRESULT f_truncate(FIL* fp) {
+    fatfs_stub.truncates++;
+    fp->obj.objsize = fp->fptr;
     return FR_OK;
 }
 FRESULT f_unlink(const TCHAR*) {
     return FR_OK;
 }
-FRESULT f_write(FIL*, const void*, UINT, UINT*) {
+FRESULT f_write(FIL* fp, const void*, UINT btw, UINT* bw) {
+    fatfs_stub.f_writes++;
+    fatfs_stub.f_write_bytes += btw;
+    fp->fptr += btw;
+    if (fp->fptr > fp->obj.objsize)
+        fp->obj.objsize = fp->fptr;
+    *bw = btw;
     return FR_OK;
 }
 
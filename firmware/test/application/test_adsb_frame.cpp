@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "adsb_frame.hpp"
+
+using namespace adsb;
+
+namespace {
+
+// DF17 airborne identification frame from a real capture.
+constexpr uint8_t df17_frame[14] = {0x8D, 0x48, 0x40, 0xD6, 0x20, 0x2C, 0xC3, 0x71, 0xC3, 0x2C, 0xE0, 0x57, 0x60, 0x98};
+
+ADSBFrame make_frame(const uint8_t* data, size_t length) {
+    ADSBFrame frame{};
+    for (size_t i = 0; i < length; i++)
+        frame.push_byte(data[i]);
+    return frame;
+}
+
+}  // namespace
+
+TEST_SUITE_BEGIN("ADSBFrame");
+
+TEST_CASE("A valid DF17 frame passes the CRC check.") {
+    auto frame = make_frame(df17_frame, 14);
+    CHECK(frame.check_CRC() == 0);
+    CHECK(frame.correct_single_bit_error());
+}
+
+TEST_CASE("Any single flipped bit outside the DF field is repaired.") {
+    for (size_t i = 5; i < 112; i++) {
+        auto frame = make_frame(df17_frame, 14);
+        frame.get_raw_data()[i >> 3] ^= (0x80 >> (i & 7));
+        REQUIRE(frame.check_CRC() != 0);
+
+        CHECK(frame.correct_single_bit_error());
+        CHECK(frame.check_CRC() == 0);
+        CHECK(memcmp(frame.get_raw_data(), df17_frame, 14) == 0);
+    }
+}
+
+TEST_CASE("Frames whose parity is overlaid with the address are not touched.") {
+    // DF11 all-call reply, parity XORed with the interrogator code.
+    const uint8_t df11_frame[7] = {0x5D, 0x48, 0x40, 0xD6, 0x12, 0x34, 0x56};
+    auto frame = make_frame(df11_frame, 7);
+    CHECK_FALSE(frame.correct_single_bit_error());
+    CHECK(memcmp(frame.get_raw_data(), df11_frame, 7) == 0);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "database_index.hpp"
+#include "mock_file.hpp"
+
+#include <cstdio>
+#include <string>
+
+using namespace database_index;
+
+namespace {
+
+/* count 6 digit hex keys in 7 byte items, then 4 byte records holding the record number. */
+std::string make_db(size_t count, size_t step = 3) {
+    std::string index;
+    std::string records;
+    for (size_t i = 0; i < count; i++) {
+        char key[8];
+        std::snprintf(key, sizeof(key), "%06X", (unsigned)(i * step + 1));
+        index.append(key, 7);
+        records.append(reinterpret_cast<const char*>(&i), 4);
+    }
+    return index + records;
+}
+
+std::string key_for(size_t i, size_t step = 3) {
+    char key[8];
+    std::snprintf(key, sizeof(key), "%06X", (unsigned)(i * step + 1));
+    return key;
+}
+
+}  // namespace
+
+TEST_SUITE_BEGIN("database_index");
+
+TEST_CASE("Keys compare like the original lookup.") {
+    CHECK_EQ(compare_key("AAL\0", 4, "AAL"), 0);
+    CHECK_LT(compare_key("AA\0\0", 4, "AAL"), 0);
+    CHECK_GT(compare_key("AAM\0", 4, "AAL"), 0);
+    CHECK_EQ(compare_key("ABCDEF\0", 7, "ABC"), 0);
+    CHECK_GT(compare_key("\xf0XX\0", 4, "AAL"), 0);
+}
+
+TEST_CASE("Every key is found.") {
+    const size_t count = 5000;
+    MockFile f{make_db(count)};
+    BlockCache cache;
+    TableIndex index{0, 7, 4};
+    REQUIRE(index.load(f));
+    CHECK_EQ(index.record_count(), count);
+
+    for (size_t i = 0; i < count; i++) {
+        auto found = index.find(f, cache, key_for(i));
+        REQUIRE_EQ(found, (int32_t)i);
+
+        uint32_t value = 0;
+        f.seek(index.record_offset(found));
+        f.read(&value, sizeof(value));
+        CHECK_EQ(value, i);
+    }
+}
+
+TEST_CASE("Missing keys are not found.") {
+    MockFile f{make_db(3000)};
+    BlockCache cache;
+    TableIndex index{0, 7, 4};
+    REQUIRE(index.load(f));
+
+    CHECK_EQ(index.find(f, cache, "000000"), TableIndex::not_found);
+    CHECK_EQ(index.find(f, cache, "000002"), TableIndex::not_found);
+    CHECK_EQ(index.find(f, cache, "FFFFFF"), TableIndex::not_found);
+    CHECK_EQ(index.find(f, cache, ""), TableIndex::not_found);
+}
+
+TEST_CASE("Repeated lookups come from the cache.") {
+    MockFile f{make_db(20000)};
+    BlockCache cache;
+    TableIndex index{0, 7, 4};
+    REQUIRE(index.load(f));
+
+    REQUIRE_EQ(index.find(f, cache, key_for(12345)), 12345);
+    CHECK_LE(cache.misses, 2);
+
+    const auto misses = cache.misses;
+    REQUIRE_EQ(index.find(f, cache, key_for(12345)), 12345);
+    REQUIRE_EQ(index.find(f, cache, key_for(12346)), 12346);
+    CHECK_EQ(cache.misses, misses);
+    CHECK_GE(cache.hits, 2);
+}
+
+TEST_CASE("A lookup in a table of a few hundred blocks reads one block.") {
+    // macaddress.db sized: 37500 keys of 7 bytes, 513 blocks.
+    const size_t count = 37500;
+    MockFile f{make_db(count)};
+    TableIndex index{0, 7, 4};
+    REQUIRE(index.load(f));
+
+    size_t lookups = 0;
+    size_t reads = 0;
+    for (size_t i = 0; i < count; i += 7) {
+        BlockCache cache;
+        REQUIRE_EQ(index.find(f, cache, key_for(i)), (int32_t)i);
+        // The span's last key may straddle into the next block.
+        CHECK_LE(cache.misses, 2);
+        lookups++;
+        reads += cache.misses;
+    }
+    CHECK_LT(reads, lookups * 11 / 10);
+}
+
+TEST_CASE("A lookup in a larger table reads a few blocks.") {
+    // 2735 blocks, spans of 5.
+    const size_t count = 200000;
+    MockFile f{make_db(count, 1)};
+    TableIndex index{0, 7, 4};
+    REQUIRE(index.load(f));
+
+    for (size_t i = 0; i < count; i += 97) {
+        BlockCache cache;
+        REQUIRE_EQ(index.find(f, cache, key_for(i, 1)), (int32_t)i);
+        CHECK_LE(cache.misses, 4);
+    }
+}
+
+TEST_CASE("Dropping a table forgets its blocks.") {
+    MockFile f{make_db(1000)};
+    BlockCache cache;
+    TableIndex index{1, 7, 4};
+    REQUIRE(index.load(f));
+
+    REQUIRE_EQ(index.find(f, cache, key_for(500)), 500);
+    const auto misses = cache.misses;
+    cache.drop(1);
+    REQUIRE_EQ(index.find(f, cache, key_for(500)), 500);
+    CHECK_GT(cache.misses, misses);
+}
+
+TEST_CASE("Empty and oversized tables.") {
+    MockFile empty{""};
+    TableIndex index{0, 7, 4};
+    REQUIRE(index.load(empty));
+    BlockCache cache;
+    CHECK_EQ(index.find(empty, cache, "ABCDEF"), TableIndex::not_found);
+
+    TableIndex wide{0, 9, 4};
+    CHECK_FALSE(wide.load(empty));
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "deflate.hpp"
+
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+std::vector<uint8_t> compress(const std::vector<uint8_t>& data, size_t piece = 100) {
+    std::vector<uint8_t> out;
+    deflate::Encoder encoder{[&out](const uint8_t* p, size_t length) {
+        out.insert(out.end(), p, p + length);
+    }};
+
+    for (size_t i = 0; i < data.size(); i += piece)
+        encoder.write(&data[i], std::min(piece, data.size() - i));
+    encoder.finish();
+    return out;
+}
+
+std::vector<uint8_t> decompress(const std::vector<uint8_t>& compressed, size_t expected) {
+    size_t used = 0;
+    deflate::Decoder decoder{[&compressed, &used](uint8_t* p, size_t length) {
+        auto n = std::min(length, compressed.size() - used);
+        std::copy(&compressed[used], &compressed[used] + n, p);
+        used += n;
+        return n;
+    }};
+
+    std::vector<uint8_t> out(expected + 1);
+    size_t total = 0;
+    while (total < out.size()) {
+        auto n = decoder.read(&out[total], std::min<size_t>(77, out.size() - total));
+        if (n == 0)
+            break;
+        total += n;
+    }
+    CHECK_FALSE(decoder.error());
+    out.resize(total);
+    return out;
+}
+
+}  // namespace
+
+TEST_SUITE_BEGIN("deflate");
+
+TEST_CASE("Random data round trips.") {
+    std::vector<uint8_t> data(5000);
+    std::srand(1);
+    for (auto& b : data)
+        b = std::rand();
+
+    auto compressed = compress(data);
+    CHECK_EQ(compressed[0], deflate::zlib_header[0]);
+    CHECK_EQ(compressed[1], deflate::zlib_header[1]);
+    CHECK(decompress(compressed, data.size()) == data);
+}
+
+TEST_CASE("Repetitive data compresses well and round trips.") {
+    std::vector<uint8_t> data;
+    for (size_t i = 0; i < 240 * 3 * 20; i++)
+        data.push_back((i % 3 == 0) ? (i / 30) % 256 : 0x55);
+
+    auto compressed = compress(data, 721);
+    CHECK_LT(compressed.size(), data.size() / 8);
+    CHECK(decompress(compressed, data.size()) == data);
+}
+
+TEST_CASE("A reset encoder starts an identical new stream.") {
+    std::vector<uint8_t> data(3000);
+    for (size_t i = 0; i < data.size(); i++)
+        data[i] = (i * 7) % 251;
+
+    std::vector<uint8_t> out;
+    deflate::Encoder encoder{[&out](const uint8_t* p, size_t length) {
+        out.insert(out.end(), p, p + length);
+    }};
+
+    // An unfinished stream is dropped.
+    encoder.write(data.data(), 500);
+    encoder.reset();
+    encoder.write(data.data(), data.size());
+    encoder.finish();
+    CHECK(out == compress(data, data.size()));
+
+    out.clear();
+    encoder.reset();
+    encoder.write(data.data(), data.size());
+    encoder.finish();
+    CHECK(out == compress(data, data.size()));
+    CHECK(decompress(out, data.size()) == data);
+}
+
+TEST_CASE("Empty stream round trips.") {
+    auto compressed = compress({});
+    CHECK(decompress(compressed, 0).empty());
+}
+
+TEST_CASE("Stored blocks decode.") {
+    // zlib header, final stored block of 5 bytes, Adler-32 of "hello".
+    std::vector<uint8_t> compressed{0x78, 0x01, 0x01, 0x05, 0x00, 0xfa, 0xff,
+                                    'h', 'e', 'l', 'l', 'o',
+                                    0x06, 0x2c, 0x02, 0x15};
+    std::vector<uint8_t> expected{'h', 'e', 'l', 'l', 'o'};
+    CHECK(decompress(compressed, expected.size()) == expected);
+}
+
+TEST_CASE("Dynamic Huffman blocks are rejected.") {
+    // zlib header, BFINAL=1 BTYPE=2.
+    std::vector<uint8_t> compressed{0x78, 0x9c, 0x05, 0x00, 0x00, 0x00};
+    size_t used = 0;
+    deflate::Decoder decoder{[&compressed, &used](uint8_t* p, size_t length) {
+        auto n = std::min(length, compressed.size() - used);
+        std::copy(&compressed[used], &compressed[used] + n, p);
+        used += n;
+        return n;
+    }};
+    uint8_t out[4];
+    CHECK_EQ(decoder.read(out, sizeof(out)), 0);
+    CHECK(decoder.error());
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "delegate.hpp"
+
+#include <functional>
+#include <memory>
+
+TEST_SUITE_BEGIN("Delegate");
+
+TEST_CASE("Default delegate is empty.") {
+    Delegate<void()> d;
+    CHECK_FALSE(d);
+    CHECK(d == nullptr);
+}
+
+TEST_CASE("Lambda captures are called with the arguments.") {
+    int total = 0;
+    Delegate<void(int)> d = [&total](int v) { total += v; };
+    REQUIRE(d);
+    d(2);
+    d(3);
+    CHECK(total == 5);
+}
+
+TEST_CASE("Return values are passed through.") {
+    Delegate<int(int, int)> d = [](int a, int b) { return a * b; };
+    CHECK(d(6, 7) == 42);
+}
+
+TEST_CASE("Empty std::function and function pointer make an empty delegate.") {
+    Delegate<void()> from_function = std::function<void()>{};
+    CHECK_FALSE(from_function);
+
+    void (*fn)() = nullptr;
+    Delegate<void()> from_pointer = fn;
+    CHECK_FALSE(from_pointer);
+}
+
+TEST_CASE("Copies and moves keep non-trivial captures alive.") {
+    auto counter = std::make_shared<int>(0);
+    Delegate<void()> a = [counter] { ++*counter; };
+    CHECK(counter.use_count() == 2);
+
+    Delegate<void()> b = a;
+    CHECK(counter.use_count() == 3);
+
+    Delegate<void()> c = std::move(a);
+    CHECK_FALSE(a);
+    CHECK(counter.use_count() == 3);
+
+    b();
+    c();
+    CHECK(*counter == 2);
+
+    b = nullptr;
+    c = [] {};
+    CHECK(counter.use_count() == 1);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "indexed_lru_list.hpp"
+
+#include <string>
+#include <vector>
+
+namespace {
+
+struct TestEntry {
+    using Key = uint32_t;
+
+    uint32_t id;
+    int rank{0};
+    std::string name{};
+
+    TestEntry(uint32_t id)
+        : id{id}, name{std::to_string(id)} {}
+
+    Key key() const { return id; }
+};
+
+template <typename List>
+std::vector<uint32_t> keys(const List& list) {
+    std::vector<uint32_t> result;
+    for (const auto& e : list)
+        result.push_back(e.key());
+    return result;
+}
+
+}  // namespace
+
+TEST_SUITE_BEGIN("IndexedLRUList");
+
+TEST_CASE("Items are found by key.") {
+    IndexedLRUList<TestEntry, 8> list;
+    CHECK(list.empty());
+    CHECK(list.find(1) == list.end());
+
+    list.emplace_front(1);
+    list.emplace_front(2);
+    list.emplace_front(3);
+
+    CHECK(list.size() == 3);
+    CHECK(keys(list) == std::vector<uint32_t>{3, 2, 1});
+    REQUIRE(list.find(2) != list.end());
+    CHECK(list.find(2)->name == "2");
+    CHECK(list.find(4) == list.end());
+}
+
+TEST_CASE("A full list evicts the back item.") {
+    IndexedLRUList<TestEntry, 3> list;
+    list.emplace_front(1);
+    list.emplace_front(2);
+    list.emplace_front(3);
+    list.move_to_front(list.find(1));
+    list.emplace_front(4);
+
+    CHECK(list.size() == 3);
+    CHECK(keys(list) == std::vector<uint32_t>{4, 1, 3});
+    CHECK(list.find(2) == list.end());
+}
+
+TEST_CASE("Erasing keeps colliding keys reachable.") {
+    // ICAO-like keys that share low bits.
+    IndexedLRUList<TestEntry, 64> list;
+    for (uint32_t i = 0; i < 64; i++)
+        list.emplace_front(0x400000 + (i << 12));
+
+    for (uint32_t i = 0; i < 64; i += 2)
+        list.erase(list.find(0x400000 + (i << 12)));
+
+    CHECK(list.size() == 32);
+    for (uint32_t i = 0; i < 64; i++) {
+        const bool present = list.find(0x400000 + (i << 12)) != list.end();
+        CHECK(present == ((i & 1) == 1));
+    }
+}
+
+TEST_CASE("Sort is stable.") {
+    IndexedLRUList<TestEntry, 8> list;
+    for (uint32_t i = 1; i <= 6; i++)
+        list.emplace_front(i).rank = i % 3;
+
+    list.sort([](const TestEntry& a, const TestEntry& b) { return a.rank < b.rank; });
+    CHECK(keys(list) == std::vector<uint32_t>{6, 3, 4, 1, 5, 2});
+    CHECK(list.back().key() == 2);
+}
+
+TEST_CASE("Iterators walk backwards from end.") {
+    IndexedLRUList<TestEntry, 8> list;
+    list.emplace_front(1);
+    list.emplace_front(2);
+
+    auto it = list.end();
+    --it;
+    CHECK(it->key() == 1);
+    --it;
+    CHECK(it == list.begin());
+
+    list.pop_back();
+    list.pop_back();
+    CHECK(list.empty());
+    list.pop_back();
+    CHECK(list.empty());
+}
+
+TEST_SUITE_END();
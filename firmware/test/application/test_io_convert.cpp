@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "fatfs_stub.hpp"
+#include "io_convert.hpp"
+
+#include <vector>
+
+namespace {
+
+/* First sector of the stub file's data on the fake volume. */
+constexpr DWORD file_sector = FatFsStub::volume_database + (FatFsStub::file_cluster - 2);
+
+}  // namespace
+
+TEST_SUITE_BEGIN("FileConvertWriter");
+
+TEST_CASE("Aligned writes inside the extent go straight to the card.") {
+    fatfs_stub.reset();
+    std::vector<uint8_t> data(2048);
+    {
+        FileConvertWriter writer;
+        // Rounded down to 4 sectors.
+        REQUIRE_FALSE(writer.create(u"TEST.C16", 4 * File::sector_size + 100).is_valid());
+        CHECK_EQ(writer.file().size(), 4 * File::sector_size);
+
+        CHECK(writer.write(data.data(), 1024).is_ok());
+        CHECK_EQ(fatfs_stub.disk_writes, 1);
+        CHECK_EQ(fatfs_stub.disk_write_sector, file_sector);
+        CHECK_EQ(fatfs_stub.disk_write_sectors, 2);
+
+        CHECK(writer.write(data.data(), 1024).is_ok());
+        CHECK_EQ(fatfs_stub.disk_writes, 2);
+        CHECK_EQ(fatfs_stub.disk_write_sector, file_sector + 2);
+        CHECK_EQ(fatfs_stub.f_writes, 0);
+
+        // Past the extent, FatFs appends after the raw sectors.
+        CHECK(writer.write(data.data(), 512).is_ok());
+        CHECK_EQ(fatfs_stub.disk_writes, 2);
+        CHECK_EQ(fatfs_stub.f_writes, 1);
+        CHECK_EQ(writer.file().tell(), 5 * File::sector_size);
+    }
+    // The writer gives back the unused part of the extent.
+    CHECK_EQ(fatfs_stub.truncates, 1);
+}
+
+TEST_CASE("Unaligned writes inside the extent go through FatFs at the right position.") {
+    fatfs_stub.reset();
+    std::vector<uint8_t> data(512);
+    FileConvertWriter writer;
+    REQUIRE_FALSE(writer.create(u"TEST.C16", 4 * File::sector_size).is_valid());
+
+    CHECK(writer.write(data.data(), 100).is_ok());
+    CHECK(writer.write(data.data(), 412).is_ok());
+    CHECK_EQ(fatfs_stub.f_writes, 2);
+    CHECK_EQ(fatfs_stub.disk_writes, 0);
+
+    CHECK(writer.write(data.data(), 512).is_ok());
+    CHECK_EQ(fatfs_stub.disk_writes, 1);
+    CHECK_EQ(fatfs_stub.disk_write_sector, file_sector + 1);
+}
+
+TEST_CASE("Without a contiguous extent the file is written through FatFs.") {
+    fatfs_stub.reset();
+    fatfs_stub.expand_result = FR_DENIED;
+    std::vector<uint8_t> data(1024);
+    {
+        FileConvertWriter writer;
+        CHECK_FALSE(writer.create(u"TEST.C16", 4 * File::sector_size).is_valid());
+
+        CHECK(writer.write(data.data(), 1024).is_ok());
+        CHECK(writer.write(data.data(), 1024).is_ok());
+        CHECK_EQ(fatfs_stub.disk_writes, 0);
+        CHECK_EQ(fatfs_stub.f_writes, 2);
+        CHECK_EQ(fatfs_stub.f_write_bytes, 2048);
+    }
+    CHECK_EQ(fatfs_stub.truncates, 0);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "iq_codec.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+using Block = std::array<complex16_t, iq_codec::block_samples>;
+
+/* Small deterministic LCG so the noise is the same on every run. */
+int16_t noise(uint32_t& state, int16_t amplitude) {
+    state = state * 1664525 + 1013904223;
+    return static_cast<int16_t>(static_cast<int32_t>(state >> 16) % (amplitude + 1) - amplitude / 2);
+}
+
+size_t round_trip(const complex16_t* src, size_t count) {
+    std::array<uint8_t, iq_codec::max_block_bytes> encoded{};
+    Block decoded{};
+
+    const auto size = iq_codec::encode_block(src, count, encoded.data());
+    REQUIRE(size <= iq_codec::max_block_bytes);
+
+    iq_codec::BlockHeader header{};
+    std::memcpy(&header, encoded.data(), sizeof(header));
+    CHECK_EQ(header.sample_count, count);
+    CHECK_EQ(header.payload_bytes + sizeof(header), size);
+    REQUIRE(iq_codec::decode_block(header, &encoded[sizeof(header)], decoded.data()));
+
+    for (size_t i = 0; i < count; i++) {
+        REQUIRE_EQ(decoded[i].real(), src[i].real());
+        REQUIRE_EQ(decoded[i].imag(), src[i].imag());
+    }
+    return size;
+}
+
+}  // namespace
+
+TEST_SUITE_BEGIN("iq_codec");
+
+TEST_CASE("Noise floor captures compress to about half.") {
+    Block src{};
+    uint32_t state = 1;
+    for (auto& s : src) {
+        s = {noise(state, 60), noise(state, 60)};
+    }
+
+    const auto size = round_trip(src.data(), src.size());
+    CHECK_LT(size, src.size() * sizeof(complex16_t) / 2);
+}
+
+TEST_CASE("Smooth signals pick a higher order predictor.") {
+    Block src{};
+    for (size_t i = 0; i < src.size(); i++) {
+        src[i] = {static_cast<int16_t>(20000 * std::cos(0.01 * i)),
+                  static_cast<int16_t>(20000 * std::sin(0.01 * i))};
+    }
+
+    const auto size = round_trip(src.data(), src.size());
+    CHECK_LT(size, src.size() * sizeof(complex16_t) / 4);
+}
+
+TEST_CASE("Full scale extremes fall back to verbatim.") {
+    Block src{};
+    uint32_t state = 7;
+    for (size_t i = 0; i < src.size(); i++) {
+        const int16_t v = (i & 1) ? 32767 : -32768;
+        src[i] = {v, noise(state, 32767)};
+    }
+
+    const auto size = round_trip(src.data(), src.size());
+    CHECK_LE(size, iq_codec::max_block_bytes);
+}
+
+TEST_CASE("Short and single sample blocks round trip.") {
+    Block src{};
+    uint32_t state = 3;
+    for (auto& s : src) {
+        s = {noise(state, 1000), noise(state, 30000)};
+    }
+
+    round_trip(src.data(), 1);
+    round_trip(src.data(), 2);
+    round_trip(src.data(), 3);
+    round_trip(src.data(), 100);
+}
+
+TEST_CASE("Corrupt blocks are rejected.") {
+    Block src{};
+    std::array<uint8_t, iq_codec::max_block_bytes> encoded{};
+    Block decoded{};
+
+    iq_codec::encode_block(src.data(), src.size(), encoded.data());
+    iq_codec::BlockHeader header{};
+    std::memcpy(&header, encoded.data(), sizeof(header));
+
+    header.sample_count = iq_codec::block_samples + 1;
+    CHECK_FALSE(iq_codec::decode_block(header, &encoded[sizeof(header)], decoded.data()));
+
+    // All zero samples code to a few bits, so the stream runs out early.
+    header.sample_count = iq_codec::block_samples;
+    header.payload_bytes = 1;
+    CHECK_FALSE(iq_codec::decode_block(header, &encoded[sizeof(header)], decoded.data()));
+}
+
+TEST_CASE("File header identifies the format.") {
+    auto header = iq_codec::make_file_header(1234);
+    CHECK(iq_codec::is_valid(header));
+    CHECK_EQ(header.sample_count, 1234);
+
+    header.magic[3] = '2';
+    CHECK_FALSE(iq_codec::is_valid(header));
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "fatfs_stub.hpp"
+#include "io_convert.hpp"
+#include "iq_power_index.hpp"
+#include "mock_file.hpp"
+
+#include <vector>
+
+using namespace iq;
+
+namespace {
+
+std::vector<PowerIndexBin> read_level(MockFile& f, const PowerIndexHeader& header, size_t level) {
+    std::vector<PowerIndexBin> bins;
+    auto ok = read_power_index_level(f, header, level, [&bins, &header, level](const PowerIndexBin& bin, uint64_t first_sample) {
+        CHECK_EQ(first_sample, uint64_t{header.bin_samples} * bins.size() << level);
+        bins.push_back(bin);
+    });
+    CHECK(ok);
+    return bins;
+}
+
+}  // namespace
+
+TEST_SUITE_BEGIN("iq_power_index");
+
+TEST_CASE("Short captures get a level per halving.") {
+    std::vector<complex16_t> samples(1000, complex16_t{10, 0});
+    PowerIndexBuilder builder{"", sizeof(complex16_t)};
+    builder.add(samples.data(), samples.size());
+
+    MockFile f{""};
+    REQUIRE_FALSE(builder.write_to(f).is_valid());
+    f.seek(0);
+
+    auto header = read_power_index_header(f);
+    REQUIRE(header);
+    CHECK_EQ(header->sample_count, 1000);
+    CHECK_EQ(header->bin_samples, PowerIndexBuilder::initial_bin_samples);
+    CHECK_EQ(header->level_count, 3);
+    CHECK_EQ(header->max_power, 100);
+    CHECK_EQ(header->max_iq, 10);
+
+    CHECK_EQ(power_index_bin_count(*header, 0), 4);
+    CHECK_EQ(power_index_bin_count(*header, 1), 2);
+    CHECK_EQ(power_index_bin_count(*header, 2), 1);
+    CHECK_EQ(power_index_bin_count(*header, 3), 0);
+
+    for (size_t level = 0; level < header->level_count; level++) {
+        for (auto& bin : read_level(f, *header, level)) {
+            CHECK_EQ(bin.min, 100);
+            CHECK_EQ(bin.max, 100);
+            CHECK_EQ(bin.mean, 100);
+        }
+    }
+}
+
+TEST_CASE("Full builders merge bins and keep the envelope.") {
+    constexpr size_t count = PowerIndexBuilder::capacity * PowerIndexBuilder::initial_bin_samples;
+    PowerIndexBuilder builder{"", sizeof(complex16_t)};
+
+    // Quiet first half, a burst in the last quarter. Added in odd sized
+    // pieces so bins straddle calls.
+    std::vector<complex16_t> samples(count, complex16_t{1, 1});
+    for (size_t i = count * 3 / 4; i < count; i++)
+        samples[i] = {100, 0};
+    for (size_t i = 0; i < count; i += 1000)
+        builder.add(&samples[i], std::min<size_t>(1000, count - i));
+    CHECK_EQ(builder.sample_count(), count);
+
+    MockFile f{""};
+    REQUIRE_FALSE(builder.write_to(f).is_valid());
+    f.seek(0);
+
+    auto header = read_power_index_header(f);
+    REQUIRE(header);
+    CHECK_EQ(header->bin_samples, PowerIndexBuilder::initial_bin_samples * 2);
+    CHECK_EQ(power_index_bin_count(*header, 0), PowerIndexBuilder::capacity / 2);
+
+    auto level = power_index_level_for(*header, 64);
+    CHECK_EQ(power_index_bin_count(*header, level), 64);
+
+    auto bins = read_level(f, *header, level);
+    REQUIRE_EQ(bins.size(), 64);
+    CHECK_EQ(bins[0].mean, 2);
+    CHECK_EQ(bins[47].mean, 2);
+    CHECK_EQ(bins[48].mean, 10000);
+    CHECK_EQ(bins[63].max, 10000);
+
+    auto top = read_level(f, *header, header->level_count - 1);
+    REQUIRE_EQ(top.size(), 1);
+    CHECK_EQ(top[0].min, 2);
+    CHECK_EQ(top[0].max, 10000);
+    CHECK_EQ(top[0].mean, (3 * 2 + 10000) / 4);
+}
+
+TEST_CASE("A partial last bin is weighted by its length.") {
+    std::vector<complex16_t> samples(PowerIndexBuilder::initial_bin_samples + 4, complex16_t{0, 0});
+    for (size_t i = PowerIndexBuilder::initial_bin_samples; i < samples.size(); i++)
+        samples[i] = {10, 0};
+
+    PowerIndexBuilder builder{"", sizeof(complex16_t)};
+    builder.add(samples.data(), samples.size());
+
+    MockFile f{""};
+    REQUIRE_FALSE(builder.write_to(f).is_valid());
+    f.seek(0);
+
+    auto header = read_power_index_header(f);
+    REQUIRE(header);
+    auto top = read_level(f, *header, 1);
+    REQUIRE_EQ(top.size(), 1);
+    CHECK_EQ(top[0].mean, 100 * 4 / samples.size());
+}
+
+TEST_CASE("C8 captures are indexed in C8 units.") {
+    fatfs_stub.reset();
+    std::vector<complex16_t> samples(256, complex16_t{10 << 8, -(3 << 8)});
+    PowerIndexBuilder builder{"", sizeof(complex8_t), 8};
+
+    // As the capture thread does it: the writer converts the buffer in place.
+    FileConvertWriter writer;
+    REQUIRE_FALSE(writer.create(u"TEST.C8").is_valid());
+    auto result = write_indexed(writer, &builder, samples.data(), samples.size() * sizeof(complex16_t));
+    REQUIRE(result.is_ok());
+    CHECK_EQ(*result, samples.size() * sizeof(complex16_t));
+    CHECK_EQ(reinterpret_cast<const complex8_t*>(samples.data())[0].real(), 10);
+
+    MockFile f{""};
+    REQUIRE_FALSE(builder.write_to(f).is_valid());
+    f.seek(0);
+
+    auto header = read_power_index_header(f);
+    REQUIRE(header);
+    CHECK_EQ(header->sample_size, sizeof(complex8_t));
+    CHECK_EQ(header->max_power, 109);
+    CHECK_EQ(header->max_iq, 10);
+    CHECK_EQ(read_level(f, *header, 0)[0].mean, 109);
+}
+
+TEST_CASE("Other files are not power indexes.") {
+    MockFile f{"CIQ1 and then some more bytes to make up a header"};
+    CHECK_FALSE(read_power_index_header(f));
+}
+
+TEST_SUITE_END();
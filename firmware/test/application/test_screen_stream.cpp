@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "screen_stream.hpp"
+
+#include <vector>
+
+using namespace screen_stream;
+
+namespace {
+
+/* A fake screen the encoder reads tiles from. */
+struct Screen {
+    ui::Size size;
+    std::vector<ui::ColorRGB888> pixels;
+
+    Screen(int width, int height)
+        : size{width, height},
+          pixels(width * height, ui::ColorRGB888{0, 0, 0}) {
+    }
+
+    Encoder::TileReader reader() {
+        return [this](ui::Rect r, ui::ColorRGB888* out) {
+            for (int y = r.top(); y < r.bottom(); y++)
+                for (int x = r.left(); x < r.right(); x++)
+                    *(out++) = pixels[y * size.width() + x];
+        };
+    }
+};
+
+struct Frame {
+    std::vector<uint8_t> header;
+    std::vector<uint8_t> data;  // Inflated tiles.
+    size_t chunks{0};
+};
+
+Frame encode(Encoder& encoder, Screen& screen, size_t& changed) {
+    std::vector<uint8_t> raw;
+    changed = encoder.encode_frame(screen.reader(), [&raw](const uint8_t* p, size_t length) {
+        raw.insert(raw.end(), p, p + length);
+    });
+
+    Frame frame;
+    REQUIRE_GE(raw.size(), header_size + 2);
+    frame.header.assign(raw.begin(), raw.begin() + header_size);
+
+    std::vector<uint8_t> compressed;
+    size_t at = header_size;
+    while (true) {
+        REQUIRE_LE(at + 2, raw.size());
+        const size_t length = raw[at] | (raw[at + 1] << 8);
+        at += 2;
+        if (length == 0)
+            break;
+        compressed.insert(compressed.end(), &raw[at], &raw[at] + length);
+        at += length;
+        frame.chunks++;
+    }
+    CHECK_EQ(at, raw.size());
+
+    if (!compressed.empty()) {
+        size_t used = 0;
+        deflate::Decoder decoder{[&compressed, &used](uint8_t* p, size_t length) {
+            auto n = std::min(length, compressed.size() - used);
+            std::copy(&compressed[used], &compressed[used] + n, p);
+            used += n;
+            return n;
+        }};
+        uint8_t buffer[100];
+        size_t n;
+        while ((n = decoder.read(buffer, sizeof(buffer))) > 0)
+            frame.data.insert(frame.data.end(), buffer, buffer + n);
+        CHECK_FALSE(decoder.error());
+    }
+    return frame;
+}
+
+}  // namespace
+
+TEST_SUITE_BEGIN("screen stream");
+
+TEST_CASE("The first frame carries every tile, an unchanged one none.") {
+    Screen screen{64, 32};
+    Encoder encoder{screen.size};
+    size_t changed;
+
+    auto frame = encode(encoder, screen, changed);
+    CHECK_EQ(changed, 8);
+    CHECK(frame.header == std::vector<uint8_t>{'S', 'F', 64, 0, 32, 0, tile_size});
+    CHECK_EQ(frame.data.size(), 8 * (2 + tile_size * tile_size * 2));
+
+    frame = encode(encoder, screen, changed);
+    CHECK_EQ(changed, 0);
+    CHECK_EQ(frame.chunks, 0);
+    CHECK(frame.data.empty());
+}
+
+TEST_CASE("Only the changed tile is sent.") {
+    Screen screen{64, 32};
+    Encoder encoder{screen.size};
+    size_t changed;
+    encode(encoder, screen, changed);
+
+    // Tile 5 is column 1 of row 1.
+    screen.pixels[20 * 64 + 17] = {0xff, 0x00, 0xff};
+    auto frame = encode(encoder, screen, changed);
+    CHECK_EQ(changed, 1);
+    REQUIRE_EQ(frame.data.size(), 2 + tile_size * tile_size * 2);
+    CHECK_EQ(frame.data[0], 5);
+    CHECK_EQ(frame.data[1], 0);
+
+    // Pixel (1, 4) within the tile, RGB565 little endian.
+    const size_t at = 2 + (4 * tile_size + 1) * 2;
+    CHECK_EQ(frame.data[at], 0x1f);
+    CHECK_EQ(frame.data[at + 1], 0xf8);
+    CHECK_EQ(frame.data[at + 2], 0x00);
+}
+
+TEST_CASE("Reset sends every tile again.") {
+    Screen screen{32, 32};
+    Encoder encoder{screen.size};
+    size_t changed;
+    encode(encoder, screen, changed);
+
+    encoder.reset();
+    encode(encoder, screen, changed);
+    CHECK_EQ(changed, 4);
+}
+
+TEST_CASE("Edge tiles are clipped to the screen.") {
+    Screen screen{40, 20};
+    Encoder encoder{screen.size};
+    size_t changed;
+
+    auto frame = encode(encoder, screen, changed);
+    CHECK_EQ(changed, 6);
+    const size_t full = tile_size * tile_size;
+    const size_t pixels = 2 * full + 8 * 16 + 2 * 16 * 4 + 8 * 4;
+    CHECK_EQ(frame.data.size(), 6 * 2 + pixels * 2);
+}
+
+TEST_SUITE_END();
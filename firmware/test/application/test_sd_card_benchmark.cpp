@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "sd_card_benchmark.hpp"
+
+#include <algorithm>
+#include <array>
+
+using namespace sd_benchmark;
+
+TEST_SUITE_BEGIN("sd_card_benchmark");
+
+TEST_CASE("An empty histogram reports zeros.") {
+    LatencyHistogram h{};
+    CHECK_EQ(h.count(), 0);
+    CHECK_EQ(h.percentile(50), 0);
+    CHECK_EQ(h.max(), 0);
+}
+
+TEST_CASE("Small latencies are exact.") {
+    LatencyHistogram h{};
+    for (uint32_t us = 0; us < 8; us++)
+        h.add(us);
+
+    CHECK_EQ(h.count(), 8);
+    CHECK_EQ(h.percentile(50), 3);
+    CHECK_EQ(h.percentile(100), 7);
+    CHECK_EQ(h.total(), 28);
+}
+
+TEST_CASE("Percentiles are within a bucket of the truth.") {
+    LatencyHistogram h{};
+    // 98 fast writes, then two stalls.
+    for (int i = 0; i < 98; i++)
+        h.add(1000);
+    h.add(150000);
+    h.add(400000);
+
+    const auto p50 = h.percentile(50);
+    CHECK_GE(p50, 1000);
+    CHECK_LE(p50, 1000 * 5 / 4);
+
+    const auto p99 = h.percentile(99);
+    CHECK_GE(p99, 150000);
+    CHECK_LE(p99, 150000 * 5 / 4);
+
+    CHECK_EQ(h.percentile(100), 400000);
+    CHECK_EQ(h.max(), 400000);
+}
+
+TEST_CASE("Huge latencies land in the last bucket.") {
+    LatencyHistogram h{};
+    h.add(0xFFFFFFFF);
+    CHECK_EQ(h.percentile(50), 0xFFFFFFFF);
+}
+
+TEST_CASE("CSV rows line up with the header.") {
+    LatencyHistogram h{};
+    h.add(100);
+    h.add(200);
+
+    const Case c{Operation::Write, Pattern::Random, true, 4096, 2048 * 1024};
+    const auto row = csv_row(c, h, 8192, 1000);
+    // p50 is the top of the 96-111us bucket.
+    CHECK_EQ(row, "write,random,1,4096,2048,2,8192,111,200,200");
+
+    auto columns = [](const std::string& s) {
+        return std::count(s.begin(), s.end(), ',');
+    };
+    CHECK_EQ(columns(row), columns(csv_header()));
+}
+
+TEST_CASE("Recommendation covers the slowest write.") {
+    // 1 MB/s sustained but 50 ms stalls at 4 KiB; 2 MB/s and 20 ms at 16 KiB.
+    const std::array<WriteProfile, 2> profiles{{
+        {4096, 1000000, 50000},
+        {16384, 2000000, 20000},
+    }};
+
+    const auto r = recommend_capture_buffers(profiles.data(), profiles.size());
+    CHECK_EQ(r.write_size, 16384);
+    CHECK_EQ(r.buffer_count, 3);
+    // min(2 MB/s * 3/4, 2 * 16384 B / 20 ms)
+    CHECK_EQ(r.bytes_per_second, 1500000);
+}
+
+TEST_CASE("Recommendation respects the buffer memory.") {
+    const std::array<WriteProfile, 1> profiles{{
+        {65536, 10000000, 10000},
+    }};
+
+    const auto r = recommend_capture_buffers(profiles.data(), profiles.size());
+    CHECK_EQ(r.write_size, 0);
+
+    // Past 3 buffers the card's rate is the limit, more don't help.
+    const auto r_big = recommend_capture_buffers(profiles.data(), profiles.size(), 65536 * 4);
+    CHECK_EQ(r_big.write_size, 65536);
+    CHECK_EQ(r_big.buffer_count, 3);
+    CHECK_EQ(r_big.bytes_per_second, 7500000);
+}
+
+TEST_SUITE_END();
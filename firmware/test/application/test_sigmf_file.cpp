@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "sigmf_file.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+TEST_SUITE_BEGIN("sigmf");
+
+TEST_CASE("Metadata round trips through JSON.") {
+    sigmf::Metadata metadata{};
+    metadata.datatype = "ci16_le";
+    metadata.sample_rate = 500000;
+    metadata.center_frequency = 433920000;
+    metadata.datetime = "2026-01-02T03:04:05Z";
+    metadata.dataset = "BBD_0001.C16";
+    metadata.latitude = 47.5f;
+    metadata.longitude = 19.25f;
+    metadata.annotations = {{100, 50, "signal"}, {5000000000ULL, 7, "with \"quotes\""}};
+
+    auto parsed = sigmf::parse_json(sigmf::to_json(metadata));
+    REQUIRE(parsed);
+    CHECK_EQ(parsed->datatype, "ci16_le");
+    CHECK_EQ(parsed->sample_rate, 500000);
+    CHECK_EQ(parsed->center_frequency, 433920000);
+    CHECK_EQ(parsed->datetime, "2026-01-02T03:04:05Z");
+    CHECK_EQ(parsed->dataset, "BBD_0001.C16");
+    CHECK(parsed->codec.empty());
+    CHECK_EQ(parsed->latitude, doctest::Approx(47.5));
+    CHECK_EQ(parsed->longitude, doctest::Approx(19.25));
+    REQUIRE_EQ(parsed->annotations.size(), 2);
+    CHECK_EQ(parsed->annotations[0].sample_start, 100);
+    CHECK_EQ(parsed->annotations[0].sample_count, 50);
+    CHECK_EQ(parsed->annotations[1].sample_start, 5000000000ULL);
+    CHECK_EQ(parsed->annotations[1].label, "with \"quotes\"");
+}
+
+TEST_CASE("Unknown fields are skipped.") {
+    auto parsed = sigmf::parse_json(R"({
+        "global": {"core:datatype": "ci8", "core:sample_rate": 2000000,
+                   "core:extensions": [{"name": "x", "optional": true}], "core:sha512": null},
+        "captures": [{"core:sample_start": 0, "core:frequency": 915000000},
+                     {"core:sample_start": 10, "core:frequency": 1}],
+        "annotations": [{"core:sample_start": 3, "core:sample_count": 4, "core:freq_lower_edge": 9.1e8}]
+    })");
+    REQUIRE(parsed);
+    CHECK_EQ(parsed->datatype, "ci8");
+    CHECK_EQ(parsed->center_frequency, 915000000);
+    REQUIRE_EQ(parsed->annotations.size(), 1);
+    CHECK_EQ(parsed->annotations[0].sample_count, 4);
+}
+
+TEST_CASE("Malformed or incomplete JSON is rejected.") {
+    CHECK_FALSE(sigmf::parse_json("{\"global\": {\"core:datatype\": \"ci8\""));
+    CHECK_FALSE(sigmf::parse_json("{\"global\": {\"core:datatype\": \"ci8\"}}"));
+    CHECK_FALSE(sigmf::parse_json(""));
+}
+
+TEST_CASE("A full annotation list round trips in small reads.") {
+    sigmf::Metadata metadata{};
+    metadata.datatype = "ci16_le";
+    metadata.sample_rate = 500000;
+    metadata.codec = "portapack-ciq";
+    for (size_t i = 0; i <= sigmf::max_annotations; i++)
+        metadata.annotations.push_back({i * 1000000000ULL, 500000, "activity"});
+
+    std::string json;
+    size_t pieces = 0;
+    sigmf::write_json(metadata, [&](std::string_view text) {
+        json += text;
+        pieces++;
+    });
+    CHECK_EQ(json, sigmf::to_json(metadata));
+    CHECK_GT(json.size(), 20000);
+    CHECK_EQ(pieces, metadata.annotations.size() + 2);
+    CHECK_NE(json.find(R"("core:extensions": [{"name": "portapack")"), std::string::npos);
+
+    size_t offset = 0;
+    auto parsed = sigmf::parse_json([&](char* data, size_t length) {
+        const size_t n = std::min<size_t>({length, 7, json.size() - offset});
+        std::memcpy(data, &json[offset], n);
+        offset += n;
+        return n;
+    });
+    REQUIRE(parsed);
+    CHECK_EQ(parsed->codec, "portapack-ciq");
+    REQUIRE_EQ(parsed->annotations.size(), sigmf::max_annotations);
+    CHECK_EQ(parsed->annotations.back().sample_start, (sigmf::max_annotations - 1) * 1000000000ULL);
+    CHECK_EQ(parsed->annotations.back().label, "activity");
+}
+
+TEST_CASE("Trimming rebases and clips annotations.") {
+    sigmf::Metadata metadata{};
+    metadata.annotations = {{0, 10, "a"}, {90, 20, "b"}, {150, 10, "c"}, {190, 30, "d"}};
+
+    sigmf::trim_annotations(metadata, 100, 200);
+    REQUIRE_EQ(metadata.annotations.size(), 3);
+    CHECK_EQ(metadata.annotations[0].sample_start, 0);
+    CHECK_EQ(metadata.annotations[0].sample_count, 10);
+    CHECK_EQ(metadata.annotations[1].sample_start, 50);
+    CHECK_EQ(metadata.annotations[2].sample_start, 90);
+    CHECK_EQ(metadata.annotations[2].sample_count, 10);
+}
+
+TEST_SUITE_END();
@@ -142,3 +142,48 @@ TEST_CASE("trim returns empty for only whitespace.") {
 TEST_CASE("trim empty returns empty.") {
     CHECK(trim("").empty());
 }
+
+TEST_CASE("fmt_into_dec_int pads and signs.") {
+    char b[16];
+    CHECK_EQ(fmt_into_dec_int(b, sizeof(b), 0), 1);
+    CHECK_EQ(std::string{b}, "0");
+    CHECK_EQ(fmt_into_dec_int(b, sizeof(b), -42, 5), 5);
+    CHECK_EQ(std::string{b}, "  -42");
+    CHECK_EQ(fmt_into_dec_int(b, sizeof(b), -42, 5, '0'), 5);
+    CHECK_EQ(std::string{b}, "-0042");
+    CHECK_EQ(fmt_into_dec_int(b, sizeof(b), -9'876'543'210), 11);
+    CHECK_EQ(std::string{b}, "-9876543210");
+}
+
+TEST_CASE("fmt_into functions truncate to the buffer.") {
+    char b[4];
+    CHECK_EQ(fmt_into_dec_uint(b, sizeof(b), 123456), 3);
+    CHECK_EQ(std::string{b}, "123");
+    CHECK_EQ(fmt_into(b, sizeof(b), "abcdef"), 3);
+    CHECK_EQ(std::string{b}, "abc");
+    CHECK_EQ(fmt_into_hex(b, sizeof(b), 0xABCDEF, 6), 3);
+    CHECK_EQ(std::string{b}, "ABC");
+    CHECK_EQ(fmt_into(b, 0, "abc"), 0);
+}
+
+TEST_CASE("fmt_into_short_freq matches to_string_short_freq.") {
+    char b[16];
+    for (uint64_t f : {0ULL, 49ULL, 50ULL, 1'000'000ULL, 433'920'000ULL, 5'999'999'999ULL}) {
+        fmt_into_short_freq(b, sizeof(b), f);
+        CHECK_EQ(std::string{b}, to_string_short_freq(f));
+    }
+}
+
+TEST_CASE("StaticString appends without growing.") {
+    StaticString<16> s{"RSSI: "};
+    s.append_dec_int(-90).append("/").append_dec_uint(7, 3, '0');
+    CHECK_EQ(std::string_view{s}, "RSSI: -90/007");
+    CHECK_EQ(s.size(), 13);
+
+    s.append(" db and more");
+    CHECK_EQ(std::string_view{s}, "RSSI: -90/007 db");
+    CHECK_EQ(s.size(), s.capacity());
+
+    s.clear().append_hex(0x1F, 4);
+    CHECK_EQ(std::string{s.c_str()}, "001F");
+}
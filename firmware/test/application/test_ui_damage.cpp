@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "ui_damage.hpp"
+
+#include <vector>
+
+using namespace ui;
+
+namespace {
+
+template <typename Region>
+std::vector<std::vector<int>> rects(const Region& region) {
+    std::vector<std::vector<int>> result;
+    for (const auto& r : region)
+        result.push_back({r.left(), r.top(), r.width(), r.height()});
+    return result;
+}
+
+}  // namespace
+
+TEST_SUITE_BEGIN("DamageRegion");
+
+TEST_CASE("Empty rects are ignored.") {
+    DamageRegion<4> region;
+    region.add({10, 10, 0, 5});
+    CHECK(region.empty());
+}
+
+TEST_CASE("Disjoint rects are kept apart.") {
+    DamageRegion<4> region;
+    region.add({0, 0, 10, 10});
+    region.add({100, 100, 10, 10});
+    CHECK(rects(region) == std::vector<std::vector<int>>{{0, 0, 10, 10}, {100, 100, 10, 10}});
+}
+
+TEST_CASE("Covered and adjacent rects merge.") {
+    DamageRegion<4> region;
+    region.add({0, 0, 20, 20});
+    region.add({5, 5, 5, 5});
+    CHECK(region.size() == 1);
+
+    region.add({20, 0, 20, 20});
+    CHECK(rects(region) == std::vector<std::vector<int>>{{0, 0, 40, 20}});
+
+    // A rect covering the region replaces it.
+    region.add({0, 0, 100, 100});
+    CHECK(rects(region) == std::vector<std::vector<int>>{{0, 0, 100, 100}});
+}
+
+TEST_CASE("Merging cascades.") {
+    DamageRegion<4> region;
+    region.add({0, 0, 10, 10});
+    region.add({20, 0, 10, 10});
+    region.add({10, 0, 10, 10});
+    CHECK(rects(region) == std::vector<std::vector<int>>{{0, 0, 30, 10}});
+}
+
+TEST_CASE("A full region grows the closest rect.") {
+    DamageRegion<2> region;
+    region.add({0, 0, 10, 10});
+    region.add({200, 200, 10, 10});
+    region.add({0, 30, 10, 10});
+    CHECK(rects(region) == std::vector<std::vector<int>>{{0, 0, 10, 40}, {200, 200, 10, 10}});
+}
+
+TEST_CASE("Overlap and containment tests.") {
+    CHECK(DamageRegion<1>::overlaps({0, 0, 10, 10}, {9, 9, 5, 5}));
+    CHECK_FALSE(DamageRegion<1>::overlaps({0, 0, 10, 10}, {10, 0, 5, 5}));
+    CHECK(DamageRegion<1>::contains({0, 0, 10, 10}, {0, 0, 10, 10}));
+    CHECK_FALSE(DamageRegion<1>::contains({0, 0, 10, 10}, {5, 5, 10, 10}));
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "heap_stub.hpp"
+#include "view_arena.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace ui;
+
+namespace {
+
+/* Stands in for a pushed view: some allocations of its own, and a static
+ * cache it fills while it is being constructed. */
+struct MenuView {
+    std::vector<std::string> items;
+
+    MenuView(std::vector<uint8_t>& cache, bool cache_on_main_heap) {
+        for (size_t i = 0; i < 8; i++)
+            items.push_back("Item number " + std::to_string(i));
+
+        if (cache_on_main_heap) {
+            ViewArena::Scope main_heap{nullptr};
+            cache.assign(256, 0x55);
+        } else {
+            cache.assign(256, 0x55);
+        }
+    }
+};
+
+/* Pushes and pops a MenuView, returns how much of the main heap it left
+ * in use while the cache is still alive. */
+size_t push_and_pop(std::vector<uint8_t>& cache, bool cache_on_main_heap) {
+    const auto before = heap_stub::used();
+    {
+        auto arena = ViewArena::create(sizeof(MenuView));
+        std::unique_ptr<MenuView> view;
+        {
+            ViewArena::Scope scope{&arena};
+            view = std::make_unique<MenuView>(cache, cache_on_main_heap);
+        }
+    }
+    return heap_stub::used() - before;
+}
+
+}  // namespace
+
+TEST_SUITE_BEGIN("ViewArena");
+
+TEST_CASE("An arena is released when its view is popped.") {
+    std::vector<uint8_t> cache;
+    // Just the cache and its heap header, the arena block went back.
+    const auto left = push_and_pop(cache, true);
+    CHECK_GE(left, cache.capacity());
+    CHECK_LT(left, ViewArena::slack_size);
+}
+
+TEST_CASE("Storage outliving the view pins the arena until it is freed.") {
+    std::vector<uint8_t> cache;
+    const auto pinned = push_and_pop(cache, false);
+    CHECK_GT(pinned, ViewArena::slack_size);
+
+    const auto before = heap_stub::used();
+    std::vector<uint8_t>{}.swap(cache);
+    ViewArena::collect();
+    CHECK_EQ(before - heap_stub::used(), pinned);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "waterfall_row.hpp"
+
+#include <numeric>
+#include <vector>
+
+namespace {
+
+/* Colour i is i, so rows read back as bin values. */
+WaterfallRow::LUT identity_lut() {
+    WaterfallRow::LUT lut{};
+    for (size_t i = 0; i < lut.size(); i++)
+        lut[i] = ui::Color{static_cast<uint16_t>(i)};
+    return lut;
+}
+
+std::vector<uint16_t> values(const std::vector<ui::Color>& row) {
+    std::vector<uint16_t> v;
+    for (const auto& c : row)
+        v.push_back(c.v);
+    return v;
+}
+
+}  // namespace
+
+TEST_SUITE_BEGIN("WaterfallRow");
+
+TEST_CASE("Matching spans map one bin per pixel and wrap.") {
+    const auto lut = identity_lut();
+    std::vector<uint8_t> bins(8);
+    std::iota(bins.begin(), bins.end(), 0);
+
+    WaterfallRow row{6};
+    row.set_span(5, 6);
+    CHECK(values(row.render(bins.data(), bins.size(), lut)) == std::vector<uint16_t>{5, 6, 7, 0, 1, 2});
+}
+
+TEST_CASE("Wide spans keep the strongest bin of each pixel.") {
+    const auto lut = identity_lut();
+    std::vector<uint8_t> bins{1, 9, 2, 3, 7, 4, 5, 6, 0, 8, 1, 1};
+
+    WaterfallRow row{4};
+    row.set_span(0, bins.size());
+    CHECK(values(row.render(bins.data(), bins.size(), lut)) == std::vector<uint16_t>{9, 7, 6, 8});
+
+    // Uneven ratios still visit every bin once.
+    WaterfallRow uneven{5};
+    uneven.set_span(0, bins.size());
+    CHECK(values(uneven.render(bins.data(), bins.size(), lut)) == std::vector<uint16_t>{9, 3, 7, 6, 8});
+}
+
+TEST_CASE("Narrow spans repeat bins.") {
+    const auto lut = identity_lut();
+    std::vector<uint8_t> bins{10, 20, 30, 40};
+
+    WaterfallRow row{8};
+    row.set_span(1, 3);
+    CHECK(values(row.render(bins.data(), bins.size(), lut)) == std::vector<uint16_t>{20, 20, 20, 30, 30, 30, 40, 40});
+}
+
+TEST_CASE("Rows that aren't a multiple of four are fully mapped.") {
+    WaterfallRow::LUT lut{};
+    lut[3] = ui::Color{0x1234};
+    std::vector<uint8_t> bins(7, 3);
+
+    WaterfallRow row{7};
+    for (const auto& c : row.render(bins.data(), bins.size(), lut))
+        CHECK_EQ(c.v, 0x1234);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "dsp_fir_design.hpp"
+
+#include <cmath>
+#include <complex>
+
+namespace {
+
+template <typename T, size_t N>
+double response_db(const std::array<T, N>& taps, const double f_normalized, const double tap_sum) {
+    std::complex<double> acc = 0;
+    for (size_t n = 0; n < N; n++) {
+        const std::complex<double> tap{static_cast<double>(std::real(taps[n])), static_cast<double>(std::imag(taps[n]))};
+        acc += tap * std::polar(1.0, -2 * M_PI * f_normalized * n);
+    }
+    return 20 * std::log10(std::abs(acc) / tap_sum);
+}
+
+}  // namespace
+
+/* Designed by the compiler, not at run time. */
+constexpr auto taps_decim = fir_design::decimator_real<32>(3072000, 8000, 8);
+constexpr auto taps_usb = fir_design::bandpass_complex<64>(12000, 0, 3000, 300);
+
+TEST_CASE("decimator_real is symmetric with the requested tap sum.") {
+    int32_t sum = 0;
+    for (size_t n = 0; n < taps_decim.taps.size(); n++) {
+        CHECK(taps_decim.taps[n] == taps_decim.taps[taps_decim.taps.size() - 1 - n]);
+        sum += taps_decim.taps[n];
+    }
+    CHECK(std::abs(sum - 32768) <= 16);
+    CHECK(taps_decim.high_frequency_normalized == doctest::Approx(8000.0 / 3072000.0));
+}
+
+TEST_CASE("decimator_real rejects what would alias onto the pass band.") {
+    CHECK(response_db(taps_decim.taps, 0.0, 32768) == doctest::Approx(0.0).epsilon(0.01));
+    CHECK(response_db(taps_decim.taps, 8000.0 / 3072000.0, 32768) > -0.1);
+    CHECK(response_db(taps_decim.taps, 450000.0 / 3072000.0, 32768) < -50.0);
+}
+
+TEST_CASE("bandpass_complex passes only the requested side band.") {
+    CHECK(response_db(taps_usb.taps, 1500.0 / 12000.0, 65536) > -0.5);
+    CHECK(response_db(taps_usb.taps, -1500.0 / 12000.0, 65536) < -50.0);
+    CHECK(response_db(taps_usb.taps, 4000.0 / 12000.0, 65536) < -50.0);
+}
+
+TEST_CASE("kaiser_taps_estimate grows with attenuation.") {
+    CHECK(fir_design::kaiser_taps_estimate(0.1f, 60.0f) == 37);
+    CHECK(fir_design::kaiser_taps_estimate(0.1f, 40.0f) < 37);
+}
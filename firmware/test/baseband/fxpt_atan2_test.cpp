@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "fxpt_atan2.hpp"
+
+#include <cmath>
+
+namespace {
+
+template <bool Precise>
+double max_error_degrees() {
+    double max_error = 0.0;
+    for (int i = 0; i < 3600; i++) {
+        const double a = (i - 1800) * M_PI / 1800.0;
+        const int32_t x = std::lround(std::cos(a) * 1000000.0);
+        const int32_t y = std::lround(std::sin(a) * 1000000.0);
+        const double result = fxpt_atan2_s32<Precise>(y, x) * 180.0 / 32768.0;
+        double error = std::fabs(result - std::atan2(y, x) * 180.0 / M_PI);
+        if (error > 180.0) error = 360.0 - error;
+        if (error > max_error) max_error = error;
+    }
+    return max_error;
+}
+
+}  // namespace
+
+TEST_CASE("fxpt_atan2_s32 handles axes and the origin.") {
+    CHECK(fxpt_atan2_s32<true>(0, 0) == 0);
+    CHECK(fxpt_atan2_s32<true>(0, 1000) == 0);
+    CHECK(fxpt_atan2_s32<true>(1000, 0) == 16384);
+    CHECK(fxpt_atan2_s32<true>(-1000, 0) == -16384);
+    CHECK(fxpt_atan2_s32<true>(0, -1000) == 32768);
+    CHECK(fxpt_atan2_s32<true>(1000, 1000) == 8192);
+}
+
+TEST_CASE("fxpt_atan2_s32 is within its error bounds.") {
+    CHECK(max_error_degrees<true>() < 0.11);
+    CHECK(max_error_degrees<false>() < 0.25);
+}
+
+TEST_CASE("fxpt_atan2_s32 handles full scale inputs.") {
+    CHECK(fxpt_atan2_s32<true>(INT32_MIN, INT32_MIN) == -24576);
+    CHECK(fxpt_atan2_s32<true>(INT32_MAX, 1) == 16384);
+}
@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "bench.hpp"
+
+#include "portapack.hpp"
+
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <utility>
+
+using namespace ui;
+
+namespace ui_bench {
+
+Bench::Bench() {
+    portapack::display.init();
+    root.set_parent_rect({0, 0, screen_width, screen_height});
+}
+
+void Bench::set_view(std::unique_ptr<BenchView> new_view) {
+    // Same order as NavigationView: drop focus before the old view goes.
+    context.focus_manager().set_focus_widget(nullptr);
+    if (view)
+        root.remove_child(view.get());
+
+    view = std::move(new_view);
+    if (!view)
+        return;
+
+    root.add_child(view.get());
+    view->set_parent_rect(root.screen_rect());
+    view->focus();
+    root.set_dirty();
+}
+
+BusStats Bench::frame() {
+    if (view)
+        view->on_frame(frames);
+    painter.paint_widget_tree(&root);
+
+    // Includes whatever event handlers drew directly since the last frame.
+    const auto stats = take_bus_stats();
+    totals += stats;
+    frames++;
+    return stats;
+}
+
+void Bench::key(const KeyEvent event) {
+    auto target = context.focus_manager().focus_widget();
+    while ((target != nullptr) && !target->on_key(event))
+        target = target->parent();
+
+    if (target == nullptr)
+        context.focus_manager().update(&root, event);
+}
+
+void Bench::encoder(const EncoderEvent delta) {
+    auto target = context.focus_manager().focus_widget();
+    while ((target != nullptr) && !target->on_encoder(delta))
+        target = target->parent();
+}
+
+void Bench::touch(const Point p) {
+    const auto captured = touch_widget(&root, {p, TouchEvent::Type::Start});
+    if (captured)
+        captured->on_touch({p, TouchEvent::Type::End});
+}
+
+Widget* Bench::touch_widget(Widget* const w, const TouchEvent event) {
+    if (w->hidden())
+        return nullptr;
+
+    // Last drawn is on top, so children come first.
+    for (const auto child : w->children()) {
+        const auto touched = touch_widget(child, event);
+        if (touched)
+            return touched;
+    }
+
+    if (w->screen_rect().contains(event.point) && w->on_touch(event))
+        return w;
+
+    return nullptr;
+}
+
+void print_stats(std::ostream& out, const BusStats& stats) {
+    out << stats.pixels << " pixels, "
+        << stats.windows << " windows, "
+        << stats.transactions << " transactions";
+}
+
+namespace {
+
+bool parse_key(const std::string& name, KeyEvent& event) {
+    static const std::pair<const char*, KeyEvent> keys[] = {
+        {"right", KeyEvent::Right},
+        {"left", KeyEvent::Left},
+        {"down", KeyEvent::Down},
+        {"up", KeyEvent::Up},
+        {"select", KeyEvent::Select},
+        {"back", KeyEvent::Back},
+    };
+    for (const auto& key : keys) {
+        if (name == key.first) {
+            event = key.second;
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace
+
+bool run_script(Bench& bench, std::istream& in, std::ostream& out) {
+    std::string line;
+    size_t line_number = 0;
+
+    while (std::getline(in, line)) {
+        line_number++;
+
+        std::istringstream words{line};
+        std::string command;
+        if (!(words >> command) || command[0] == '#')
+            continue;
+
+        bool ok = true;
+        if (command == "view") {
+            std::string name;
+            auto view = (words >> name) ? make_view(name) : nullptr;
+            ok = (view != nullptr);
+            if (ok)
+                bench.set_view(std::move(view));
+        } else if (command == "frame") {
+            uint32_t count = 1;
+            words >> count;
+            for (uint32_t i = 0; i < count; i++) {
+                const auto number = bench.frame_count();
+                out << "frame " << number << ": ";
+                print_stats(out, bench.frame());
+                out << "\n";
+            }
+        } else if (command == "key") {
+            std::string name;
+            KeyEvent event;
+            ok = (words >> name) && parse_key(name, event);
+            if (ok)
+                bench.key(event);
+        } else if (command == "encoder") {
+            EncoderEvent delta;
+            ok = static_cast<bool>(words >> delta);
+            if (ok)
+                bench.encoder(delta);
+        } else if (command == "touch") {
+            int x, y;
+            ok = static_cast<bool>(words >> x >> y);
+            if (ok)
+                bench.touch({x, y});
+        } else if (command == "png") {
+            std::string path;
+            ok = (words >> path) && save_png(path);
+        } else if (command == "expect") {
+            int x, y;
+            uint32_t rgb;
+            ok = static_cast<bool>(words >> x >> y >> std::hex >> rgb);
+            if (ok) {
+                const Color expected{uint8_t(rgb >> 16), uint8_t(rgb >> 8), uint8_t(rgb)};
+                ok = (screen_pixel(x, y).v == expected.v);
+            }
+        } else {
+            ok = false;
+        }
+
+        if (!ok) {
+            out << "line " << line_number << ": can't run '" << line << "'\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+} /* namespace ui_bench */
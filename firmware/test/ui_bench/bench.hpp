@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __BENCH_H__
+#define __BENCH_H__
+
+#include "lcd_framebuffer.hpp"
+#include "sample_views.hpp"
+
+#include "theme.hpp"
+#include "ui_painter.hpp"
+#include "ui_widget.hpp"
+
+#include <iosfwd>
+#include <memory>
+
+namespace ui_bench {
+
+/* A screen with one view on it, driven like the event dispatcher drives the
+ * real one: keys bubble up from the focused widget and move focus when
+ * nobody takes them, touches go to the topmost widget under the point. */
+class Bench {
+   public:
+    Bench();
+
+    void set_view(std::unique_ptr<BenchView> new_view);
+
+    /* Runs the view's per-frame update, then paints the dirty widgets. */
+    BusStats frame();
+
+    void key(const ui::KeyEvent event);
+    void encoder(const ui::EncoderEvent delta);
+    void touch(const ui::Point p);
+
+    uint32_t frame_count() const { return frames; }
+    const BusStats& total() const { return totals; }
+
+   private:
+    class Root : public ui::View {
+       public:
+        Root(ui::Context& context)
+            : context_{context} {
+            // Same base style as SystemView, widgets inherit it.
+            set_style(Theme::getInstance()->bg_darkest);
+        }
+
+        ui::Context& context() const override {
+            return context_;
+        }
+
+       private:
+        ui::Context& context_;
+    };
+
+    ui::Context context{};
+    Root root{context};
+    ui::Painter painter{};
+    std::unique_ptr<BenchView> view{};
+
+    uint32_t frames{0};
+    BusStats totals{};
+
+    ui::Widget* touch_widget(ui::Widget* const w, const ui::TouchEvent event);
+};
+
+/* Runs commands from in, one per line, reporting to out:
+ *   view <name>         show one of the sample views
+ *   frame [count]       paint one or more frames, printing bus counters
+ *   key <right|left|up|down|select|back>
+ *   encoder <delta>
+ *   touch <x> <y>
+ *   png <path>          save the screen
+ *   expect <x> <y> <rrggbb>  fail unless the screen shows that colour there
+ * Blank lines and lines starting with '#' are skipped.
+ * Returns false at the first line that can't be run. */
+bool run_script(Bench& bench, std::istream& in, std::ostream& out);
+
+void print_stats(std::ostream& out, const BusStats& stats);
+
+} /* namespace ui_bench */
+
+#endif /*__BENCH_H__*/
@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Stand-ins for the firmware services the widget toolkit links against.
+ * Only drawing and input are modelled; clocks read as zero, no key is
+ * ever long-pressed and there is no filesystem. */
+
+#include "ch.h"
+#include "file.hpp"
+#include "irq_controls.hpp"
+#include "rtc_time.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+
+extern "C" void chDbgPanic(const char* msg) {
+    std::fprintf(stderr, "panic: %s\n", msg);
+    std::abort();
+}
+
+namespace rtc_time {
+
+Signal<> signal_tick_second;
+
+rtc::RTC now(rtc::RTC& out_datetime) {
+    out_datetime = {};
+    return out_datetime;
+}
+
+} /* namespace rtc_time */
+
+void set_switches_long_press_config(SwitchesState) {}
+
+bool switch_is_long_pressed(Switch) {
+    return false;
+}
+
+File::Result<File::Size> File::read(void*, const Size) {
+    return {static_cast<Error>(FR_NOT_READY)};
+}
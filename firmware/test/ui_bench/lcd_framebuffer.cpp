@@ -0,0 +1,443 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "lcd_framebuffer.hpp"
+
+#include "lcd_ili9341.hpp"
+#include "portapack.hpp"
+
+#include "crc.hpp"
+#include "deflate.hpp"
+
+#include <array>
+#include <cstdlib>
+#include <fstream>
+#include <vector>
+
+namespace portapack {
+
+lcd::ILI9341 display;
+
+} /* namespace portapack */
+
+namespace ui_bench {
+
+BusStats& BusStats::operator+=(const BusStats& other) {
+    transactions += other.transactions;
+    windows += other.windows;
+    pixels += other.pixels;
+    return *this;
+}
+
+namespace {
+
+/* What the ILI9341 holds: graphics RAM, the current address window with its
+ * write pointer, and the vertical scroll registers. */
+struct Controller {
+    int width{0};
+    int height{0};
+    std::vector<uint16_t> gram{};
+
+    int x_start{0};
+    int x_end{0};
+    int y_start{0};
+    int y_end{0};
+    int x{0};
+    int y{0};
+
+    int scroll_top{0};
+    int scroll_height{0};
+    int scroll_start{0};
+
+    BusStats stats{};
+
+    void command() {
+        stats.transactions++;
+    }
+
+    void start_ram_write(const ui::Point p, const ui::Size s) {
+        command();  // CASET
+        command();  // PASET
+        command();  // RAMWR
+        stats.windows++;
+        x_start = p.x();
+        x_end = p.x() + s.width() - 1;
+        y_start = p.y();
+        y_end = p.y() + s.height() - 1;
+        x = x_start;
+        y = y_start;
+    }
+
+    void write(const ui::Color c, size_t count) {
+        stats.pixels += count;
+        while (count--) {
+            if (x >= 0 && x < width && y >= 0 && y < height)
+                gram[y * width + x] = c.v;
+            if (++x > x_end) {
+                x = x_start;
+                if (++y > y_end)
+                    y = y_start;
+            }
+        }
+    }
+
+    void write(const ui::Color* colors, const size_t count) {
+        for (size_t i = 0; i < count; i++)
+            write(colors[i], 1);
+    }
+
+    uint16_t read(const int gx, const int gy) const {
+        if (gx < 0 || gx >= width || gy < 0 || gy >= height)
+            return 0;
+        return gram[gy * width + gx];
+    }
+};
+
+Controller controller;
+
+ui::ColorRGB888 to_rgb888(const uint16_t v) {
+    const uint8_t r = (v >> 11) & 0x1f;
+    const uint8_t g = (v >> 5) & 0x3f;
+    const uint8_t b = v & 0x1f;
+    return {
+        static_cast<uint8_t>((r << 3) | (r >> 2)),
+        static_cast<uint8_t>((g << 2) | (g >> 4)),
+        static_cast<uint8_t>((b << 3) | (b >> 2)),
+    };
+}
+
+void put_uint32_be(std::ostream& out, const uint32_t value) {
+    const std::array<char, 4> bytes{{
+        static_cast<char>(value >> 24),
+        static_cast<char>(value >> 16),
+        static_cast<char>(value >> 8),
+        static_cast<char>(value),
+    }};
+    out.write(bytes.data(), bytes.size());
+}
+
+void put_chunk(std::ostream& out, const char* type, const uint8_t* data, const size_t length) {
+    CRC<32, true, true> crc{0x04c11db7, 0xffffffff, 0xffffffff};
+    put_uint32_be(out, length);
+    out.write(type, 4);
+    crc.process_bytes(type, 4);
+    out.write(reinterpret_cast<const char*>(data), length);
+    crc.process_bytes(data, length);
+    put_uint32_be(out, crc.checksum());
+}
+
+} /* namespace */
+
+void framebuffer_init() {
+    controller = Controller{};
+    controller.width = ui::screen_width;
+    controller.height = ui::screen_height;
+    controller.gram.assign(controller.width * controller.height, 0);
+    controller.scroll_height = controller.height;
+}
+
+BusStats take_bus_stats() {
+    const auto stats = controller.stats;
+    controller.stats = {};
+    return stats;
+}
+
+ui::Color screen_pixel(const int x, const int y) {
+    const auto& c = controller;
+    int gy = y;
+    if (c.scroll_height > 0 && y >= c.scroll_top && y < c.scroll_top + c.scroll_height)
+        gy = c.scroll_top + ((c.scroll_start - c.scroll_top) + (y - c.scroll_top)) % c.scroll_height;
+    return ui::Color{c.read(x, gy)};
+}
+
+bool save_png(const std::string& path) {
+    std::ofstream out{path, std::ios::binary};
+    if (!out)
+        return false;
+
+    const int width = controller.width;
+    const int height = controller.height;
+
+    out.write("\x89PNG\r\n\x1a\n", 8);
+    const std::array<uint8_t, 13> ihdr{{
+        static_cast<uint8_t>(width >> 24),
+        static_cast<uint8_t>(width >> 16),
+        static_cast<uint8_t>(width >> 8),
+        static_cast<uint8_t>(width),
+        static_cast<uint8_t>(height >> 24),
+        static_cast<uint8_t>(height >> 16),
+        static_cast<uint8_t>(height >> 8),
+        static_cast<uint8_t>(height),
+        8,  // bit depth
+        2,  // RGB
+        0,
+        0,
+        0,
+    }};
+    put_chunk(out, "IHDR", ihdr.data(), ihdr.size());
+
+    deflate::Encoder encoder{[&out](const uint8_t* data, size_t length) {
+        put_chunk(out, "IDAT", data, length);
+    }};
+    std::vector<uint8_t> row(1 + width * sizeof(ui::ColorRGB888));
+    for (int y = 0; y < height; y++) {
+        row[0] = 0;  // filter None
+        for (int x = 0; x < width; x++) {
+            const auto rgb = to_rgb888(screen_pixel(x, y).v);
+            row[1 + x * 3 + 0] = rgb.r;
+            row[1 + x * 3 + 1] = rgb.g;
+            row[1 + x * 3 + 2] = rgb.b;
+        }
+        encoder.write(row.data(), row.size());
+    }
+    encoder.finish();
+
+    put_chunk(out, "IEND", nullptr, 0);
+    return static_cast<bool>(out);
+}
+
+} /* namespace ui_bench */
+
+/* The driver calls used by the widget toolkit, with the same bus steps as
+ * lcd_ili9341.cpp. */
+namespace lcd {
+
+using ui_bench::controller;
+
+void ILI9341::init() {
+    ui_bench::framebuffer_init();
+}
+
+void ILI9341::shutdown() {
+    controller.command();
+}
+
+void ILI9341::sleep(bool) {
+    controller.command();
+}
+
+void ILI9341::wake(bool) {
+    controller.command();
+}
+
+void ILI9341::fill_rectangle(ui::Rect r, const ui::Color c) {
+    const auto r_clipped = r.intersect(screen_rect());
+    if (!r_clipped.is_empty()) {
+        controller.start_ram_write(r_clipped.location(), r_clipped.size());
+        controller.write(c, r_clipped.width() * r_clipped.height());
+    }
+}
+
+void ILI9341::fill_rectangle_unrolled8(ui::Rect r, const ui::Color c) {
+    fill_rectangle(r, c);
+}
+
+void ILI9341::render_line(const ui::Point p, const uint16_t count, const ui::Color* line_buffer) {
+    controller.start_ram_write(p, {count, 1});
+    controller.write(line_buffer, count);
+}
+
+void ILI9341::render_box(const ui::Point p, const ui::Size s, const ui::Color* line_buffer) {
+    controller.start_ram_write(p, s);
+    controller.write(line_buffer, s.width() * s.height());
+}
+
+void ILI9341::draw_line(const ui::Point start, const ui::Point end, const ui::Color color) {
+    int x0 = start.x();
+    int y0 = start.y();
+    int x1 = end.x();
+    int y1 = end.y();
+
+    int dx = std::abs(x1 - x0), sx = x0 < x1 ? 1 : -1;
+    int dy = std::abs(y1 - y0), sy = y0 < y1 ? 1 : -1;
+    int err = (dx > dy ? dx : -dy) / 2, e2;
+
+    for (;;) {
+        draw_pixel({static_cast<ui::Coord>(x0), static_cast<ui::Coord>(y0)}, color);
+        if (x0 == x1 && y0 == y1) break;
+        e2 = err;
+        if (e2 > -dx) {
+            err -= dy;
+            x0 += sx;
+        }
+        if (e2 < dy) {
+            err += dx;
+            y0 += sy;
+        }
+    }
+}
+
+void ILI9341::fill_circle(
+    const ui::Point center,
+    const ui::Dim radius,
+    const ui::Color foreground,
+    const ui::Color background) {
+    const uint32_t radius2 = radius * radius;
+    for (int32_t y = -radius; y < radius; y++) {
+        const int32_t y2 = y * y;
+        for (int32_t x = -radius; x < radius; x++) {
+            const int32_t x2 = x * x;
+            const uint32_t d2 = x2 + y2;
+            const bool inside = d2 < radius2;
+            draw_pixel({x + center.x(), y + center.y()}, inside ? foreground : background);
+        }
+    }
+}
+
+void ILI9341::draw_pixel(const ui::Point p, const ui::Color color) {
+    if (screen_rect().contains(p)) {
+        controller.start_ram_write(p, {1, 1});
+        controller.write(color, 1);
+    }
+}
+
+void ILI9341::draw_pixels(const ui::Rect r, const ui::Color* const colors, const size_t count) {
+    controller.start_ram_write(r.location(), r.size());
+    controller.write(colors, count);
+}
+
+void ILI9341::read_pixels(const ui::Rect r, ui::ColorRGB888* const colors, const size_t count) {
+    controller.command();  // CASET
+    controller.command();  // PASET
+    controller.command();  // RAMRD
+    for (size_t i = 0; i < count; i++) {
+        const int x = r.left() + i % r.width();
+        const int y = r.top() + i / r.width();
+        colors[i] = ui_bench::to_rgb888(controller.read(x, y));
+    }
+}
+
+void ILI9341::draw_bitmap(
+    const ui::Point p,
+    const ui::Size size,
+    const uint8_t* const pixels,
+    const ui::Color foreground,
+    const ui::Color background,
+    uint8_t zoom_level) {
+    if (zoom_level <= 1) {
+        if (ui::Color::magenta().v != background.v) {
+            controller.start_ram_write(p, size);
+
+            const size_t count = size.width() * size.height();
+            for (size_t i = 0; i < count; i++) {
+                const auto pixel = pixels[i >> 3] & (1U << (i & 0x7));
+                controller.write(pixel ? foreground : background, 1);
+            }
+        } else {
+            // Transparent background, one window per set pixel.
+            int x = p.x();
+            int y = p.y();
+            const int max_x = x + size.width();
+            const size_t count = size.width() * size.height();
+            for (size_t i = 0; i < count; i++) {
+                if (pixels[i >> 3] & (1U << (i & 0x7)))
+                    draw_pixel({x, y}, foreground);
+                if (++x >= max_x) {
+                    x = p.x();
+                    y++;
+                }
+            }
+        }
+    } else {
+        for (int y = 0; y < size.height(); y++) {
+            for (int x = 0; x < size.width(); x++) {
+                const size_t bit = y * size.width() + x;
+                const auto pixel = pixels[bit >> 3] & (1U << (bit & 0x7));
+                if (pixel || background.v != ui::Color::magenta().v) {
+                    fill_rectangle(
+                        {p.x() + x * zoom_level, p.y() + y * zoom_level, zoom_level, zoom_level},
+                        pixel ? foreground : background);
+                }
+            }
+        }
+    }
+}
+
+void ILI9341::draw_glyph(
+    const ui::Point p,
+    const ui::Glyph& glyph,
+    const ui::Color foreground,
+    const ui::Color background,
+    uint8_t zoom_level) {
+    draw_bitmap(p, glyph.size(), glyph.pixels(), foreground, background, zoom_level);
+}
+
+void ILI9341::draw_glyph_run(
+    const ui::Point p,
+    const RunGlyph* glyphs,
+    const size_t count,
+    const int height,
+    const ui::Color background) {
+    int width = 0;
+    for (size_t i = 0; i < count; i++)
+        width += glyphs[i].width;
+
+    if (width == 0 || height == 0)
+        return;
+
+    controller.start_ram_write(p, {width, height});
+    for (int y = 0; y < height; y++) {
+        for (size_t i = 0; i < count; i++) {
+            const auto& glyph = glyphs[i];
+            size_t bit = y * glyph.width;
+            for (size_t x = 0; x < glyph.width; x++, bit++) {
+                const bool set = glyph.pixels[bit >> 3] & (1U << (bit & 7));
+                controller.write(set ? glyph.foreground : background, 1);
+            }
+        }
+    }
+}
+
+void ILI9341::scroll_set_area(const ui::Coord top_y, const ui::Coord bottom_y) {
+    scroll_state.top_area = top_y;
+    scroll_state.bottom_area = height() - bottom_y;
+    scroll_state.height = bottom_y - top_y;
+    controller.command();  // VSCRDEF
+    controller.scroll_top = scroll_state.top_area;
+    controller.scroll_height = scroll_state.height;
+}
+
+ui::Coord ILI9341::scroll_set_position(const ui::Coord position) {
+    scroll_state.current_position = position % scroll_state.height;
+    const uint_fast16_t address = scroll_state.top_area + scroll_state.current_position;
+    controller.command();  // VSCRSADD
+    controller.scroll_start = address;
+    return address;
+}
+
+ui::Coord ILI9341::scroll(const int32_t delta) {
+    return scroll_set_position(scroll_state.current_position + scroll_state.height - delta);
+}
+
+ui::Coord ILI9341::scroll_area_y(const ui::Coord y) const {
+    const auto wrapped_y = (scroll_state.current_position + y) % scroll_state.height;
+    return wrapped_y + scroll_state.top_area;
+}
+
+void ILI9341::scroll_disable() {
+    controller.command();  // VSCRDEF
+    controller.command();  // VSCRSADD
+    controller.scroll_top = 0;
+    controller.scroll_height = height();
+    controller.scroll_start = 0;
+}
+
+} /* namespace lcd */
@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __LCD_FRAMEBUFFER_H__
+#define __LCD_FRAMEBUFFER_H__
+
+#include "ui.hpp"
+
+#include <cstdint>
+#include <string>
+
+/* Host stand-in for the ILI9341 driver. The panel is modelled as its
+ * controller sees it: a graphics RAM written through address windows, and a
+ * vertical scroll offset applied when the picture is read out. Drawing calls
+ * take the same window and pixel stream steps as lcd_ili9341.cpp, so the
+ * counters below track what the real bus would carry.
+ */
+namespace ui_bench {
+
+struct BusStats {
+    /* Commands sent, each with its parameters or pixel data. */
+    uint32_t transactions{0};
+    /* Address windows opened for pixel writes (CASET, PASET, RAMWR). */
+    uint32_t windows{0};
+    /* Pixels written to graphics RAM. */
+    uint32_t pixels{0};
+
+    BusStats& operator+=(const BusStats& other);
+};
+
+/* Sizes graphics RAM to ui::screen_width x ui::screen_height, filled black. */
+void framebuffer_init();
+
+/* Returns the counters accumulated since the last call and clears them. */
+BusStats take_bus_stats();
+
+/* The pixel as the panel shows it, with scrolling applied. */
+ui::Color screen_pixel(const int x, const int y);
+
+bool save_png(const std::string& path);
+
+} /* namespace ui_bench */
+
+#endif /*__LCD_FRAMEBUFFER_H__*/
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Renders the widget toolkit on the host, counting LCD bus traffic.
+ *
+ *   ui_bench [--view <name>] [--frames <count>] [--png <path>]
+ *   ui_bench --script <path>
+ *
+ * Without a script the view is painted for the given number of frames
+ * (default 1) and the last frame is optionally saved as a PNG.
+ */
+
+#include "bench.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace ui_bench;
+
+static int usage() {
+    std::cerr << "usage: ui_bench [--view <name>] [--frames <count>] [--png <path>]\n"
+              << "       ui_bench --script <path>\n"
+              << "views:";
+    for (const auto& name : view_names())
+        std::cerr << " " << name;
+    std::cerr << "\n";
+    return 2;
+}
+
+int main(int argc, char** argv) {
+    std::string view_name = "widgets";
+    std::string script;
+    std::string png;
+    uint32_t frames = 1;
+
+    for (int i = 1; i < argc; i++) {
+        const bool has_value = (i + 1 < argc);
+        if (!std::strcmp(argv[i], "--view") && has_value)
+            view_name = argv[++i];
+        else if (!std::strcmp(argv[i], "--script") && has_value)
+            script = argv[++i];
+        else if (!std::strcmp(argv[i], "--png") && has_value)
+            png = argv[++i];
+        else if (!std::strcmp(argv[i], "--frames") && has_value)
+            frames = std::strtoul(argv[++i], nullptr, 10);
+        else
+            return usage();
+    }
+
+    Bench bench;
+
+    if (!script.empty()) {
+        std::ifstream in{script};
+        if (!in) {
+            std::cerr << "can't open " << script << "\n";
+            return 1;
+        }
+        if (!run_script(bench, in, std::cout))
+            return 1;
+    } else {
+        auto view = make_view(view_name);
+        if (!view)
+            return usage();
+        bench.set_view(std::move(view));
+
+        for (uint32_t i = 0; i < frames; i++) {
+            std::cout << "frame " << i << ": ";
+            print_stats(std::cout, bench.frame());
+            std::cout << "\n";
+        }
+        if (!png.empty() && !save_png(png)) {
+            std::cerr << "can't write " << png << "\n";
+            return 1;
+        }
+    }
+
+    if (bench.frame_count()) {
+        const auto& total = bench.total();
+        std::cout << "total over " << bench.frame_count() << " frames: ";
+        print_stats(std::cout, total);
+        std::cout << "\n";
+    }
+    return 0;
+}
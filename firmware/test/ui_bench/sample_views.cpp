@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "sample_views.hpp"
+
+#include "theme.hpp"
+
+#include <functional>
+#include <utility>
+
+using namespace ui;
+
+namespace ui_bench {
+
+namespace {
+
+/* The common form widgets, with a progress bar and frequency that change
+ * every frame. */
+class WidgetsView : public BenchView {
+   public:
+    WidgetsView() {
+        add_children({
+            &labels,
+            &big_frequency,
+            &field_number,
+            &options_mode,
+            &check_enabled,
+            &progress,
+            &text_status,
+            &button_start,
+            &button_stop,
+        });
+
+        button_start.on_select = [this](Button&) {
+            text_status.set("Started");
+        };
+        button_stop.on_select = [this](Button&) {
+            text_status.set("Stopped");
+        };
+    }
+
+    void focus() override {
+        button_start.focus();
+    }
+
+    void on_frame(const uint32_t frame) override {
+        progress.set_value(frame % 100);
+        big_frequency.set(433'920'000 + (frame % 16) * 12'500);
+    }
+
+   private:
+    Labels labels{
+        {{0 * 8, 4 * 16}, "Gain:", Theme::getInstance()->fg_light->foreground},
+        {{0 * 8, 5 * 16}, "Mode:", Theme::getInstance()->fg_light->foreground},
+    };
+
+    BigFrequency big_frequency{
+        {0, 0, 240, 52},
+        433'920'000};
+
+    NumberField field_number{
+        {6 * 8, 4 * 16},
+        2,
+        {0, 40},
+        8,
+        ' '};
+
+    OptionsField options_mode{
+        {6 * 8, 5 * 16},
+        4,
+        {{"AM", 0}, {"NFM", 1}, {"WFM", 2}}};
+
+    Checkbox check_enabled{
+        {0 * 8, 6 * 16},
+        8,
+        "Enabled"};
+
+    ProgressBar progress{
+        {0, 9 * 16, 240, 16}};
+
+    Text text_status{
+        {0, 10 * 16, 240, 16},
+        "Idle"};
+
+    Button button_start{
+        {0, 12 * 16, 112, 32},
+        "Start"};
+
+    Button button_stop{
+        {128, 12 * 16, 112, 32},
+        "Stop"};
+};
+
+/* A scrolling console, one line per frame. */
+class ConsoleView : public BenchView {
+   public:
+    ConsoleView() {
+        add_children({&console});
+    }
+
+    void focus() override {
+        console.focus();
+    }
+
+    void on_frame(const uint32_t frame) override {
+        console.writeln("Frame " + std::to_string(frame) + ": " + std::string(frame % 20, '#'));
+    }
+
+   private:
+    Console console{
+        {0, 0, 240, 304}};
+};
+
+/* A container drawing a title that runs under its children. Hiding the
+ * popup from frame 1 on damages part of the title only. */
+class DamageView : public BenchView {
+   public:
+    DamageView() {
+        add_children({&panel});
+    }
+
+    void on_frame(const uint32_t frame) override {
+        panel.popup.hidden(frame >= 1);
+    }
+
+   private:
+    class Panel : public View {
+       public:
+        Panel(Rect parent_rect)
+            : View{parent_rect} {
+            add_children({&badge, &popup});
+        }
+
+        void paint(Painter& painter) override {
+            const auto r = screen_rect();
+            painter.fill_rectangle(r, Color::dark_blue());
+            painter.draw_string(r.location(), *Theme::getInstance()->bg_darkest, "Title running under the badge");
+        }
+
+        Rectangle badge{{160, 0, 80, 16}, Color::green()};
+        Rectangle popup{{0, 0, 40, 16}, Color::red()};
+    };
+
+    Panel panel{{0, 0, 240, 32}};
+};
+
+const std::vector<std::pair<std::string, std::function<std::unique_ptr<BenchView>()>>> views{
+    {"widgets", [] { return std::make_unique<WidgetsView>(); }},
+    {"console", [] { return std::make_unique<ConsoleView>(); }},
+    {"damage", [] { return std::make_unique<DamageView>(); }},
+};
+
+}  // namespace
+
+std::unique_ptr<BenchView> make_view(const std::string& name) {
+    for (const auto& view : views) {
+        if (view.first == name)
+            return view.second();
+    }
+    return nullptr;
+}
+
+std::vector<std::string> view_names() {
+    std::vector<std::string> names;
+    for (const auto& view : views)
+        names.push_back(view.first);
+    return names;
+}
+
+} /* namespace ui_bench */
@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) 2026 PortaPack Mayhem
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __SAMPLE_VIEWS_H__
+#define __SAMPLE_VIEWS_H__
+
+#include "ui_widget.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ui_bench {
+
+/* A view the bench can render. on_frame() runs before each frame is
+ * painted, so animated views cost the same redraws every run. */
+class BenchView : public ui::View {
+   public:
+    virtual void on_frame(const uint32_t frame) { (void)frame; }
+};
+
+/* nullptr for an unknown name. */
+std::unique_ptr<BenchView> make_view(const std::string& name);
+std::vector<std::string> view_names();
+
+} /* namespace ui_bench */
+
+#endif /*__SAMPLE_VIEWS_H__*/
@@ -0,0 +1,123 @@
+#!/usr/bin/env python3
+
+#
+# Copyright (C) 2026 PortaPack Mayhem
+#
+# This file is part of PortaPack.
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2, or (at your option)
+# any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+# Decodes a lossless compressed .CIQ capture to a raw .C16 file.
+# See firmware/application/iq_codec.hpp for the stream format.
+
+import sys
+import struct
+
+usage_message = """
+PortaPack CIQ to C16 converter
+
+Usage: <command> <input.CIQ> <output.C16>
+"""
+
+VERBATIM_RICE_PARAMETER = 31
+ESCAPE_QUOTIENT = 24
+ESCAPE_BITS = 20
+
+
+class BitReader:
+	def __init__(self, data):
+		self.value = int.from_bytes(data, 'big')
+		self.remaining = len(data) * 8
+
+	def read(self, bits):
+		if bits > self.remaining:
+			raise ValueError('block payload overrun')
+		self.remaining -= bits
+		return (self.value >> self.remaining) & ((1 << bits) - 1)
+
+	def read_unary(self, limit):
+		count = 0
+		while count < limit and self.read(1):
+			count += 1
+		return count
+
+
+def to_int16(v):
+	v &= 0xffff
+	return v - 0x10000 if v & 0x8000 else v
+
+
+def decode_channel(bits, count):
+	order = bits.read(2)
+	k = bits.read(5)
+	out = []
+	x1 = x2 = 0
+	for i in range(count):
+		if k == VERBATIM_RICE_PARAMETER or i < order:
+			x = to_int16(bits.read(16))
+		else:
+			q = bits.read_unary(ESCAPE_QUOTIENT)
+			u = ((q << k) | bits.read(k)) if q < ESCAPE_QUOTIENT else bits.read(ESCAPE_BITS)
+			r = (u >> 1) ^ -(u & 1)
+			if order == 0:
+				x = r
+			elif order == 1:
+				x = r + x1
+			else:
+				x = r + 2 * x1 - x2
+			x = to_int16(x)
+		x2, x1 = x1, x
+		out.append(x)
+	return out
+
+
+def convert(input_path, output_path):
+	with open(input_path, 'rb') as f:
+		header = f.read(16)
+		magic, version, block_samples, sample_count = struct.unpack('<4sHHQ', header)
+		if magic != b'CIQ1' or version != 1:
+			raise ValueError('not a CIQ capture')
+
+		written = 0
+		with open(output_path, 'wb') as out:
+			while True:
+				block_header = f.read(4)
+				if len(block_header) < 4:
+					break
+				payload_bytes, count = struct.unpack('<HH', block_header)
+				payload = f.read(payload_bytes)
+				if len(payload) < payload_bytes:
+					break  # Capture cut short.
+
+				bits = BitReader(payload)
+				i = decode_channel(bits, count)
+				q = decode_channel(bits, count)
+				samples = [v for pair in zip(i, q) for v in pair]
+				out.write(struct.pack('<%dh' % len(samples), *samples))
+				written += count
+
+	if sample_count and written != sample_count:
+		print('Warning: header says %d samples, decoded %d' % (sample_count, written))
+	return written
+
+
+if len(sys.argv) != 3:
+	print(usage_message)
+	sys.exit(-1)
+
+samples = convert(sys.argv[1], sys.argv[2])
+print('Decoded %d samples' % samples)
@@ -0,0 +1,236 @@
+#!/usr/bin/env python3
+#
+# Copyright (C) 2026 PortaPack Mayhem
+#
+# This file is part of PortaPack.
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2, or (at your option)
+# any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+"""
+Shows the PortaPack screen live over the USB serial shell, using the
+"screenstream" command. Only changed tiles are sent, compressed, see
+firmware/application/screen_stream.hpp for the format.
+
+Click to touch, arrow keys and Enter are the buttons, the mouse wheel
+turns the encoder.
+
+usage: screen_stream_viewer.py [--port /dev/ttyACM0] [--scale 2]
+"""
+
+import argparse
+import queue
+import struct
+import sys
+import threading
+import tkinter as tk
+import zlib
+
+import serial
+import serial.tools.list_ports
+
+PORTAPACK_USB_VID = 0x1D50
+FRAMES_PER_REQUEST = 10
+PROMPT = b"ch> "
+
+# key -> shell "button" number
+BUTTONS = {
+    "Right": 1,
+    "Left": 2,
+    "Down": 3,
+    "Up": 4,
+    "Return": 5,
+}
+
+
+class Screen:
+    """Framebuffer the frames are decoded into, RGB888."""
+
+    def __init__(self):
+        self.width = 0
+        self.height = 0
+        self.pixels = bytearray()
+
+    def resize(self, width, height):
+        if (width, height) != (self.width, self.height):
+            self.width = width
+            self.height = height
+            self.pixels = bytearray(width * height * 3)
+
+    def ppm(self):
+        return b"P6 %d %d 255\n" % (self.width, self.height) + bytes(self.pixels)
+
+
+def read_frame(read, screen):
+    """Reads one frame with read(n) and applies it, returns the changed tile count."""
+    magic, width, height, tile_size = struct.unpack("<2sHHB", read(7))
+    if magic != b"SF":
+        raise ValueError("not a screen stream frame")
+    screen.resize(width, height)
+
+    data = bytearray()
+    inflate = zlib.decompressobj()
+    while True:
+        (length,) = struct.unpack("<H", read(2))
+        if length == 0:
+            break
+        data += inflate.decompress(read(length))
+    data += inflate.flush()
+
+    columns = (width + tile_size - 1) // tile_size
+    tiles = 0
+    at = 0
+    while at < len(data):
+        (index,) = struct.unpack_from("<H", data, at)
+        at += 2
+        x0 = (index % columns) * tile_size
+        y0 = (index // columns) * tile_size
+        w = min(tile_size, width - x0)
+        h = min(tile_size, height - y0)
+        for y in range(y0, y0 + h):
+            row = (y * width + x0) * 3
+            for v in struct.unpack_from("<%dH" % w, data, at):
+                screen.pixels[row] = (v >> 8) & 0xF8
+                screen.pixels[row + 1] = (v >> 3) & 0xFC
+                screen.pixels[row + 2] = (v << 3) & 0xF8
+                row += 3
+            at += w * 2
+        tiles += 1
+    return tiles
+
+
+class Connection:
+    def __init__(self, port):
+        self.serial = serial.Serial(port, timeout=2)
+        self.buffer = bytearray()
+
+    def read(self, n):
+        while len(self.buffer) < n:
+            chunk = self.serial.read(max(n - len(self.buffer), self.serial.in_waiting))
+            if not chunk:
+                raise TimeoutError("no answer from the device")
+            self.buffer += chunk
+        data = bytes(self.buffer[:n])
+        del self.buffer[:n]
+        return data
+
+    def read_until(self, marker):
+        while marker not in self.buffer:
+            chunk = self.serial.read(max(1, self.serial.in_waiting))
+            if not chunk:
+                raise TimeoutError("no answer from the device")
+            self.buffer += chunk
+        end = self.buffer.index(marker) + len(marker)
+        data = bytes(self.buffer[:end])
+        del self.buffer[:end]
+        return data
+
+    def command(self, line):
+        """Sends a command and skips its echo, the answer is left to read."""
+        self.serial.write(line.encode() + b"\r\n")
+        self.read_until(line.encode() + b"\r\n")
+
+    def simple_command(self, line):
+        self.command(line)
+        self.read_until(PROMPT)
+
+
+def find_port():
+    for port in serial.tools.list_ports.comports():
+        if port.vid == PORTAPACK_USB_VID:
+            return port.device
+    return None
+
+
+def stream(connection, screen, commands, on_frame, stop):
+    connection.serial.write(b"\r\n")
+    connection.read_until(PROMPT)
+
+    while not stop.is_set():
+        while not commands.empty():
+            connection.simple_command(commands.get())
+
+        connection.command("screenstream %d" % FRAMES_PER_REQUEST)
+        for _ in range(FRAMES_PER_REQUEST):
+            if read_frame(connection.read, screen):
+                on_frame()
+        connection.read_until(PROMPT)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Live PortaPack screen over USB serial.")
+    parser.add_argument("--port", help="serial port, found by USB id if not given")
+    parser.add_argument("--scale", type=int, default=2, help="zoom factor")
+    args = parser.parse_args()
+
+    port = args.port or find_port()
+    if not port:
+        sys.exit("no PortaPack found, pass --port")
+
+    connection = Connection(port)
+    screen = Screen()
+    commands = queue.Queue()
+    stop = threading.Event()
+
+    root = tk.Tk()
+    root.title("PortaPack " + port)
+    label = tk.Label(root, borderwidth=0)
+    label.pack()
+    image = {"dirty": False}
+
+    def on_frame():
+        image["dirty"] = True
+
+    def refresh():
+        if image["dirty"]:
+            image["dirty"] = False
+            photo = tk.PhotoImage(data=screen.ppm(), format="PPM").zoom(args.scale)
+            label.configure(image=photo)
+            label.image = photo
+        root.after(15, refresh)
+
+    def on_click(event):
+        commands.put("touch %d %d" % (event.x // args.scale, event.y // args.scale))
+
+    def on_key(event):
+        if event.keysym in BUTTONS:
+            commands.put("button %d" % BUTTONS[event.keysym])
+
+    def on_wheel(event):
+        up = event.num == 4 or event.delta > 0
+        commands.put("button %d" % (8 if up else 7))
+
+    label.bind("<Button-1>", on_click)
+    label.bind("<Button-4>", on_wheel)
+    label.bind("<Button-5>", on_wheel)
+    label.bind("<MouseWheel>", on_wheel)
+    root.bind("<Key>", on_key)
+
+    def run():
+        try:
+            stream(connection, screen, commands, on_frame, stop)
+        except (serial.SerialException, TimeoutError, ValueError) as e:
+            print(e, file=sys.stderr)
+            root.after(0, root.destroy)
+
+    threading.Thread(target=run, daemon=True).start()
+    refresh()
+    root.mainloop()
+    stop.set()
+
+
+if __name__ == "__main__":
+    main()